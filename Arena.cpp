@@ -0,0 +1,82 @@
+/*************************************************************************
+ * Program Filename: Arena.cpp
+ * Author: David Bacher-Hicks
+ * Date: 19 October 2026
+ * Description: A class definition file for an Arena class. Blocks are
+ *              allocated as they are needed and kept until the arena is
+ *              destroyed.
+ * Input:  none
+ * Output: none
+ ************************************************************************/
+
+#include "Arena.hpp"
+
+/*************************************************************************
+ * Function: Arena
+ * Description: constructor; no block is allocated until needed
+ * Parameters: block_bytes - the size of each block
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: none
+ ************************************************************************/
+Arena::Arena(size_t block_bytes)
+{
+  this->block_bytes = block_bytes;
+  this->current = 0;
+  this->used = 0;
+}
+
+
+/*************************************************************************
+ * Function: ~Arena
+ * Description: destructor; frees every block at once
+ * Parameters: none
+ * Pre-conditions: the destructors of the objects made in the arena have
+ *                 been run
+ * Post-conditions: the memory is freed
+ * Returns: none
+ ************************************************************************/
+Arena::~Arena()
+{
+  for (auto i = this->blocks.begin(); i != this->blocks.end(); i++) {
+    ::operator delete(i->data);
+  }
+}
+
+
+/*************************************************************************
+ * Function: allocate
+ * Description: hands out memory from the current block, moving on to the
+ *              next block, or a new one, when it does not fit
+ * Parameters: bytes - the size
+ *             align - the alignment, no more than a fundamental alignment
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: void * - the memory, valid until the arena is destroyed
+ ************************************************************************/
+void *Arena::allocate(size_t bytes, size_t align)
+{
+  void *memory = NULL;
+  size_t start;
+  block added;
+
+  while (memory == NULL) {
+    if (this->current == this->blocks.size()) {
+      added.size = (bytes > this->block_bytes) ? bytes : this->block_bytes;
+      added.data = static_cast<char *>(::operator new(added.size));
+      this->blocks.push_back(added);
+      this->used = 0;
+    }
+
+    start = (this->used + align - 1) & ~(align - 1);
+    if (start + bytes <= this->blocks[this->current].size) {
+      memory = this->blocks[this->current].data + start;
+      this->used = start + bytes;
+    } else {
+      this->current++;
+      this->used = 0;
+    }
+  }
+
+  return memory;
+}
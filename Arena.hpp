@@ -0,0 +1,51 @@
+/*************************************************************************
+ * Program Filename: Arena.hpp
+ * Author: David Bacher-Hicks
+ * Date: 19 October 2026
+ * Description: A class declaration file for an Arena class, a monotonic
+ *              allocator. Memory is handed out from large blocks by
+ *              bumping an offset and is never freed piece by piece; it is
+ *              all released at once when the arena is destroyed. Objects
+ *              made in an arena must have their destructors run by their
+ *              owner, which then leaves the memory to the arena.
+ * Input:  none
+ * Output: none
+ ************************************************************************/
+
+#ifndef ARENA_HPP
+#define ARENA_HPP
+
+#include <cstddef>
+#include <vector>
+#include <new>
+#include <utility>
+
+const size_t ARENA_BLOCK_BYTES = 64 * 1024;   /* size of each block, unless an allocation is larger */
+
+class Arena {
+  private:
+    struct block {
+      char *data;
+      size_t size;
+    };
+
+    size_t block_bytes;         /* size of new blocks */
+    std::vector<block> blocks;  /* every block */
+    size_t current;             /* the block being allocated from */
+    size_t used;                /* bytes of it already handed out */
+
+  public:
+    Arena(size_t block_bytes = ARENA_BLOCK_BYTES);
+    ~Arena();
+    Arena(const Arena &) = delete;
+    Arena &operator=(const Arena &) = delete;
+
+    void *allocate(size_t bytes, size_t align);
+
+    /* makes an object in the arena; its owner must run its destructor */
+    template <typename T, typename... Args>
+    T *make(Args&&... args)
+      { return new (this->allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...); }
+};
+
+#endif
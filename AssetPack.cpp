@@ -0,0 +1,235 @@
+/*************************************************************************
+ * Program Filename: AssetPack.cpp
+ * Author: David Bacher-Hicks
+ * Date: 19 October 2026
+ * Description: A class definition file for an AssetPack class. The pack
+ *              is mapped read-only and its records are used in place;
+ *              opening a pack only checks that its sections lie within 
+ *              the file, so the cost does not grow with the content.
+ *              A build with EMBEDDED_GAMEDATA also carries the records
+ *              the packer wrote to GamedataTables.hpp, which can be opened
+ *              in place of a pack file.
+ * Input:  a pack file
+ * Output: none
+ ************************************************************************/
+
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "AssetPack.hpp"
+#ifdef EMBEDDED_GAMEDATA
+#include "GamedataTables.hpp"
+#endif
+
+/*************************************************************************
+ * Function: AssetPack
+ * Description: constructor
+ * Parameters: none
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: none
+ ************************************************************************/
+AssetPack::AssetPack()
+{
+  this->data = NULL;
+  this->size = 0;
+  this->header = NULL;
+  this->item_records = NULL;
+  this->mob_records = NULL;
+  this->loot_records = NULL;
+  this->floor_records = NULL;
+  this->object_records = NULL;
+  this->grid_data = NULL;
+  this->string_data = NULL;
+}
+
+
+/*************************************************************************
+ * Function: ~AssetPack
+ * Description: destructor; unmaps the pack
+ * Parameters: none
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: none
+ ************************************************************************/
+AssetPack::~AssetPack()
+{
+  this->close();
+}
+
+
+/*************************************************************************
+ * Function: open
+ * Description: maps a pack into memory and checks its header
+ * Parameters: path - the path of the pack
+ * Pre-conditions: none
+ * Post-conditions: the pack may have been mapped
+ * Returns: bool - true if the pack was mapped and is valid
+ ************************************************************************/
+bool AssetPack::open(const std::string &path)
+{
+  struct stat st;
+  void *mapping = MAP_FAILED;
+  int fd = ::open(path.c_str(), O_RDONLY);
+
+  this->close();
+
+  if (fd != -1) {
+    if (fstat(fd, &st) == 0 && st.st_size >= static_cast<off_t>(sizeof(pack_header))) {
+      mapping = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    ::close(fd);
+  }
+
+  if (mapping != MAP_FAILED) {
+    this->data = static_cast<const char *>(mapping);
+    this->size = st.st_size;
+    this->header = reinterpret_cast<const pack_header *>(this->data);
+
+    /* reject anything that is not a complete pack of this version */
+    if (memcmp(this->header->magic, PACK_MAGIC, sizeof(PACK_MAGIC)) != 0 ||
+        this->header->version != PACK_VERSION ||
+        this->header->size != this->size ||
+        !this->section_fits(this->header->items_offset, this->header->item_count, sizeof(pack_item)) ||
+        !this->section_fits(this->header->mobs_offset, this->header->mob_count, sizeof(pack_mob)) ||
+        !this->section_fits(this->header->loot_offset, this->header->loot_count, sizeof(pack_loot)) ||
+        !this->section_fits(this->header->floors_offset, this->header->floor_count, sizeof(pack_floor)) ||
+        !this->section_fits(this->header->objects_offset, this->header->object_count, sizeof(pack_object)) ||
+        !this->section_fits(this->header->grids_offset, this->header->grids_size, 1) ||
+        !this->section_fits(this->header->strings_offset, this->header->strings_size, 1) ||
+        this->header->strings_size == 0 ||
+        this->data[this->header->strings_offset + this->header->strings_size - 1] != '\0') {
+      this->close();
+    } else {
+      this->item_records = reinterpret_cast<const pack_item *>(this->data + this->header->items_offset);
+      this->mob_records = reinterpret_cast<const pack_mob *>(this->data + this->header->mobs_offset);
+      this->loot_records = reinterpret_cast<const pack_loot *>(this->data + this->header->loot_offset);
+      this->floor_records = reinterpret_cast<const pack_floor *>(this->data + this->header->floors_offset);
+      this->object_records = reinterpret_cast<const pack_object *>(this->data + this->header->objects_offset);
+      this->grid_data = this->data + this->header->grids_offset;
+      this->string_data = this->data + this->header->strings_offset;
+    }
+  }
+
+  return this->is_open();
+}
+
+
+/*************************************************************************
+ * Function: open_embedded
+ * Description: opens the gamedata built into the program, if it was 
+ *              built with EMBEDDED_GAMEDATA. The records are constant
+ *              tables, so nothing is read or checked.
+ * Parameters: none
+ * Pre-conditions: none
+ * Post-conditions: the embedded gamedata may have been opened
+ * Returns: bool - true if the program carries embedded gamedata
+ ************************************************************************/
+bool AssetPack::open_embedded()
+{
+  this->close();
+
+#ifdef EMBEDDED_GAMEDATA
+  this->header = &EMBEDDED_HEADER;
+  this->item_records = EMBEDDED_ITEMS;
+  this->mob_records = EMBEDDED_MOBS;
+  this->loot_records = EMBEDDED_LOOT;
+  this->floor_records = EMBEDDED_FLOORS;
+  this->object_records = EMBEDDED_OBJECTS;
+  this->grid_data = EMBEDDED_GRIDS;
+  this->string_data = EMBEDDED_STRINGS;
+#endif
+
+  return this->is_open();
+}
+
+
+/*************************************************************************
+ * Function: close
+ * Description: unmaps the pack
+ * Parameters: none
+ * Pre-conditions: none
+ * Post-conditions: the pack is closed; records from it are invalid
+ * Returns: none
+ ************************************************************************/
+void AssetPack::close()
+{
+  if (this->data != NULL) {
+    munmap(const_cast<char *>(this->data), this->size);
+    this->data = NULL;
+    this->size = 0;
+  }
+
+  this->header = NULL;
+  this->item_records = NULL;
+  this->mob_records = NULL;
+  this->loot_records = NULL;
+  this->floor_records = NULL;
+  this->object_records = NULL;
+  this->grid_data = NULL;
+  this->string_data = NULL;
+}
+
+
+/*************************************************************************
+ * Function: section_fits
+ * Description: checks that a section lies within the pack and is aligned
+ * Parameters: offset - the section offset
+ *             count - the number of records
+ *             record_size - the size of a record
+ * Pre-conditions: the pack must be mapped
+ * Post-conditions: none
+ * Returns: bool - true if the section fits
+ ************************************************************************/
+bool AssetPack::section_fits(uint32_t offset, uint32_t count, size_t record_size)
+{
+  return (record_size == 1 || offset % 8 == 0) &&
+         offset <= this->size &&
+         static_cast<uint64_t>(count) * record_size <= this->size - offset;
+}
+
+
+/*************************************************************************
+ * Function: string
+ * Description: returns a string from the string table
+ * Parameters: offset - the string's offset in the string table
+ * Pre-conditions: the pack must be open
+ * Post-conditions: none
+ * Returns: const char * - the string, or "" for an invalid reference
+ ************************************************************************/
+const char *AssetPack::string(uint32_t offset)
+{
+  const char *str = "";
+
+  if (offset < this->header->strings_size) {
+    str = this->string_data + offset;
+  }
+
+  return str;
+}
+
+
+/*************************************************************************
+ * Function: grid
+ * Description: returns a floor's prebuilt grid, one glyph per tile in row
+ *              order, with '\0' where a row is shorter than the floor
+ * Parameters: floor - the floor record
+ * Pre-conditions: the pack must be open
+ * Post-conditions: none
+ * Returns: const char * - the grid, or NULL if it lies outside the pack
+ ************************************************************************/
+const char *AssetPack::grid(const pack_floor *floor)
+{
+  const char *grid = NULL;
+  uint64_t grid_size = static_cast<uint64_t>(floor->width) * floor->height;
+
+  if (floor->width >= 0 && floor->height >= 0 &&
+      floor->grid <= this->header->grids_size &&
+      grid_size <= this->header->grids_size - floor->grid) {
+    grid = this->grid_data + floor->grid;
+  }
+
+  return grid;
+}
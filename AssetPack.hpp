@@ -0,0 +1,138 @@
+/*************************************************************************
+ * Program Filename: AssetPack.hpp
+ * Author: David Bacher-Hicks
+ * Date: 19 October 2026
+ * Description: A declaration file for the binary asset pack layout and an
+ *              AssetPack class that maps a pack into memory. A pack holds
+ *              the whole gamedata tree (items, mobs, loot tables, floor 
+ *              layouts and floor objects) as fixed-layout records, with 
+ *              every string stored once in an interned string table.
+ *
+ *              Packs are compiled from the gamedata text files by the 
+ *              packer (see packer.cpp, "make pack"). The packer can also
+ *              write the same records as constexpr tables, which a build
+ *              with EMBEDDED_GAMEDATA ("make EMBED=1") links into the game.
+ * Input:  a pack file
+ * Output: none
+ ************************************************************************/
+
+#ifndef ASSETPACK_HPP
+#define ASSETPACK_HPP
+
+#include <string>
+#include <cstddef>
+#include <stdint.h>
+
+const char     PACK_MAGIC[8] = { 'V', 'R', 'P', 'A', 'C', 'K', '\0', '\0' };
+const uint32_t PACK_VERSION  = 1;
+const uint32_t PACK_NO_STR   = 0xFFFFFFFF;  /* string reference for "no string" */
+
+          ////////////////////////////////////////////////////////
+         //               Record Layouts                       // 
+        ////////////////////////////////////////////////////////
+
+/* item kinds */
+enum pack_item_kind { PACK_ITEM, PACK_WEAPON, PACK_ARMOR };
+
+/* floor object kinds, as named in the floor .dat files */
+enum pack_object_kind { PACK_DOOR, PACK_STAIR, PACK_OBJ_ITEM, PACK_OBJ_MOB };
+
+/* 
+ * all string fields are offsets into the string table. Every section
+ * starts on an 8 byte boundary and every record is a multiple of 8 bytes
+ */
+struct pack_header {
+  char     magic[8];
+  uint32_t version;
+  uint32_t size;              /* size of the whole pack, in bytes */
+  uint32_t items_offset,   item_count;
+  uint32_t mobs_offset,    mob_count;
+  uint32_t loot_offset,    loot_count;
+  uint32_t floors_offset,  floor_count;
+  uint32_t objects_offset, object_count;
+  uint32_t grids_offset,   grids_size;
+  uint32_t strings_offset, strings_size;
+};
+
+struct pack_item {
+  uint32_t id, name, description;
+  uint32_t kind;              /* pack_item_kind */
+  double   weight, value;
+  int32_t  die_n, die_s, die_m, ac;
+};
+
+struct pack_mob {
+  double   cr;
+  uint32_t id, name;
+  int32_t  render_char;
+  int32_t  ac, hp, die_n, die_s, die_m, b_atk;
+  uint32_t loot_first, loot_count;  /* range of the mob's loot records */
+  uint32_t pad;
+};
+
+struct pack_loot {
+  uint32_t item;
+  int32_t  chance;
+};
+
+struct pack_floor {
+  uint32_t id;
+  int32_t  width, height;
+  uint32_t grid;                      /* offset of the grid in the grids section */
+  uint32_t object_first, object_count;  /* range of the floor's object records */
+};
+
+struct pack_object {
+  uint32_t kind;              /* pack_object_kind */
+  int32_t  x, y;
+  uint32_t target;            /* key, linked floor, item or mob ID */
+  int32_t  x2, y2;            /* linked coordinate, for stairs */
+};
+
+          ////////////////////////////////////////////////////////
+         //               AssetPack                            // 
+        ////////////////////////////////////////////////////////
+
+class AssetPack {
+  private:
+    const char *data;           /* the mapped pack, or NULL if not mapped */
+    size_t size;                /* size of the mapping */
+    const pack_header *header;  /* the pack header, or NULL if not open */
+
+    /* each section of the open pack, in the mapping or the embedded tables */
+    const pack_item *item_records;
+    const pack_mob *mob_records;
+    const pack_loot *loot_records;
+    const pack_floor *floor_records;
+    const pack_object *object_records;
+    const char *grid_data;
+    const char *string_data;
+
+    bool section_fits(uint32_t offset, uint32_t count, size_t record_size);
+
+  public:
+    AssetPack();
+    ~AssetPack();
+
+    bool open(const std::string &path);
+    bool open_embedded();
+    void close();
+    bool is_open() { return this->header != NULL; }
+
+    const char *string(uint32_t offset);
+
+    const pack_item *items() { return this->item_records; }
+    const pack_mob *mobs() { return this->mob_records; }
+    const pack_loot *loot() { return this->loot_records; }
+    const pack_floor *floors() { return this->floor_records; }
+    const pack_object *objects() { return this->object_records; }
+    const char *grid(const pack_floor *floor);
+
+    uint32_t item_count() { return this->header->item_count; }
+    uint32_t mob_count() { return this->header->mob_count; }
+    uint32_t loot_count() { return this->header->loot_count; }
+    uint32_t floor_count() { return this->header->floor_count; }
+    uint32_t object_count() { return this->header->object_count; }
+};
+
+#endif
@@ -0,0 +1,205 @@
+/*************************************************************************
+ * Program Filename: Autosave.cpp
+ * Author: David Bacher-Hicks
+ * Date: 19 October 2026
+ * Description: A class definition file for an Autosave class. Snapshots
+ *              are taken by forking the game process; the child holds a
+ *              copy-on-write image of the game state as it was at the
+ *              fork, serializes it and exits, while the parent carries on
+ *              with the next turn.
+ * Input:  none
+ * Output: a save file
+ ************************************************************************/
+
+#include <sstream>
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "Autosave.hpp"
+#include "Game.hpp"
+
+/*************************************************************************
+ * Function: Autosave
+ * Description: constructor
+ * Parameters: path - the path of the save file
+ *             interval - the number of turns between autosaves
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: none
+ ************************************************************************/
+Autosave::Autosave(std::string path, int interval)
+{
+  this->path = path;
+  this->interval = interval;
+  this->turns = 0;
+  this->writer = -1;
+  this->writer_tag = 0;
+  this->saved_tag = 0;
+}
+
+
+/*************************************************************************
+ * Function: ~Autosave
+ * Description: destructor; waits on any snapshot still being written so
+ *              that a half-written save is never left behind.
+ * Parameters: none
+ * Pre-conditions: none
+ * Post-conditions: no snapshot writer is running
+ * Returns: none
+ ************************************************************************/
+Autosave::~Autosave()
+{
+  this->reap(true);
+}
+
+
+/*************************************************************************
+ * Function: snapshot
+ * Description: saves the game state. In the background, the process is
+ *              forked and the child writes the save, so the snapshot is
+ *              consistent with the moment of the fork. If a previous
+ *              snapshot is still being written, the snapshot is skipped
+ *              and remains due. If the fork fails, the save is written in
+ *              the foreground instead.
+ *
+ * Parameters: game - the game to save
+ *             tag - a caller-defined tag for the snapshot, reported by
+ *                   get_saved_tag once the snapshot is on disk
+ *             background - false to write the save before returning
+ * Pre-conditions: none
+ * Post-conditions: a snapshot may have been started or written
+ * Returns: bool - true if a snapshot was started or written
+ ************************************************************************/
+bool Autosave::snapshot(Game *game, int tag, bool background)
+{
+  bool started = false;
+  pid_t pid = -1;
+
+  /* never let two writers race on the same file */
+  this->reap(!background);
+
+  if (!this->in_flight()) {
+    if (background) {
+      pid = fork();
+    }
+
+    if (pid == 0) {
+      /* 
+       * child: serialize the copy-on-write image and leave without running
+       * any of the parent's exit handlers (ncurses, stream buffers)
+       */
+      std::ostringstream state;
+      game->save_state(state);
+      _exit(write_file(this->path, state.str()) ? 0 : 1);
+
+    } else if (pid > 0) {
+      this->writer = pid;
+      this->writer_tag = tag;
+      started = true;
+
+    } else {
+      std::ostringstream state;
+      game->save_state(state);
+      started = write_file(this->path, state.str());
+      if (started) {
+        this->saved_tag = tag;
+      }
+    }
+
+    this->turns = 0;
+  }
+
+  return started;
+}
+
+
+/*************************************************************************
+ * Function: reap
+ * Description: collects the snapshot writer if it has finished
+ * Parameters: wait - true to block until the writer has finished
+ * Pre-conditions: none
+ * Post-conditions: the writer may have been collected
+ * Returns: bool - true if a writer was collected and exited cleanly
+ ************************************************************************/
+bool Autosave::reap(bool wait)
+{
+  bool written = false;
+  int status = 0;
+
+  if (this->in_flight() && 
+      waitpid(this->writer, &status, wait ? 0 : WNOHANG) != 0) {
+    written = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    if (written) {
+      this->saved_tag = this->writer_tag;
+    }
+    this->writer = -1;
+  }
+
+  return written;
+}
+
+
+/*************************************************************************
+ * Function: exists
+ * Description: determines if there is a save to recover
+ * Parameters: none
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: bool - true if a save file exists
+ ************************************************************************/
+bool Autosave::exists()
+{
+  return access(this->path.c_str(), R_OK) == 0;
+}
+
+
+/*************************************************************************
+ * Function: discard
+ * Description: removes the save, once the game it belongs to is over
+ * Parameters: none
+ * Pre-conditions: none
+ * Post-conditions: the save file will have been deleted
+ * Returns: none
+ ************************************************************************/
+void Autosave::discard()
+{
+  this->reap(true);
+  unlink(this->path.c_str());
+}
+
+
+/*************************************************************************
+ * Function: write_file
+ * Description: writes data to a temporary file, flushes it to disk and 
+ *              renames it over path, so that path always holds either the
+ *              previous or the new contents in full.
+ *
+ * Parameters: path - the path to write to
+ *             data - the data to write
+ * Pre-conditions: none
+ * Post-conditions: path may have been replaced
+ * Returns: bool - true if the file was written
+ ************************************************************************/
+bool Autosave::write_file(const std::string &path, const std::string &data)
+{
+  std::string tmp_path = path + ".tmp";
+  bool written = false;
+  size_t offset = 0;
+  ssize_t n = 0;
+
+  int fd = open(tmp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+  if (fd != -1) {
+    while (offset < data.size() && 
+           (n = write(fd, data.data() + offset, data.size() - offset)) > 0) {
+      offset += n;
+    }
+
+    written = (offset == data.size()) && (fsync(fd) == 0);
+    written = (close(fd) == 0) && written;
+    written = written && (std::rename(tmp_path.c_str(), path.c_str()) == 0);
+  }
+
+  return written;
+}
@@ -0,0 +1,46 @@
+/*************************************************************************
+ * Program Filename: Autosave.hpp
+ * Author: David Bacher-Hicks
+ * Date: 19 October 2026
+ * Description: A class declaration file for an Autosave class. Autosave
+ *              decides when the game state should be saved and writes
+ *              snapshots of it without stalling the game loop.
+ * Input:  none
+ * Output: a save file
+ ************************************************************************/
+
+#ifndef AUTOSAVE_HPP
+#define AUTOSAVE_HPP
+
+#include <string>
+#include <sys/types.h>
+
+class Game;
+
+class Autosave {
+  private:
+    std::string path;   /* path of the save file */
+    int interval;       /* number of turns between autosaves */
+    int turns;          /* turns taken since the last snapshot */
+    pid_t writer;       /* pid of the process writing a snapshot, or -1 */
+    int writer_tag;     /* tag of the snapshot being written */
+    int saved_tag;      /* tag of the last snapshot known to be on disk */
+
+  public:
+    Autosave(std::string path, int interval);
+    ~Autosave();
+
+    void tick() { this->turns++; }
+    bool due() { return this->turns >= this->interval; }
+    bool in_flight() { return this->writer != -1; }
+    int get_saved_tag() { return this->saved_tag; }
+
+    bool snapshot(Game *game, int tag, bool background = true);
+    bool reap(bool wait = false);
+    bool exists();
+    void discard();
+
+    static bool write_file(const std::string &path, const std::string &data);
+};
+
+#endif
@@ -0,0 +1,343 @@
+/*************************************************************************
+ * Program Filename: Bitboards.cpp
+ * Author: David Bacher-Hicks
+ * Date: 19 October 2026
+ * Description: A class definition file for a Bitboards class. A run of
+ *              tiles along a row is filled a word at a time by doubling
+ *              shifts, and the flood fill spreads between rows by masking
+ *              each row with the rows above and below it.
+ * Input:  none
+ * Output: none
+ ************************************************************************/
+
+#include <algorithm>
+#include "Bitboards.hpp"
+
+/*************************************************************************
+ * Function: fill_east
+ * Description: spreads tiles toward the higher bits of a word, through
+ *              the open bits, in six shifts
+ * Parameters: gen - the tiles to spread from, all open
+ *             pro - the open tiles
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: uint64_t - every open tile reached without crossing a closed one
+ ************************************************************************/
+static uint64_t fill_east(uint64_t gen, uint64_t pro)
+{
+  gen |= pro & (gen << 1);   pro &= pro << 1;
+  gen |= pro & (gen << 2);   pro &= pro << 2;
+  gen |= pro & (gen << 4);   pro &= pro << 4;
+  gen |= pro & (gen << 8);   pro &= pro << 8;
+  gen |= pro & (gen << 16);  pro &= pro << 16;
+  gen |= pro & (gen << 32);
+  return gen;
+}
+
+
+/*************************************************************************
+ * Function: fill_west
+ * Description: spreads tiles toward the lower bits of a word, through
+ *              the open bits, in six shifts
+ * Parameters: gen - the tiles to spread from, all open
+ *             pro - the open tiles
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: uint64_t - every open tile reached without crossing a closed one
+ ************************************************************************/
+static uint64_t fill_west(uint64_t gen, uint64_t pro)
+{
+  gen |= pro & (gen >> 1);   pro &= pro >> 1;
+  gen |= pro & (gen >> 2);   pro &= pro >> 2;
+  gen |= pro & (gen >> 4);   pro &= pro >> 4;
+  gen |= pro & (gen >> 8);   pro &= pro >> 8;
+  gen |= pro & (gen >> 16);  pro &= pro >> 16;
+  gen |= pro & (gen >> 32);
+  return gen;
+}
+
+
+/*************************************************************************
+ * Function: Bitboards
+ * Description: constructor; the boards start with no tiles
+ * Parameters: none
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: none
+ ************************************************************************/
+Bitboards::Bitboards()
+{
+  this->width = this->height = this->words = 0;
+  this->bits = NULL;
+  this->view_top = 0;
+  this->view_bottom = -1;
+}
+
+
+/*************************************************************************
+ * Function: resize
+ * Description: sizes the boards for a floor, every tile a wall and every
+ *              other board empty, until the floor's spaces are set
+ * Parameters: width - the floor's width
+ *             height - the floor's height
+ * Pre-conditions: none
+ * Post-conditions: the boards hold no state
+ * Returns: none
+ ************************************************************************/
+void Bitboards::resize(int width, int height)
+{
+  this->width = width;
+  this->height = height;
+  this->words = (width + 63) >> 6;
+
+  this->storage.assign(this->height * this->words * BOARD_COUNT, 0);
+  this->bits = this->storage.data();
+  for (int i = 0; i < this->height * this->words; i++) {
+    this->word(BOARD_WALL, i) = ~uint64_t(0);
+  }
+  this->view_top = 0;
+  this->view_bottom = -1;
+}
+
+
+/*************************************************************************
+ * Function: any
+ * Description: tells whether a tile is on any of a set of boards
+ * Parameters: which - the boards, a bit for each
+ *             x, y - the tile
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: bool - true if the tile is on one of them
+ ************************************************************************/
+bool Bitboards::any(unsigned int which, int x, int y) const
+{
+  uint64_t tiles = 0;            /* the tile's word on every board asked about */
+  bool on;
+
+  if (x < 0 || y < 0 || x >= this->width || y >= this->height) {
+    on = (which & (1 << BOARD_WALL)) != 0;
+  } else {
+    for (int i = 0; i < BOARD_COUNT; i++) {
+      if (which & (1 << i)) {
+        tiles |= this->word(static_cast<board>(i), y * this->words + (x >> 6));
+      }
+    }
+    on = (tiles >> (x & 63)) & 1;
+  }
+
+  return on;
+}
+
+
+/*************************************************************************
+ * Function: clear
+ * Description: takes every tile off a board
+ * Parameters: which - the board
+ * Pre-conditions: none
+ * Post-conditions: the board is empty
+ * Returns: none
+ ************************************************************************/
+void Bitboards::clear(board which)
+{
+  for (int i = 0; i < this->height * this->words; i++) {
+    this->word(which, i) = 0;
+  }
+}
+
+
+/*************************************************************************
+ * Function: count
+ * Description: counts the tiles on a board
+ * Parameters: which - the board
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: size_t - how many tiles are on it
+ ************************************************************************/
+size_t Bitboards::count(board which) const
+{
+  size_t n = 0;
+
+  for (int i = 0; i < this->height * this->words; i++) {
+    n += __builtin_popcountll(this->word(which, i));
+  }
+
+  return n;
+}
+
+
+/*************************************************************************
+ * Function: fill_row
+ * Description: spreads a row's tiles along the row through its open
+ *              tiles, east across the row's words and then west
+ * Parameters: row - the row's tiles, all open
+ *             open - the row's open tiles
+ * Pre-conditions: none
+ * Post-conditions: row holds every open tile reached along the row
+ * Returns: none
+ ************************************************************************/
+void Bitboards::fill_row(uint64_t *row, const uint64_t *open) const
+{
+  uint64_t carry = 0;           /* whether the last tile of the word before was reached */
+
+  for (int w = 0; w < this->words; w++) {
+    row[w] = fill_east(row[w] | (carry & open[w]), open[w]);
+    carry = row[w] >> 63;
+  }
+
+  carry = 0;
+  for (int w = this->words - 1; w >= 0; w--) {
+    row[w] = fill_west(row[w] | ((carry << 63) & open[w]), open[w]);
+    carry = row[w] & 1;
+  }
+}
+
+
+/*************************************************************************
+ * Function: flood
+ * Description: finds every tile that can be reached from a tile in steps
+ *              up, down, left and right, as a breadth-first search would,
+ *              a row at a time: a row's tiles are spread along it, then
+ *              into the rows above and below, until no row grows
+ * Parameters: from - the tile to start from
+ *             blocked - the boards whose tiles cannot be entered
+ *             reached - set to the tiles reached, as a board
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: size_t - how many tiles were reached; none if from is blocked
+ ************************************************************************/
+size_t Bitboards::flood(const Coord &from, unsigned int blocked, std::vector<uint64_t> &reached) const
+{
+  std::vector<uint64_t> open(this->height * this->words, ~uint64_t(0));
+  std::vector<int> rows;        /* rows that grew, whose neighbours may grow */
+  std::vector<uint8_t> queued(this->height, 0);
+  const uint64_t *above, *below;
+  uint64_t grow;
+  size_t n = 0;
+  bool grown;
+  int y;
+
+  reached.assign(this->height * this->words, 0);
+
+  if (!this->any(blocked, from.x(), from.y())) {
+    for (int i = 0; i < BOARD_COUNT; i++) {
+      if (blocked & (1 << i)) {
+        for (size_t w = 0; w < open.size(); w++) {
+          open[w] &= ~this->word(static_cast<board>(i), w);
+        }
+      }
+    }
+
+    reached[from.y() * this->words + (from.x() >> 6)] = uint64_t(1) << (from.x() & 63);
+    this->fill_row(&reached[from.y() * this->words], &open[from.y() * this->words]);
+    queued[from.y()] = 1;
+    rows.push_back(from.y());
+
+    while (!rows.empty()) {
+      y = rows.back();
+      rows.pop_back();
+      queued[y] = 0;
+
+      for (int next = y - 1; next <= y + 1; next += 2) {
+        if (next >= 0 && next < this->height) {
+          above = next > 0 ? &reached[(next - 1) * this->words] : NULL;
+          below = next < this->height - 1 ? &reached[(next + 1) * this->words] : NULL;
+          grown = false;
+
+          for (int w = 0; w < this->words; w++) {
+            grow = ((above ? above[w] : 0) | (below ? below[w] : 0)) &
+                   open[next * this->words + w] & ~reached[next * this->words + w];
+            if (grow != 0) {
+              reached[next * this->words + w] |= grow;
+              grown = true;
+            }
+          }
+
+          if (grown) {
+            this->fill_row(&reached[next * this->words], &open[next * this->words]);
+            if (!queued[next]) {
+              queued[next] = 1;
+              rows.push_back(next);
+            }
+          }
+        }
+      }
+    }
+
+    for (auto i = reached.begin(); i != reached.end(); i++) {
+      n += __builtin_popcountll(*i);
+    }
+  }
+
+  return n;
+}
+
+
+/*************************************************************************
+ * Function: view
+ * Description: the field of view from a tile, by rays cast to every tile
+ *              on the edge of the square radius tiles out, each stopping
+ *              at the first wall or closed door, which is itself seen.
+ *              The tiles seen become the visible board, and are added
+ *              to the explored board
+ * Parameters: from - the tile looked from
+ *             radius - how far the rays reach
+ * Pre-conditions: radius > 0
+ * Post-conditions: the visible board holds only the tiles seen
+ * Returns: size_t - how many tiles are visible
+ ************************************************************************/
+size_t Bitboards::view(const Coord &from, int radius)
+{
+  uint64_t *tiles;               /* a word of every board */
+  uint64_t bit;
+  size_t n = 0;
+  int dx, dy, x, y;
+  bool opaque;                  /* whether the tile looked from is a wall or door */
+  bool stopped;
+
+  /* only the rows seen last time need clearing */
+  for (int w = this->view_top * this->words; w < (this->view_bottom + 1) * this->words; w++) {
+    this->word(BOARD_VISIBLE, w) = 0;
+  }
+  this->view_top = std::max(0, from.y() - radius);
+  this->view_bottom = std::min(this->height - 1, from.y() + radius);
+
+  if (from.x() >= 0 && from.y() >= 0 && from.x() < this->width && from.y() < this->height) {
+    this->set(BOARD_VISIBLE, from.x(), from.y(), true);
+    opaque = this->any(BOARDS_OPAQUE, from.x(), from.y());
+
+    for (int edge = 0; edge < 8 * radius; edge++) {
+      /* around the square's edge, clockwise from its top left corner */
+      if (edge < 2 * radius) {
+        dx = edge - radius; dy = -radius;
+      } else if (edge < 4 * radius) {
+        dx = radius; dy = edge - 3 * radius;
+      } else if (edge < 6 * radius) {
+        dx = 5 * radius - edge; dy = radius;
+      } else {
+        dx = -radius; dy = 7 * radius - edge;
+      }
+
+      stopped = opaque;
+      for (int step = 1; step <= radius && !stopped; step++) {
+        x = from.x() + dx * step / radius;
+        y = from.y() + dy * step / radius;
+        stopped = x < 0 || y < 0 || x >= this->width || y >= this->height;
+        if (!stopped) {
+          tiles = &this->bits[(y * this->words + (x >> 6)) * BOARD_COUNT];
+          bit = uint64_t(1) << (x & 63);
+          tiles[BOARD_VISIBLE] |= bit;
+          stopped = ((tiles[BOARD_WALL] | tiles[BOARD_CLOSED_DOOR]) & bit) != 0;
+        }
+      }
+    }
+  } else {
+    this->view_bottom = this->view_top - 1;
+  }
+
+  for (int w = this->view_top * this->words; w < (this->view_bottom + 1) * this->words; w++) {
+    this->word(BOARD_EXPLORED, w) |= this->word(BOARD_VISIBLE, w);
+    n += __builtin_popcountll(this->word(BOARD_VISIBLE, w));
+  }
+
+  return n;
+}
@@ -0,0 +1,91 @@
+/*************************************************************************
+ * Program Filename: Bitboards.hpp
+ * Author: David Bacher-Hicks
+ * Date: 19 October 2026
+ * Description: A class declaration file for a Bitboards class, a floor's
+ *              tiles as packed bitsets, one bit a tile and 64 tiles a
+ *              word, each row starting on a word. There is a board for
+ *              walls, closed doors, items that block the way, occupied
+ *              tiles, tiles with items, and the tiles explored and now
+ *              visible; a word of each board is kept beside the same
+ *              word of the others, so a tile's questions read one line.
+ *              A floor's spaces keep the boards up to date as their state
+ *              changes, so a passability or occupancy question is a bit
+ *              test, and whole-floor questions, such as what can be
+ *              reached from a tile, are worked a word at a time. The
+ *              explored and visible boards are only filled by view.
+ * Input:  none
+ * Output: none
+ ************************************************************************/
+
+#ifndef BITBOARDS_HPP
+#define BITBOARDS_HPP
+
+#include <vector>
+#include <cstdint>
+#include "Coord.hpp"
+
+/* the boards; a tile outside the floor is a wall */
+enum board { BOARD_WALL,            /* walls, and tiles with no space */
+             BOARD_CLOSED_DOOR,     /* doors and secret doors not yet open */
+             BOARD_BLOCKING,        /* open tiles with an item that cannot be passed */
+             BOARD_OCCUPIED,        /* the player or a monster */
+             BOARD_ITEMS,           /* tiles with items lying on them */
+             BOARD_EXPLORED,        /* tiles the player has seen */
+             BOARD_VISIBLE,         /* tiles the player sees now */
+             BOARD_COUNT };
+
+/* sets of boards, for the whole-floor queries */
+const unsigned int BOARDS_IMPASSABLE = (1 << BOARD_WALL) | (1 << BOARD_CLOSED_DOOR) |
+                                       (1 << BOARD_BLOCKING);
+const unsigned int BOARDS_OPAQUE = (1 << BOARD_WALL) | (1 << BOARD_CLOSED_DOOR);
+
+class Bitboards {
+  private:
+    int width;
+    int height;
+    int words;                      /* words a row */
+    std::vector<uint64_t> storage;
+    uint64_t *bits;                 /* the boards' words, each word of every board together */
+    int view_top, view_bottom;      /* the rows the visible board has bits in */
+
+    uint64_t &word(board which, int index) { return this->bits[index * BOARD_COUNT + which]; }
+    uint64_t word(board which, int index) const { return this->bits[index * BOARD_COUNT + which]; }
+    void fill_row(uint64_t *row, const uint64_t *open) const;
+    /* blocked, for a tile within the floor, given its word of every board */
+    static bool blocked_within(const uint64_t *word, int x, bool occupants)
+      { return ((word[BOARD_WALL] | word[BOARD_CLOSED_DOOR] | word[BOARD_BLOCKING] |
+                 (occupants ? word[BOARD_OCCUPIED] : 0)) >> (x & 63)) & 1; }
+
+  public:
+    Bitboards();
+    Bitboards(const Bitboards &) = delete;
+    Bitboards &operator=(const Bitboards &) = delete;
+
+    void resize(int width, int height);
+    int get_words() const { return this->words; }
+
+    /* single tiles */
+    bool test(board which, int x, int y) const
+      { return (x < 0 || y < 0 || x >= this->width || y >= this->height) ? which == BOARD_WALL :
+               (this->bits[(y * this->words + (x >> 6)) * BOARD_COUNT + which] >> (x & 63)) & 1; }
+    void set(board which, int x, int y, bool on)
+      { uint64_t *word = &this->bits[(y * this->words + (x >> 6)) * BOARD_COUNT + which];
+        *word = on ? *word | (uint64_t(1) << (x & 63)) : *word & ~(uint64_t(1) << (x & 63)); }
+    bool any(unsigned int which, int x, int y) const;
+    /* a wall, a closed door or a blocking item; with occupants, someone there too */
+    bool blocked(int x, int y, bool occupants) const
+      { return x < 0 || y < 0 || x >= this->width || y >= this->height ||
+               this->blocked_within(&this->bits[(y * this->words + (x >> 6)) * BOARD_COUNT],
+                                    x, occupants); }
+    bool passable(const Coord &coord) const { return !this->blocked(coord.x(), coord.y(), false); }
+    bool enterable(const Coord &coord) const { return !this->blocked(coord.x(), coord.y(), true); }
+
+    /* whole floor */
+    void clear(board which);
+    size_t count(board which) const;
+    size_t flood(const Coord &from, unsigned int blocked, std::vector<uint64_t> &reached) const;
+    size_t view(const Coord &from, int radius);
+};
+
+#endif
@@ -3,16 +3,15 @@
  * Author: David Bacher-Hicks
  * Date: 3 December 2016
  * Description: A class definition file for a character class and its 
- *              subclasses, player and mob (monster or beast). Both the
- *              player character (Player) and enemies (mobs) inherit from
- *              a base Character class.
+ *              subclass, player. The player character (Player) inherits
+ *              from a base Character class; enemies (mobs) are kept as
+ *              components by their floor's Entities.
  *
  * Input: none
  * Output: none
  ************************************************************************/
 
 #include <cstdlib>
-#include <typeinfo>
 #include "Character.hpp"
 #include "Item.hpp"
 #include  "Die.hpp"
@@ -49,15 +48,7 @@ Character::Character(std::string name, char render_char, Coord coord)
  *************************************************************************/
 void Character::add_item(Item* item)
 {
-  /*
-   *  If the item is new, add a new item entry. If the item is not new, 
-   *  increment the count in the inventory map
-   */
-  if (this->inventory.find(item) == this->inventory.end()){
-    this->inventory.insert(std::pair<Item*, int>(item, 1));
-  } else {
-    ++(this->inventory[item]);
-  }
+  this->inventory.add(item);
 }
 
 /*************************************************************************
@@ -70,26 +61,7 @@ void Character::add_item(Item* item)
  *************************************************************************/
 bool Character::remove_item(Item * item)
 {
-  bool removed = false;
-
-  /*
-   *    If the passed item exists in the inventory and it is the last item,
-   *    delete the item from the map. Otherwise, decrement the count in
-   *    the inventory map.
-   */
-  auto it = this->inventory.find(item);
-
-  if ( it != this->inventory.end() && it->second != 0 ){
-    if (it->second == 1){
-      this->inventory.erase(it);
-    } else {
-      it->second--;
-    }
-
-    bool removed = true;    
-  }
-
-  return removed;
+  return this->inventory.remove(item);
 }
 
       ////////////////////////////////////////////////////////////
@@ -122,7 +94,8 @@ Player::Player(std::string name) : Character(name, PC_RENDER_C, STARTING_COORD)
 
 /*************************************************************************
  * Function: carry_weight
- * Description: calculates and returns the weight held by the player character
+ * Description: returns the weight held by the player character, as kept
+ *              by the inventory
  * Parameters: none
  * Pre-conditions: none
  * Post-conditions: none
@@ -130,11 +103,7 @@ Player::Player(std::string name) : Character(name, PC_RENDER_C, STARTING_COORD)
  *************************************************************************/
 double Player::carry_weight()
 {
-  double cw = 0;
-  for (auto i = this->inventory.begin(); i != this->inventory.end(); i++){
-    cw += i->first->weight() * i->second; 
-  }
-  return cw;
+  return this->inventory.get_weight();
 }
 
 
@@ -180,7 +149,7 @@ attack_data Player::attack()
   attack_data atk;
 
   atk.attack_roll = (rand() % 20 + 1) + this->b_atk + this->get_ability_mod(STR);
-  atk.damage_roll = dynamic_cast<Weapon*>(this->equipped_weapon)->roll_damage() + 
+  atk.damage_roll = this->equipped_weapon->roll_damage() + 
                     this->get_ability_mod(STR);
 
   return atk;
@@ -199,7 +168,7 @@ bool Player::defend(attack_data atk)
 {
   bool hit = false;
 
-  int defense = 10 + dynamic_cast<Armor*>(this->equipped_armor)->get_ac() 
+  int defense = 10 + this->equipped_armor->get_ac() 
                 + this->get_ability_mod(DEX);
 
   if (defense <= atk.attack_roll) {
@@ -221,10 +190,15 @@ bool Player::defend(attack_data atk)
  *************************************************************************/
 void Player::equip_item(Item *item)
 {
-  if (typeid(*item) == typeid(Weapon)) {
-    this->equipped_weapon = item;
-  } else if (typeid(*item) == typeid(Armor)) {
-    this->equipped_armor = item;
+  switch (item->get_kind()) {
+    case ITEM_WEAPON:
+      this->equipped_weapon = static_cast<Weapon*>(item);
+      break;
+    case ITEM_ARMOR:
+      this->equipped_armor = static_cast<Armor*>(item);
+      break;
+    default:
+      break;
   }
 }
 
@@ -275,73 +249,34 @@ void Player::inc_ability(ability ab)
     ////////////////////////////////////////////////////////////
 
 /*************************************************************************
- * Function: Mob
- * Description: constructor
- * Parameters: data - the mob_data to use to create the mob
- *             coord - the location of the mob
- *
+ * Function: mob_data::same_as
+ * Description: compares monster data with another, such as the same
+ *              monster read again from a changed table
+ * Parameters: other - the other monster data
  * Pre-conditions: none
  * Post-conditions: none
- * Returns: none
- *************************************************************************/
-Mob::Mob(mob_data *data, Coord coord) :
-  Character(data->name, data->render_char, coord)
+ * Returns: bool - true if every stat and the loot table are the same
+ ************************************************************************/
+bool mob_data::same_as(const mob_data &other) const
 {
-  this->ac = data->ac;
-  this->hp = data->hp;
-  this->b_atk = data->b_atk;
-  this->cr = data->cr;
-  this->damage_die = new Die(data->die_n, data->die_s, data->die_m);
+  return this->id == other.id && this->name == other.name &&
+         this->render_char == other.render_char && this->ac == other.ac &&
+         this->hp == other.hp && this->die_n == other.die_n &&
+         this->die_s == other.die_s && this->die_m == other.die_m &&
+         this->b_atk == other.b_atk && this->cr == other.cr &&
+         this->loot == other.loot;
 }
 
 
 /*************************************************************************
- * Function: attack
- * Description: constructs and returns an attack data structure
+ * Function: mob_data::roll_damage
+ * Description: rolls the kind's damage die
  * Parameters: none
  * Pre-conditions: none
  * Post-conditions: none
- * Returns: an attack data structure
- *************************************************************************/
-attack_data Mob::attack()
-{
-  attack_data atk;
-  atk.damage_roll = this->damage_die->roll();
-  atk.attack_roll = this->b_atk + (rand() % 20 + 1);
-  return atk;
-}
-
-
-/*************************************************************************
- * Function: defend
- * Description: determines hit/miss of incoming attacks; adjusts hp
- * Parameters: atk - the attack to defend against
- * Pre-conditions: none
- * Post-conditions: the hp may have been adjusted on a hit
- * Returns: bool - true if the attack hit
- *************************************************************************/
-bool Mob::defend(attack_data atk)
-{
-  bool hit = false;
-
-  if (atk.attack_roll >= this->ac) {
-    hit = true;
-    this->hp -= atk.damage_roll;
-  }
-
-  return hit;
-}
-
-
-/*************************************************************************
- * Function: ~Mob
- * Description: deallocates the damage die object
- * Parameters: none
- * Pre-conditions: none
- * Post-conditions: the damage_die memory is freed
- * Returns: none
- *************************************************************************/
-Mob::~Mob()
+ * Returns: int - the damage rolled
+ ************************************************************************/
+int mob_data::roll_damage() const
 {
-  delete this->damage_die;
+  return Die(this->die_n, this->die_s, this->die_m).roll();
 }
@@ -3,7 +3,8 @@
  * Author: David Bacher-Hicks
  * Date: 3 December 2016
  * Description: A class declaration file for a character class and its
- *              subclasses, player and mob.
+ *              subclass, player, and for the data of monsters, which are
+ *              kept as components by a floor's Entities.
  * Input: none
  * Output: none
  ************************************************************************/
@@ -14,9 +15,11 @@
 #include <string>
 #include <vector>
 #include "Coord.hpp"
+#include "Inventory.hpp"
 
 class Item;
-class Die;
+class Weapon;
+class Armor;
 
       ////////////////////////////////////////////////////////////
      //             Enumerated Data and Structs                //
@@ -24,8 +27,10 @@ class Die;
 
 enum ability { STR, DEX, CON, INT, WIS, CHA };
 
+/* a kind of monster, shared by every monster of the kind */
 struct mob_data {
   std::string id;
+  int num;                          /* dense monster number, set once loaded */
   std::string name;
   char render_char;
   int ac,
@@ -37,6 +42,9 @@ struct mob_data {
   double cr;
 
   std::vector<std::pair<std::string, int>> loot;
+
+  bool same_as(const mob_data &other) const;
+  int roll_damage() const;
 };
 
 struct attack_data {
@@ -60,7 +68,7 @@ class Character {
     std::string name;
     char render_char;
     Coord coord;
-    std::map<Item *, int> inventory;
+    Inventory inventory;
     int hp;
     int max_hp;
     int b_atk;
@@ -73,8 +81,8 @@ class Character {
     void set_coord(int x, int y) { this->coord = Coord(x,y); }
     void set_coord(Coord coord) { this->coord = coord; }
     Coord get_coord() { return this->coord; }
-    bool has(Item *item)  { return (this->inventory.find(item) != this->inventory.end()); } 
-    int item_count(Item *item) { return (this->inventory.find(item)->second); }
+    bool has(Item *item)  { return (this->inventory.find(item) != NO_ID); } 
+    int item_count(Item *item) { return this->inventory.count(item); }
     void add_item(Item *);
     bool remove_item(Item *);
     void set_name(std::string name) { this->name = name; }
@@ -83,10 +91,12 @@ class Character {
     void set_hp( int hp ) { this->hp = hp; }
     void rest() { this->hp = this->max_hp; }
     int get_max_hp() { return this->max_hp; };
+    void set_max_hp( int max_hp ) { this->max_hp = max_hp; }
+    void set_b_atk( int b_atk ) { this->b_atk = b_atk; }
     bool is_dead() { return this->hp <= 0; }
     virtual attack_data attack() = 0;
     virtual bool defend(attack_data) = 0;
-    std::map<Item *, int> *get_inventory() { return &(this->inventory); }
+    Inventory *get_inventory() { return &(this->inventory); }
 };
 
 
@@ -97,8 +107,8 @@ class Character {
 class Player : public Character {
   private:
     std::map<ability, int> ability_score;    
-    Item *equipped_weapon;
-    Item *equipped_armor;
+    Weapon *equipped_weapon;
+    Armor *equipped_armor;
     int experience;
     int level;
 
@@ -107,42 +117,21 @@ class Player : public Character {
     int get_ability_mod(ability ab) { return (this->ability_score[ab] - 10) / 2;  }
     int get_ability(ability ab) { return this->ability_score[ab]; }
     void inc_ability(ability ab);
+    void set_ability(ability ab, int score) { this->ability_score[ab] = score; }
     double carry_weight();
     double max_carry();
     bool encumbered();
     void equip_item(Item * item);
-    Item *get_weapon() { return this->equipped_weapon; }
-    Item *get_armor() { return this->equipped_armor; }
+    Weapon *get_weapon() { return this->equipped_weapon; }
+    Armor *get_armor() { return this->equipped_armor; }
     bool add_experience(int exp);
     int get_experience() { return this->experience; } 
+    void set_experience(int exp) { this->experience = exp; }
     int get_level() { return this->level; }
+    void set_level(int level) { this->level = level; }
     int get_b_atk() { return this->b_atk; }    
     virtual attack_data attack();
     virtual bool defend(attack_data);
 };
 
-
-      ////////////////////////////////////////////////////////////
-     //             Player Class                               //
-    ////////////////////////////////////////////////////////////
-
-class Mob : public Character {
-  protected:
-    Die *damage_die;
-
-    int ac,
-        die_n,
-        die_s,
-        die_m;
-    double cr;
-    
-  public:
-    Mob(mob_data *data, Coord coord);
-    ~Mob();
-
-    virtual attack_data attack();
-    virtual bool defend(attack_data);
-    int get_experience() { return this->cr * 300; }
-};
-
 #endif
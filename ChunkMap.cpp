@@ -0,0 +1,205 @@
+/*************************************************************************
+ * Program Filename: ChunkMap.cpp
+ * Author: David Bacher-Hicks
+ * Date: 19 October 2026
+ * Description: A class definition file for a ChunkMap class. The blank
+ *              chunk, the wall chunk and the wall they are filled with
+ *              are shared by every map, and never written; setting a
+ *              space in a sentinel first gives the map a copy of its own.
+ * Input:  none
+ * Output: none
+ ************************************************************************/
+
+#include <algorithm>
+#include "ChunkMap.hpp"
+#include "Space.hpp"
+
+/* the blank chunk, with no spaces */
+static space_chunk blank_chunk;
+
+/*************************************************************************
+ * Function: wall_chunk
+ * Description: gives the chunk of solid wall, made on first use
+ * Parameters: none
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: space_chunk * - the wall chunk
+ ************************************************************************/
+static space_chunk *wall_chunk()
+{
+  static space_chunk chunk = []() {
+    space_chunk walls;
+    for (int i = 0; i < CHUNK_TILES; i++) {
+      walls.spaces[i] = ChunkMap::shared_wall();
+    }
+    return walls;
+  }();
+
+  return &chunk;
+}
+
+
+/*************************************************************************
+ * Function: ChunkMap
+ * Description: constructor; the map starts with no tiles
+ * Parameters: arena - the arena to make the map's chunks in
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: none
+ ************************************************************************/
+ChunkMap::ChunkMap(Arena *arena)
+{
+  this->arena = arena;
+  this->width = this->height = 0;
+  this->chunks_wide = this->chunks_high = 0;
+  this->filled = 0;
+}
+
+
+/*************************************************************************
+ * Function: shared_wall
+ * Description: gives the wall every wall tile of every map points to. It
+ *              is at no coordinate of its own, and is never linked
+ * Parameters: none
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: Space * - the shared wall
+ ************************************************************************/
+Space *ChunkMap::shared_wall()
+{
+  static Wall wall(-1, -1);
+  return &wall;
+}
+
+
+/*************************************************************************
+ * Function: is_shared
+ * Description: tells whether a chunk is a sentinel, shared by every map
+ * Parameters: chunk - the chunk
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: bool - true for the blank and wall chunks
+ ************************************************************************/
+bool ChunkMap::is_shared(const space_chunk *chunk)
+{
+  return chunk == &blank_chunk || chunk == wall_chunk();
+}
+
+
+/*************************************************************************
+ * Function: is_blank
+ * Description: tells whether a chunk is the blank chunk
+ * Parameters: chunk - the chunk
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: bool - true if the chunk has no spaces and is shared
+ ************************************************************************/
+bool ChunkMap::is_blank(const space_chunk *chunk)
+{
+  return chunk == &blank_chunk;
+}
+
+
+/*************************************************************************
+ * Function: resize
+ * Description: grows the map to hold at least width x height tiles; the
+ *              new chunks are blank
+ * Parameters: width - the least width, in tiles
+ *             height - the least height, in tiles
+ * Pre-conditions: none
+ * Post-conditions: the map's spaces are unchanged
+ * Returns: none
+ ************************************************************************/
+void ChunkMap::resize(int width, int height)
+{
+  std::vector<space_chunk *> grown;
+  int chunks_wide, chunks_high;
+
+  width = std::max(width, this->width);
+  height = std::max(height, this->height);
+  chunks_wide = (width + CHUNK_MASK) >> CHUNK_SHIFT;
+  chunks_high = (height + CHUNK_MASK) >> CHUNK_SHIFT;
+
+  if (chunks_wide != this->chunks_wide || chunks_high != this->chunks_high) {
+    grown.assign(chunks_wide * chunks_high, &blank_chunk);
+    for (int y = 0; y < this->chunks_high; y++) {
+      for (int x = 0; x < this->chunks_wide; x++) {
+        grown[y * chunks_wide + x] = this->chunks[y * this->chunks_wide + x];
+      }
+    }
+    this->chunks.swap(grown);
+    this->chunks_wide = chunks_wide;
+    this->chunks_high = chunks_high;
+  }
+
+  this->width = width;
+  this->height = height;
+}
+
+
+/*************************************************************************
+ * Function: set
+ * Description: sets the space at a tile, giving its chunk a copy of its
+ *              own if the chunk is a sentinel and the space differs
+ * Parameters: x, y - the tile
+ *             space - the space, or NULL for none
+ * Pre-conditions: the tile must be within the map
+ * Post-conditions: the tile holds the space
+ * Returns: none
+ ************************************************************************/
+void ChunkMap::set(int x, int y, Space *space)
+{
+  space_chunk *&chunk = this->chunk_at(x, y);
+  int tile = chunk_tile(x, y);
+
+  if (chunk->spaces[tile] != space) {
+    if (is_shared(chunk)) {
+      if (is_blank(chunk)) {
+        this->filled++;
+      }
+      chunk = this->arena->make<space_chunk>(*chunk);
+    }
+    chunk->spaces[tile] = space;
+  }
+}
+
+
+/*************************************************************************
+ * Function: fill_wall
+ * Description: makes a blank chunk the shared chunk of solid wall
+ * Parameters: chunk_x, chunk_y - the chunk, in chunks
+ * Pre-conditions: the chunk must be blank, and wholly within the map
+ * Post-conditions: every tile of the chunk is the shared wall
+ * Returns: none
+ ************************************************************************/
+void ChunkMap::fill_wall(int chunk_x, int chunk_y)
+{
+  space_chunk *&chunk = this->chunks[chunk_y * this->chunks_wide + chunk_x];
+
+  if (is_blank(chunk)) {
+    chunk = wall_chunk();
+    this->filled++;
+  }
+}
+
+
+/*************************************************************************
+ * Function: owned_chunks
+ * Description: counts the chunks the map has made of its own
+ * Parameters: none
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: size_t - the number of chunks that are not sentinels
+ ************************************************************************/
+size_t ChunkMap::owned_chunks() const
+{
+  size_t owned = 0;
+
+  for (auto i = this->chunks.begin(); i != this->chunks.end(); i++) {
+    if (!is_shared(*i)) {
+      owned++;
+    }
+  }
+
+  return owned;
+}
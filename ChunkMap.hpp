@@ -0,0 +1,116 @@
+/*************************************************************************
+ * Program Filename: ChunkMap.hpp
+ * Author: David Bacher-Hicks
+ * Date: 19 October 2026
+ * Description: A class declaration file for a ChunkMap class, a floor's
+ *              spaces by coordinate, kept in square chunks of
+ *              CHUNK_SIDE x CHUNK_SIDE tiles. A chunk with no spaces, and
+ *              a chunk of solid wall, are shared read-only sentinels; a
+ *              chunk of its own is made in the floor's arena the first
+ *              time a space is set in it. Every wall of every floor is one
+ *              shared wall, as walls hold nothing, so a floor's memory
+ *              grows with its carved area rather than its bounding box.
+ *              A chunk's tiles are row by row, or, built with
+ *              MORTON_CHUNKS, in Z-order, so that a tile's neighbours
+ *              above and below are nearer to it than a whole row away.
+ * Input:  none
+ * Output: none
+ ************************************************************************/
+
+#ifndef CHUNKMAP_HPP
+#define CHUNKMAP_HPP
+
+#include <vector>
+#include "Coord.hpp"
+#include "Arena.hpp"
+
+class Space;
+
+const int CHUNK_SHIFT = 5;
+const int CHUNK_SIDE = 1 << CHUNK_SHIFT;    /* tiles along a chunk's side */
+const int CHUNK_MASK = CHUNK_SIDE - 1;
+const int CHUNK_TILES = CHUNK_SIDE * CHUNK_SIDE;
+
+/* a tile's index within its chunk, and back */
+#ifdef MORTON_CHUNKS
+inline int morton_spread(int v)     /* the bits of a chunk coordinate to every other bit */
+  { v = (v | (v << 4)) & 0x10F; v = (v | (v << 2)) & 0x133; return (v | (v << 1)) & 0x155; }
+inline int morton_compact(int v)    /* every other bit back to a chunk coordinate */
+  { v &= 0x155; v = (v | (v >> 1)) & 0x133; v = (v | (v >> 2)) & 0x10F; return (v | (v >> 4)) & CHUNK_MASK; }
+inline int chunk_tile(int x, int y)
+  { return morton_spread(x & CHUNK_MASK) | (morton_spread(y & CHUNK_MASK) << 1); }
+inline Coord chunk_tile_coord(int tile)
+  { return Coord(morton_compact(tile), morton_compact(tile >> 1)); }
+#else
+inline int chunk_tile(int x, int y)
+  { return ((y & CHUNK_MASK) << CHUNK_SHIFT) | (x & CHUNK_MASK); }
+inline Coord chunk_tile_coord(int tile)
+  { return Coord(tile & CHUNK_MASK, tile >> CHUNK_SHIFT); }
+#endif
+
+/* a chunk's spaces, by chunk_tile; NULL marks no space */
+struct space_chunk {
+  Space *spaces[CHUNK_TILES];
+};
+
+class ChunkMap {
+  private:
+    Arena *arena;                       /* holds the chunks of the map's own */
+    std::vector<space_chunk *> chunks;  /* row by row, each its own or a sentinel */
+    int width;                          /* in tiles */
+    int height;
+    int chunks_wide;
+    int chunks_high;
+    int filled;                         /* chunks that are not blank */
+
+    space_chunk *&chunk_at(int x, int y)
+      { return this->chunks[(y >> CHUNK_SHIFT) * this->chunks_wide + (x >> CHUNK_SHIFT)]; }
+
+  public:
+    ChunkMap(Arena *arena);
+
+    static Space *shared_wall();
+    static bool is_shared(const space_chunk *chunk);
+    static bool is_blank(const space_chunk *chunk);
+
+    void resize(int width, int height);
+    Space *get(int x, int y) const
+      { return (x < 0 || y < 0 || x >= this->width || y >= this->height) ? NULL :
+               this->chunks[(y >> CHUNK_SHIFT) * this->chunks_wide + (x >> CHUNK_SHIFT)]->
+                 spaces[chunk_tile(x, y)]; }
+    void set(int x, int y, Space *space);
+    void fill_wall(int chunk_x, int chunk_y);
+
+    /* chunk by chunk visits */
+    int get_chunks_wide() const { return this->chunks_wide; }
+    int get_chunks_high() const { return this->chunks_high; }
+    const space_chunk *get_chunk(int chunk_x, int chunk_y) const
+      { return this->chunks[chunk_y * this->chunks_wide + chunk_x]; }
+    Coord chunk_origin(int chunk_x, int chunk_y) const
+      { return Coord(chunk_x << CHUNK_SHIFT, chunk_y << CHUNK_SHIFT); }
+
+    /* calls visit on every space of the map's own chunks, chunk by chunk,
+       skipping the shared wall */
+    template <typename Visit>
+    void visit(Visit visit) const
+    {
+      Space *wall = shared_wall();
+
+      for (auto i = this->chunks.begin(); i != this->chunks.end(); i++) {
+        if (!is_shared(*i)) {
+          for (int j = 0; j < CHUNK_TILES; j++) {
+            if ((*i)->spaces[j] != NULL && (*i)->spaces[j] != wall) {
+              visit((*i)->spaces[j]);
+            }
+          }
+        }
+      }
+    }
+
+    int get_width() const { return this->width; }
+    int get_height() const { return this->height; }
+    bool empty() const { return this->filled == 0; }
+    size_t owned_chunks() const;
+};
+
+#endif
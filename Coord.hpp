@@ -9,6 +9,8 @@
 #ifndef COORD_HPP
 #define COORD_HPP
 
+enum direction {UP, RIGHT, DOWN, LEFT};
+
 class Coord{
   private:
     int x_coord;
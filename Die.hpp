@@ -24,6 +24,8 @@ class Die{
 
     int roll();
     int max();
+    bool operator==(const Die &other) const 
+      { return this->n_sides == other.n_sides && this->n_dice == other.n_dice && this->mod == other.mod; }
 };
 
 #endif
@@ -0,0 +1,320 @@
+/*************************************************************************
+ * Program Filename: DormantFloor.cpp
+ * Author: David Bacher-Hicks
+ * Date: 19 October 2026
+ * Description: A class definition file for a DormantFloor class. Each
+ *              packed record is a tag byte and its fields; an unsigned
+ *              field is seven bits a byte, low bits first, the top bit
+ *              set on every byte but the last, and a signed field is
+ *              zigzagged first so that small steps either way stay small.
+ *              A record naming an item or monster the tables do not have
+ *              is dropped, as restoring it would drop it.
+ * Input:  none
+ * Output: none
+ ************************************************************************/
+
+#include <sstream>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include "DormantFloor.hpp"
+
+/* the packed records, one for each record of Floor::save_state */
+enum packed_record { PACKED_END, PACKED_OPEN, PACKED_ITEM, PACKED_MOB, PACKED_MOBINV };
+
+/*************************************************************************
+ * Function: put_uint
+ * Description: appends an unsigned field, seven bits a byte
+ * Parameters: out - the bytes to append to
+ *             n - the field
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: none
+ ************************************************************************/
+static void put_uint(std::string &out, uint32_t n)
+{
+  while (n >= 0x80) {
+    out += static_cast<char>((n & 0x7F) | 0x80);
+    n >>= 7;
+  }
+  out += static_cast<char>(n);
+}
+
+
+/*************************************************************************
+ * Function: get_uint
+ * Description: reads an unsigned field written by put_uint
+ * Parameters: in - the bytes
+ *             pos - where the field starts; moved past it
+ *             n - set to the field
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: bool - false if the bytes end inside the field
+ ************************************************************************/
+static bool get_uint(const std::string &in, size_t &pos, uint32_t &n)
+{
+  bool more = true;               /* whether the field has another byte */
+  int shift = 0;
+
+  n = 0;
+  while (more && pos < in.size() && shift < 35) {
+    n |= static_cast<uint32_t>(in[pos] & 0x7F) << shift;
+    more = (in[pos] & 0x80) != 0;
+    pos++;
+    shift += 7;
+  }
+
+  return !more;
+}
+
+
+/*************************************************************************
+ * Function: put_int
+ * Description: appends a signed field, zigzagged
+ * Parameters: out - the bytes to append to
+ *             n - the field
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: none
+ ************************************************************************/
+static void put_int(std::string &out, int n)
+{
+  put_uint(out, (static_cast<uint32_t>(n) << 1) ^ static_cast<uint32_t>(n >> 31));
+}
+
+
+/*************************************************************************
+ * Function: get_int
+ * Description: reads a signed field written by put_int
+ * Parameters: in - the bytes
+ *             pos - where the field starts; moved past it
+ *             n - set to the field
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: bool - false if the bytes end inside the field
+ ************************************************************************/
+static bool get_int(const std::string &in, size_t &pos, int &n)
+{
+  uint32_t zigzag;
+  bool read = get_uint(in, pos, zigzag);
+
+  n = static_cast<int>(zigzag >> 1) ^ -static_cast<int>(zigzag & 1);
+
+  return read;
+}
+
+
+/*************************************************************************
+ * Function: pack
+ * Description: packs a floor's state, as written by Floor::save_state.
+ *              A monster's inventory is dropped with the monster
+ * Parameters: state - the state's records, through their "end" record
+ *             items - the item number of each item ID
+ *             mobs - the monster number of each monster ID
+ * Pre-conditions: none
+ * Post-conditions: the floor holds the state, and is not empty
+ * Returns: none
+ ************************************************************************/
+void DormantFloor::pack(const std::string &state, const NameTable &items, const NameTable &mobs)
+{
+  std::stringstream state_ss(state);
+  std::stringstream line_ss;
+  std::string line;
+  std::string record;
+  std::string tgt_id;
+  int x, y, n, num;
+  int last_x = 0, last_y = 0;     /* the coordinate of the record before */
+  bool mob_packed = false;        /* whether the last monster was packed, for its inventory */
+  bool ended = false;
+
+  this->packed.clear();
+
+  while (!ended && std::getline(state_ss, line)) {
+    line_ss.clear();
+    line_ss.str(line);
+    record.clear();
+    line_ss >> record;
+
+    if (record == "end") {
+      ended = true;
+
+    } else if (record == "open" && (line_ss >> x >> y)) {
+      this->packed += static_cast<char>(PACKED_OPEN);
+      put_int(this->packed, x - last_x);
+      put_int(this->packed, y - last_y);
+      last_x = x;
+      last_y = y;
+
+    } else if (record == "item" && (line_ss >> x >> y >> tgt_id)) {
+      num = items.find(tgt_id);
+      if (num != NO_ID) {
+        this->packed += static_cast<char>(PACKED_ITEM);
+        put_int(this->packed, x - last_x);
+        put_int(this->packed, y - last_y);
+        put_uint(this->packed, num);
+        last_x = x;
+        last_y = y;
+      }
+
+    } else if (record == "mob" && (line_ss >> x >> y >> tgt_id >> n)) {
+      num = mobs.find(tgt_id);
+      mob_packed = num != NO_ID;
+      if (mob_packed) {
+        this->packed += static_cast<char>(PACKED_MOB);
+        put_int(this->packed, x - last_x);
+        put_int(this->packed, y - last_y);
+        put_uint(this->packed, num);
+        put_int(this->packed, n);
+        last_x = x;
+        last_y = y;
+      }
+
+    } else if (record == "mobinv" && (line_ss >> tgt_id >> n)) {
+      num = items.find(tgt_id);
+      if (mob_packed && num != NO_ID && n > 0) {
+        this->packed += static_cast<char>(PACKED_MOBINV);
+        put_uint(this->packed, num);
+        put_uint(this->packed, n);
+      }
+    }
+  }
+
+  this->packed += static_cast<char>(PACKED_END);
+}
+
+
+/*************************************************************************
+ * Function: unpack
+ * Description: unpacks the floor's state into the records it was packed
+ *              from, for Floor::restore_state or a save file
+ * Parameters: items - the item ID of each item number
+ *             mobs - the monster ID of each monster number
+ * Pre-conditions: the tables must be those the state was packed with
+ * Post-conditions: none
+ * Returns: std::string - the records, through an "end" record, or "" if
+ *          the floor holds no state
+ ************************************************************************/
+std::string DormantFloor::unpack(const NameTable &items, const NameTable &mobs) const
+{
+  std::ostringstream state;
+  size_t pos = 0;
+  uint32_t num, count;
+  int dx, dy, hp;
+  int x = 0, y = 0;
+  bool ended = this->packed.empty();
+
+  while (!ended && pos < this->packed.size()) {
+    switch (this->packed[pos++]) {
+      case PACKED_OPEN:
+        ended = !(get_int(this->packed, pos, dx) && get_int(this->packed, pos, dy));
+        if (!ended) {
+          x += dx;
+          y += dy;
+          state << "open " << x << ' ' << y << '\n';
+        }
+        break;
+
+      case PACKED_ITEM:
+        ended = !(get_int(this->packed, pos, dx) && get_int(this->packed, pos, dy) &&
+                  get_uint(this->packed, pos, num) && num < (uint32_t)items.size());
+        if (!ended) {
+          x += dx;
+          y += dy;
+          state << "item " << x << ' ' << y << ' ' << items.name(num) << '\n';
+        }
+        break;
+
+      case PACKED_MOB:
+        ended = !(get_int(this->packed, pos, dx) && get_int(this->packed, pos, dy) &&
+                  get_uint(this->packed, pos, num) && num < (uint32_t)mobs.size() &&
+                  get_int(this->packed, pos, hp));
+        if (!ended) {
+          x += dx;
+          y += dy;
+          state << "mob " << x << ' ' << y << ' ' << mobs.name(num) << ' ' << hp << '\n';
+        }
+        break;
+
+      case PACKED_MOBINV:
+        ended = !(get_uint(this->packed, pos, num) && num < (uint32_t)items.size() &&
+                  get_uint(this->packed, pos, count));
+        if (!ended) {
+          state << "mobinv " << items.name(num) << ' ' << count << '\n';
+        }
+        break;
+
+      default:
+        ended = true;
+        break;
+    }
+  }
+
+  if (!this->packed.empty()) {
+    state << "end\n";
+  }
+
+  return state.str();
+}
+
+
+/*************************************************************************
+ * Function: pack_grid
+ * Description: packs a grid of space glyphs as runs, each a glyph and
+ *              how many times it repeats
+ * Parameters: glyphs - the grid, row by row
+ *             packed - set to the runs
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: none
+ ************************************************************************/
+void pack_grid(const std::vector<char> &glyphs, std::string &packed)
+{
+  size_t run;                     /* where the run ends */
+
+  packed.clear();
+  for (size_t i = 0; i < glyphs.size(); i = run) {
+    run = i + 1;
+    while (run < glyphs.size() && glyphs[run] == glyphs[i]) {
+      run++;
+    }
+    packed += glyphs[i];
+    put_uint(packed, run - i);
+  }
+}
+
+
+/*************************************************************************
+ * Function: unpack_grid
+ * Description: unpacks a grid packed by pack_grid
+ * Parameters: packed - the runs
+ *             tiles - the number of tiles in the grid
+ *             glyphs - set to the grid, row by row; tiles past the end
+ *                      of the runs are '\0', no space
+ * Pre-conditions: none
+ * Post-conditions: glyphs holds tiles glyphs
+ * Returns: bool - true if the runs filled the grid exactly
+ ************************************************************************/
+bool unpack_grid(const std::string &packed, size_t tiles, std::vector<char> &glyphs)
+{
+  size_t pos = 0;
+  size_t filled = 0;              /* tiles unpacked so far */
+  uint32_t run;
+  char glyph;
+  bool read = true;
+
+  glyphs.assign(tiles, '\0');
+  while (read && pos < packed.size() && filled < tiles) {
+    glyph = packed[pos++];
+    /* most runs are short enough for one byte */
+    if (pos < packed.size() && (packed[pos] & 0x80) == 0) {
+      run = packed[pos++];
+    } else {
+      read = get_uint(packed, pos, run);
+    }
+    run = std::min<size_t>(run, tiles - filled);
+    memset(&glyphs[filled], glyph, run);
+    filled += run;
+  }
+
+  return read && pos == packed.size() && filled == tiles;
+}
@@ -0,0 +1,43 @@
+/*************************************************************************
+ * Program Filename: DormantFloor.hpp
+ * Author: David Bacher-Hicks
+ * Date: 19 October 2026
+ * Description: A class declaration file for a DormantFloor class, the
+ *              packed state of a floor that is not loaded: its opened
+ *              doors, the items lying on it, and its monsters with their
+ *              hp and inventory, as the records Floor::save_state writes,
+ *              packed into bytes. Items and monsters are kept by number
+ *              rather than ID, and coordinates as the step from the record
+ *              before, all as variable length integers, so a floor's state
+ *              takes a few bytes a record. Also packs a floor's grid of
+ *              space glyphs as runs of one glyph, which a dungeon's walls
+ *              and rock make long.
+ * Input:  none
+ * Output: none
+ ************************************************************************/
+
+#ifndef DORMANTFLOOR_HPP
+#define DORMANTFLOOR_HPP
+
+#include <string>
+#include <vector>
+#include "NameTable.hpp"
+
+class DormantFloor {
+  private:
+    std::string packed;             /* the state's records, packed; "" for none */
+
+  public:
+    bool empty() const { return this->packed.empty(); }
+    void clear() { this->packed.clear(); }
+    size_t size() const { return this->packed.size(); }
+
+    void pack(const std::string &state, const NameTable &items, const NameTable &mobs);
+    std::string unpack(const NameTable &items, const NameTable &mobs) const;
+};
+
+/* a grid of space glyphs as runs, and back */
+void pack_grid(const std::vector<char> &glyphs, std::string &packed);
+bool unpack_grid(const std::string &packed, size_t tiles, std::vector<char> &glyphs);
+
+#endif
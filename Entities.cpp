@@ -0,0 +1,210 @@
+/*************************************************************************
+ * Program Filename: Entities.cpp
+ * Author: David Bacher-Hicks
+ * Date: 19 October 2026
+ * Description: A class definition file for an Entities class. A monster
+ *              is destroyed by moving the last monster's components into
+ *              its slot, so the arrays stay packed, and by bumping the
+ *              generation of its index, so its handles go stale.
+ * Input:  none
+ * Output: none
+ ************************************************************************/
+
+#include <cstdlib>
+#include "Entities.hpp"
+
+/*************************************************************************
+ * Function: create
+ * Description: makes a monster of a kind, with the kind's hit points
+ * Parameters: kind - the monster's data
+ *             coord - the monster's location
+ * Pre-conditions: none
+ * Post-conditions: the monster has the last slot
+ * Returns: entity - the monster's handle
+ ************************************************************************/
+entity Entities::create(const mob_data *kind, const Coord &coord)
+{
+  entity mob;
+  mob_ai ai;
+
+  if (this->free_indices.empty()) {
+    mob.index = this->slots.size();
+    this->slots.push_back(NO_SLOT);
+    this->generations.push_back(0);
+  } else {
+    mob.index = this->free_indices.back();
+    this->free_indices.pop_back();
+  }
+  mob.generation = this->generations[mob.index];
+  this->slots[mob.index] = this->owners.size();
+
+  ai.n_primary = ai.n_secondary = 0;
+
+  this->kinds.push_back(kind);
+  this->coords.push_back(coord);
+  this->hps.push_back(kind->hp);
+  this->ais.push_back(ai);
+  this->inventories.push_back(NO_INVENTORY);
+  this->owners.push_back(mob.index);
+
+  return mob;
+}
+
+
+/*************************************************************************
+ * Function: destroy
+ * Description: destroys a monster, moving the last monster into its slot
+ * Parameters: mob - the monster's handle
+ * Pre-conditions: none
+ * Post-conditions: the monster's handles are stale, and the last monster
+ *                  may have a new slot
+ * Returns: none
+ ************************************************************************/
+void Entities::destroy(entity mob)
+{
+  uint32_t slot = this->find(mob);
+  uint32_t last = this->owners.size() - 1;
+
+  if (slot != NO_SLOT) {
+    if (this->inventories[slot] != NO_INVENTORY) {
+      this->inventory_pool[this->inventories[slot]].clear();
+      this->free_inventories.push_back(this->inventories[slot]);
+    }
+
+    if (slot != last) {
+      this->kinds[slot] = this->kinds[last];
+      this->coords[slot] = this->coords[last];
+      this->hps[slot] = this->hps[last];
+      this->ais[slot] = this->ais[last];
+      this->inventories[slot] = this->inventories[last];
+      this->owners[slot] = this->owners[last];
+      this->slots[this->owners[slot]] = slot;
+    }
+
+    this->kinds.pop_back();
+    this->coords.pop_back();
+    this->hps.pop_back();
+    this->ais.pop_back();
+    this->inventories.pop_back();
+    this->owners.pop_back();
+
+    this->slots[mob.index] = NO_SLOT;
+    this->generations[mob.index]++;
+    this->free_indices.push_back(mob.index);
+  }
+}
+
+
+/*************************************************************************
+ * Function: add_item
+ * Description: adds an item to a monster's inventory, giving the monster
+ *              an inventory if it had none
+ * Parameters: slot - the monster's slot
+ *             item - the item to add
+ * Pre-conditions: none
+ * Post-conditions: the item is in the monster's inventory
+ * Returns: none
+ ************************************************************************/
+void Entities::add_item(uint32_t slot, Item *item)
+{
+  if (this->inventories[slot] == NO_INVENTORY) {
+    if (this->free_inventories.empty()) {
+      this->inventories[slot] = this->inventory_pool.size();
+      this->inventory_pool.push_back(Inventory());
+    } else {
+      this->inventories[slot] = this->free_inventories.back();
+      this->free_inventories.pop_back();
+    }
+  }
+
+  this->inventory_pool[this->inventories[slot]].add(item);
+}
+
+
+      ////////////////////////////////////////////////////////////
+     //                     Systems                            //
+    ////////////////////////////////////////////////////////////
+
+/*************************************************************************
+ * Function: plan_moves
+ * Description: the AI system. Every monster plans to close on the target:
+ *              its primary moves bring it closer, and its secondary moves
+ *              are tried only if it cannot advance directly. It's no
+ *              dijkstra, but whoever said goblins were smart?
+ * Parameters: target - the location the monsters close on
+ * Pre-conditions: none
+ * Post-conditions: every monster's AI state holds its moves
+ * Returns: none
+ ************************************************************************/
+void Entities::plan_moves(const Coord &target)
+{
+  mob_ai *ai;
+
+  for (uint32_t i = 0; i < this->coords.size(); i++) {
+    ai = &this->ais[i];
+    ai->n_primary = ai->n_secondary = 0;
+
+    if ( target.x() < this->coords[i].x() ) {
+      ai->primary[ai->n_primary++] = LEFT;
+      ai->secondary[ai->n_secondary++] = RIGHT;
+    } else if ( target.x() > this->coords[i].x() ) {
+      ai->primary[ai->n_primary++] = RIGHT;
+      ai->secondary[ai->n_secondary++] = LEFT;
+    } else {
+      ai->secondary[ai->n_secondary++] = LEFT;
+      ai->secondary[ai->n_secondary++] = RIGHT;
+    }
+
+    if ( target.y() < this->coords[i].y() ) {
+      ai->primary[ai->n_primary++] = UP;
+      ai->secondary[ai->n_secondary++] = DOWN;
+    } else if ( target.y() > this->coords[i].y() ) {
+      ai->primary[ai->n_primary++] = DOWN;
+      ai->secondary[ai->n_secondary++] = UP;
+    } else {
+      ai->secondary[ai->n_secondary++] = UP;
+      ai->secondary[ai->n_secondary++] = DOWN;
+    }
+  }
+}
+
+
+/*************************************************************************
+ * Function: attack
+ * Description: part of the combat system; rolls a monster's attack with
+ *              its kind's dice
+ * Parameters: slot - the attacking monster's slot
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: an attack data structure
+ ************************************************************************/
+attack_data Entities::attack(uint32_t slot)
+{
+  attack_data atk;
+  atk.damage_roll = this->kinds[slot]->roll_damage();
+  atk.attack_roll = this->kinds[slot]->b_atk + (rand() % 20 + 1);
+  return atk;
+}
+
+
+/*************************************************************************
+ * Function: defend
+ * Description: part of the combat system; determines hit/miss of an
+ *              attack on a monster, and adjusts its hp
+ * Parameters: slot - the defending monster's slot
+ *             atk - the attack to defend against
+ * Pre-conditions: none
+ * Post-conditions: the hp may have been adjusted on a hit
+ * Returns: bool - true if the attack hit
+ ************************************************************************/
+bool Entities::defend(uint32_t slot, const attack_data &atk)
+{
+  bool hit = false;
+
+  if (atk.attack_roll >= this->kinds[slot]->ac) {
+    hit = true;
+    this->hps[slot] -= atk.damage_roll;
+  }
+
+  return hit;
+}
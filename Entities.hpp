@@ -0,0 +1,111 @@
+/*************************************************************************
+ * Program Filename: Entities.hpp
+ * Author: David Bacher-Hicks
+ * Date: 19 October 2026
+ * Description: A class declaration file for an Entities class, the
+ *              monsters of a floor kept as components. Each component
+ *              (kind, position, hit points, AI state and inventory 
+ *              handle) is its own densely packed array, one entry per 
+ *              live monster, so the systems that move monsters, fight 
+ *              with them and plan their moves walk the arrays in order.
+ *              A monster holds only its own state; its name, glyph, dice
+ *              and stats are read from its kind, shared by every monster
+ *              of the kind. Monsters are named by generational handles;
+ *              a handle to a destroyed monster is stale, and never names
+ *              the monster made in its place.
+ * Input:  none
+ * Output: none
+ ************************************************************************/
+
+#ifndef ENTITIES_HPP
+#define ENTITIES_HPP
+
+#include <vector>
+#include <cstdint>
+#include "Coord.hpp"
+#include "Character.hpp"
+
+class Item;
+
+      ////////////////////////////////////////////////////////////
+     //             Handles and Components                     //
+    ////////////////////////////////////////////////////////////
+
+/* a handle to a monster */
+struct entity {
+  uint32_t index;                   /* the monster's index, reused once it is destroyed */
+  uint32_t generation;              /* how many monsters had the index before it */
+
+  bool operator==(const entity &other) const
+    { return this->index == other.index && this->generation == other.generation; }
+  bool operator!=(const entity &other) const { return !(*this == other); }
+};
+
+const entity NO_ENTITY = { UINT32_MAX, 0 };
+const uint32_t NO_SLOT = UINT32_MAX;        /* no live monster */
+const uint32_t NO_INVENTORY = UINT32_MAX;   /* a monster carrying nothing */
+
+/* a monster's AI state: the moves it will try this turn */
+struct mob_ai {
+  direction primary[2];             /* moves toward its target */
+  direction secondary[4];           /* moves tried if none of those can be made */
+  uint8_t n_primary;
+  uint8_t n_secondary;
+};
+
+      ////////////////////////////////////////////////////////////
+     //             Entities Class                             //
+    ////////////////////////////////////////////////////////////
+
+class Entities {
+  private:
+    /* the components, packed by slot; a destroyed monster's slot is
+       filled by the last monster */
+    std::vector<const mob_data *> kinds;
+    std::vector<Coord> coords;
+    std::vector<int> hps;
+    std::vector<mob_ai> ais;
+    std::vector<uint32_t> inventories;  /* inventory handles, or NO_INVENTORY */
+    std::vector<uint32_t> owners;       /* the index in each slot */
+
+    /* the slot and generation of each index */
+    std::vector<uint32_t> slots;
+    std::vector<uint32_t> generations;
+    std::vector<uint32_t> free_indices;
+
+    /* the inventories, by handle */
+    std::vector<Inventory> inventory_pool;
+    std::vector<uint32_t> free_inventories;
+
+  public:
+    entity create(const mob_data *kind, const Coord &coord);
+    void destroy(entity mob);
+    uint32_t find(entity mob) const
+      { return (mob.index < this->slots.size() && this->generations[mob.index] == mob.generation) ?
+               this->slots[mob.index] : NO_SLOT; }
+    entity get_handle(uint32_t slot) const
+      { entity mob = { this->owners[slot], this->generations[this->owners[slot]] }; return mob; }
+    uint32_t size() const { return this->owners.size(); }
+
+    /* components, by slot */
+    const mob_data *get_kind(uint32_t slot) const { return this->kinds[slot]; }
+    Coord get_coord(uint32_t slot) const { return this->coords[slot]; }
+    void set_coord(uint32_t slot, const Coord &coord) { this->coords[slot] = coord; }
+    int get_hp(uint32_t slot) const { return this->hps[slot]; }
+    void set_hp(uint32_t slot, int hp) { this->hps[slot] = hp; }
+    bool is_dead(uint32_t slot) const { return this->hps[slot] <= 0; }
+    const mob_ai &get_ai(uint32_t slot) const { return this->ais[slot]; }
+    char get_glyph(uint32_t slot) const { return this->kinds[slot]->render_char; }
+    const Inventory *get_inventory(uint32_t slot) const
+      { return this->inventories[slot] == NO_INVENTORY ? NULL : &this->inventory_pool[this->inventories[slot]]; }
+    void add_item(uint32_t slot, Item *item);
+    const std::string &get_name(uint32_t slot) const { return this->kinds[slot]->name; }
+    int get_experience(uint32_t slot) const { return this->kinds[slot]->cr * 300; }
+
+    /* systems */
+    void plan_moves(const Coord &target);
+    attack_data attack(uint32_t slot);
+    bool defend(uint32_t slot, const attack_data &atk);
+};
+
+#endif
@@ -3,37 +3,120 @@
  * Author: David Bacher-Hicks
  * Date: 3 December 2016
  * Description: A class definition file for a Floor class. Encapsulates
- *              Space objects.
+ *              Space objects and the floor's monsters. A floor's spaces
+ *              and the chunks that hold them are all made in the floor's
+ *              arena, and released together with the floor. Its walls are
+ *              the shared wall, and a chunk of nothing but wall is the
+ *              shared wall chunk, so solid rock costs next to nothing.
+ *              The floor's bitboards answer whether a tile can be passed
+ *              or entered, without asking its space.
  * Input:  none
  * Output: none
  ************************************************************************/
 
+#include <sstream>
+#include <algorithm>
 #include "Floor.hpp"
+#include "Layout.hpp"
 #include "Character.hpp"
 
+/*************************************************************************
+ * Function: Floor
+ * Description: constructor
+ * Parameters: none
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: none
+ ************************************************************************/
+Floor::Floor() : spaces(&this->arena)
+{
+}
+
+
 /*************************************************************************
  * Function: load_floor
- * Description: loads a floor layout from a floor layout file
+ * Description: loads a floor layout from a floor layout file, by reading
+ *              it into a grid of glyphs and loading the grid
  * Parameters: path - the path of the layout file
+ *             error - set to the reason the layout could not be loaded
  * Pre-conditions: none
- * Post-conditions: none
+ * Post-conditions: the floor's spaces will have been created, unless the
+ *                  file could not be read or held an unknown glyph
+ * Returns: bool - true if the layout was loaded
+ ************************************************************************/
+bool Floor::load_floor(const std::string &path, std::string &error)
+{
+  Layout layout;
+  bool loaded = layout.read(path);
+
+  if (loaded) {
+    this->load_grid(layout.grid(), layout.get_width(), layout.get_height());
+  } else {
+    error = layout.error();
+  }
+
+  return loaded;
+}
+
+
+/*************************************************************************
+ * Function: load_grid
+ * Description: loads a floor layout from a prebuilt grid of space glyphs,
+ *              chunk by chunk. A whole chunk of wall becomes the shared
+ *              wall chunk, and a chunk with no spaces stays blank; only
+ *              the others are given chunks of their own, their spaces
+ *              made in the order of the chunk's tiles. The bitboards are
+ *              sized to the grid, and each space puts itself on them
+ * Parameters: grid - the glyphs, row by row; '\0' marks no space
+ *             width - the width of the grid
+ *             height - the height of the grid
+ * Pre-conditions: none
+ * Post-conditions: the floor's spaces will have been created
  * Returns: none
  ************************************************************************/
-void Floor::load_floor(std::string path)
+void Floor::load_grid(const char *grid, int width, int height)
 {
-  std::ifstream in_file(path.c_str());
-  std::string line;
-  Coord coord(0,0);
+  Space *space;
+  Space *wall = ChunkMap::shared_wall();
+  Coord origin, tile;
+  int right, bottom;            /* just past the chunk's last tile in the grid */
+  bool walled;                  /* whether the chunk is all wall so far */
+
+  this->spaces.resize(width, height);
+  this->boards.resize(width, height);
 
-  while(std::getline(in_file, line)){
-    coord.set_x(0);
-    for(int i = 0; i < line.length(); i++){      
-      this->spaces.insert(std::pair<Coord,Space*>(coord, interpret_space(line.at(i), coord)));
-      coord.set_x(coord.x() + 1);
+  for (int cy = 0; cy < this->spaces.get_chunks_high(); cy++) {
+    for (int cx = 0; cx < this->spaces.get_chunks_wide(); cx++) {
+      origin = this->spaces.chunk_origin(cx, cy);
+      right = std::min(origin.x() + CHUNK_SIDE, width);
+      bottom = std::min(origin.y() + CHUNK_SIDE, height);
+
+      /* only a chunk wholly within the grid can be the wall chunk */
+      walled = right - origin.x() == CHUNK_SIDE && bottom - origin.y() == CHUNK_SIDE;
+      for (int y = origin.y(); y < bottom && walled; y++) {
+        for (int x = origin.x(); x < right && walled; x++) {
+          walled = grid[y * width + x] == WALL_C;
+        }
+      }
+
+      if (walled) {
+        this->spaces.fill_wall(cx, cy);
+      } else {
+        for (int i = 0; i < CHUNK_TILES; i++) {
+          tile = chunk_tile_coord(i);
+          tile.set(origin.x() + tile.x(), origin.y() + tile.y());
+          if (tile.x() < right && tile.y() < bottom &&
+              grid[tile.y() * width + tile.x()] != '\0' &&
+              (space = interpret_space(grid[tile.y() * width + tile.x()], tile)) != NULL) {
+            this->spaces.set(tile.x(), tile.y(), space);
+            if (space != wall) {
+              space->set_boards(&this->boards);
+            }
+          }
+        }
+      }
     }
-    coord.set_y(coord.y() + 1); 
   }
-  in_file.close();
 }
 
 
@@ -46,7 +129,8 @@ void Floor::load_floor(std::string path)
  *              coord - the coordinate of the space
  * Pre-conditions: none
  * Post-conditions: none
- * Returns: Space *space - a pointer to the created space
+ * Returns: Space *space - a pointer to the created space, the shared
+ *          wall for a wall, or NULL if the character is not a space glyph
  ************************************************************************/
 Space *Floor::interpret_space(char space_char, Coord coord)
 {
@@ -54,27 +138,27 @@ Space *Floor::interpret_space(char space_char, Coord coord)
 
   switch(space_char) {
    case EMPTY_SPACE_C:
-      space = new OpenSpace(coord);
+      space = this->arena.make<OpenSpace>(coord);
       break;
 
    case CLOSED_DOOR_C:
-      space = new Door(coord);
+      space = this->arena.make<Door>(coord);
       break;
 
     case WALL_C:
-      space = new Wall(coord);
+      space = ChunkMap::shared_wall();
       break;
 
     case UP_STAIR_C:
-      space = new UpStair(coord);
+      space = this->arena.make<UpStair>(coord);
       break;
 
     case DOWN_STAIR_C:
-      space = new DownStair(coord);
+      space = this->arena.make<DownStair>(coord);
       break;
     
     case HIDDEN_DOOR_C:
-      space = new SecretDoor(coord);
+      space = this->arena.make<SecretDoor>(coord);
       break;
   }
 
@@ -93,21 +177,40 @@ Space *Floor::interpret_space(char space_char, Coord coord)
 std::string Floor::render_floor()
 {
   std::string render_string = "";
-  int last_y = 0,
-      y = 0;
+  const space_chunk *chunk;
+  Space *space;
+  int width = this->spaces.get_width();
+  char glyph;
+  int last_y = 0;
 
   /*
-   *  Iterate through the map of spaces and render each character,
-   *    render a newline whenever y has changed
+   *  Render each row through the chunks it crosses, skipping blank
+   *    chunks whole, and render a newline whenever y has changed. A
+   *    monster is rendered by its glyph. Tiles are read row by row
+   *    whatever the order of a chunk's tiles.
    */
-  for(auto i = this->spaces.begin(); i != this->spaces.end(); i++){
-    y = i->second->y();
+  for(int y = 0; y < this->spaces.get_height(); y++){
+    for(int cx = 0; cx < this->spaces.get_chunks_wide(); cx++){
+      chunk = this->spaces.get_chunk(cx, y >> CHUNK_SHIFT);
+      if (ChunkMap::is_blank(chunk)) {
+        continue;
+      }
 
-    if (y != last_y){      
-      last_y = y;
-      render_string += '\n';
+      for(int x = 0; x < CHUNK_SIDE && (cx << CHUNK_SHIFT) + x < width; x++){
+        space = chunk->spaces[chunk_tile(x, y)];
+        if (space != NULL) {
+          if (y != last_y){
+            last_y = y;
+            render_string += '\n';
+          }
+          glyph = space->get_render_char();
+          if (glyph == MOB_SPACE_C) {
+            glyph = this->mobs.get_glyph(this->mobs.find(space->get_mob()));
+          }
+          render_string += glyph;
+        }
+      }
     }
-    render_string += i->second->get_render_char();
   }
   
   return render_string;
@@ -119,18 +222,58 @@ std::string Floor::render_floor()
  * Description: destructor
  * Parameters: none
  * Pre-conditions: none
- * Post-conditions: the dynamic memory encapsulated within the floor,
- *                  spaces and mob data, will be freed
+ * Post-conditions: the spaces are destroyed, and the arena then frees
+ *                  their memory, and their chunks', at once
  * Returns: none
  ************************************************************************/
 Floor::~Floor()
 {
-  for(auto i = this->spaces.begin(); i != this->spaces.end(); i++){
-    delete (i->second);
+  this->spaces.visit([](Space *space) { space->~Space(); });
+}
+
+
+/*************************************************************************
+ * Function: add_mob
+ * Description: makes a monster and puts it on the space at coord
+ * Parameters: data - the monster's data
+ *             coord - the monster's location
+ * Pre-conditions: none
+ * Post-conditions: the monster may have been made
+ * Returns: entity - the monster, or NO_ENTITY if there is no space at
+ *          coord that can hold it
+ ************************************************************************/
+entity Floor::add_mob(const mob_data *data, const Coord &coord)
+{
+  Space *space;
+  entity mob = NO_ENTITY;
+
+  if (this->boards.enterable(coord) && (space = this->find_space(coord)) != NULL) {
+    mob = this->mobs.create(data, coord);
+    space->add_mob(mob);
   }
-  for(auto i = this->mob_list.begin(); i != this->mob_list.end(); i++){
-    delete (*i);
+
+  return mob;
+}
+
+
+/*************************************************************************
+ * Function: remove_mob
+ * Description: takes a monster off its space and destroys it
+ * Parameters: mob - the monster
+ * Pre-conditions: none
+ * Post-conditions: the monster's handles are stale
+ * Returns: bool - true if the monster was on the floor
+ ************************************************************************/
+bool Floor::remove_mob(entity mob)
+{
+  uint32_t slot = this->mobs.find(mob);
+
+  if (slot != NO_SLOT) {
+    this->get_space(this->mobs.get_coord(slot))->delete_mob();
+    this->mobs.destroy(mob);
   }
+
+  return slot != NO_SLOT;
 }
 
 
@@ -146,13 +289,14 @@ Floor::~Floor()
  ************************************************************************/
 bool Floor::add_char(Character *character, const Coord &coord)
 {
-  return this->spaces[coord]->add_character(character);
+  return this->get_space(coord)->add_character(character);
 }
 
 
 /*************************************************************************
  * Function: move_char
- * Description: moves a character from one space to another
+ * Description: moves a character from one space to another, if the
+ *              bitboards show the space moved to can be entered
  * Parameters: from - the coordinate to move from
  *             to - the coordinate to move to
  * Pre-conditions: none
@@ -162,13 +306,26 @@ bool Floor::add_char(Character *character, const Coord &coord)
 bool Floor::move_char(const Coord &from, const Coord &to)
 {
   Character *character = NULL;
+  Space *from_space = this->get_space(from);
+  Space *to_space;
+  entity mob = from_space->get_mob();
   bool moved = false;
 
-  if ((this->spaces[from]->get_character() != NULL) && (this->spaces[to]->get_character() == NULL)){    
-    character = this->spaces[from]->get_character();
-    if (character != NULL &&
-        this->spaces[to]->add_character(character) &&
-        this->spaces[from]->delete_character()) {
+  if (!this->boards.enterable(to)) {
+    /* a wall, a closed door, or someone already there */
+
+  } else if (mob != NO_ENTITY) {
+    to_space = this->get_space(to);
+    if (to_space->add_mob(mob) && from_space->delete_mob()) {
+      this->mobs.set_coord(this->mobs.find(mob), to);
+      moved = true;
+    }
+
+  } else if (from_space->get_character() != NULL) {
+    to_space = this->get_space(to);
+    character = from_space->get_character();
+    if (to_space->add_character(character) &&
+        from_space->delete_character()) {
       character->set_coord(to);
       moved = true;
     }
@@ -176,3 +333,142 @@ bool Floor::move_char(const Coord &from, const Coord &to)
   
   return moved;
 }
+
+
+/*************************************************************************
+ * Function: save_state
+ * Description: writes the mutable state of the floor (opened doors, items
+ *              lying on spaces, and listed monsters with their hp and 
+ *              inventory) to a stream, one record per line, terminated
+ *              by an "end" line.
+ * Parameters: out - the stream to write to
+ * Pre-conditions: none
+ * Post-conditions: the floor state will have been written to out
+ * Returns: none
+ ************************************************************************/
+void Floor::save_state(std::ostream &out)
+{
+  this->spaces.visit([&out](Space *space) {
+    /* doors and secret doors are passable only once opened */
+    if ((space->get_kind() == TILE_DOOR || space->get_kind() == TILE_SECRET_DOOR) &&
+        space->passable()){
+      out << "open " << space->x() << ' ' << space->y() << '\n';
+    }
+
+    for(auto j = space->get_items()->begin(); j != space->get_items()->end(); j++){
+      out << "item " << space->x() << ' ' << space->y() << ' ' << (*j)->id() << '\n';
+    }
+  });
+
+  for(uint32_t i = 0; i < this->mobs.size(); i++){
+    out << "mob " << this->mobs.get_coord(i).x() << ' ' << this->mobs.get_coord(i).y() << ' ' 
+        << this->mobs.get_kind(i)->id << ' ' << this->mobs.get_hp(i) << '\n';
+
+    if (this->mobs.get_inventory(i) != NULL) {
+      for(int j = 0; j < this->mobs.get_inventory(i)->size(); j++){
+        out << "mobinv " << this->mobs.get_inventory(i)->at(j).item->id() << ' ' 
+            << this->mobs.get_inventory(i)->at(j).count << '\n';
+      }
+    }
+  }
+
+  out << "end\n";
+}
+
+
+/*************************************************************************
+ * Function: clear_state
+ * Description: removes all items lying on the floor and destroys all
+ *              monsters, leaving only the floor layout.
+ * Parameters: none
+ * Pre-conditions: none
+ * Post-conditions: the floor holds no items or monsters
+ * Returns: none
+ ************************************************************************/
+void Floor::clear_state()
+{
+  this->spaces.visit([](Space *space) { space->get_items()->clear(); });
+  this->boards.clear(BOARD_ITEMS);
+  this->boards.clear(BOARD_BLOCKING);
+
+  while (this->mobs.size() > 0) {
+    this->remove_mob(this->mobs.get_handle(this->mobs.size() - 1));
+  }
+}
+
+
+/*************************************************************************
+ * Function: restore_state
+ * Description: clears the floor and restores its mutable state from a 
+ *              stream written by save_state. Anything saved on a tile the
+ *              layout no longer has, or a monster on a tile it can no 
+ *              longer stand on, is dropped, so state can be restored onto
+ *              a changed layout.
+ * Parameters: in - the stream to read from
+ *             items - the loaded item map, for looking up item IDs
+ *             mobs - the loaded monster data, for recreating monsters
+ *
+ * Pre-conditions: the floor layout must have been loaded
+ * Post-conditions: the floor state will match the saved state
+ * Returns: bool - true if the state was read through its "end" record
+ ************************************************************************/
+bool Floor::restore_state(std::istream &in,
+                          std::map<std::string, Item *> &items,
+                          std::map<std::string, mob_data *> &mobs)
+{
+  std::string line;
+  std::stringstream line_ss;
+  std::string record;
+  std::string tgt_id;
+  int x, y, n;
+  Space *space;
+  entity mob = NO_ENTITY;
+  bool ended = false;
+
+  this->clear_state();
+
+  while(!ended && std::getline(in, line)){
+    line_ss.clear();
+    line_ss.str(line);
+    line_ss >> record;
+
+    if (record == "end"){
+      ended = true;
+
+    /* opened doors */
+    } else if (record == "open" && (line_ss >> x >> y)) {
+      space = this->find_space(Coord(x, y));
+      if (space != NULL && space->get_kind() == TILE_DOOR){
+        static_cast<Door*>(space)->open();
+      } else if (space != NULL && space->get_kind() == TILE_SECRET_DOOR){
+        static_cast<SecretDoor*>(space)->open();
+      }
+
+    /* items lying on a space */
+    } else if (record == "item" && (line_ss >> x >> y >> tgt_id)) {
+      space = this->find_space(Coord(x, y));
+      if (space != NULL && items.find(tgt_id) != items.end()){
+        space->add_item(items[tgt_id]);
+      }
+
+    /* monsters, followed by their inventory */
+    } else if (record == "mob" && (line_ss >> x >> y >> tgt_id >> n)) {
+      mob = NO_ENTITY;
+      if (mobs.find(tgt_id) != mobs.end()){
+        mob = this->add_mob(mobs[tgt_id], Coord(x, y));
+      }
+      if (mob != NO_ENTITY) {
+        this->mobs.set_hp(this->mobs.find(mob), n);
+      }
+
+    } else if (record == "mobinv" && (line_ss >> tgt_id >> n)) {
+      if (mob != NO_ENTITY && items.find(tgt_id) != items.end()){
+        for(int i = 0; i < n; i++){
+          this->mobs.add_item(this->mobs.find(mob), items[tgt_id]);
+        }
+      }
+    }
+  }
+
+  return ended;
+}
@@ -14,33 +14,50 @@
 #include <vector>
 #include <string>
 #include <fstream>
+#include <iostream>
 
 #include "Coord.hpp"
 #include "Space.hpp"
+#include "Arena.hpp"
+#include "ChunkMap.hpp"
+#include "Bitboards.hpp"
+#include "Entities.hpp"
 
 class Character;
 
 class Floor{
   private:
-    std::map<Coord, Space *> spaces;
-    std::set<Character *> mob_list;
+    Arena arena;                    /* holds the floor's spaces and chunks */
+    ChunkMap spaces;
+    Bitboards boards;               /* kept up to date by the spaces */
+    Entities mobs;
     
   public:
+    Floor();
     ~Floor();
-    Space *get_space(int x, int y) { return this->spaces[Coord(x,y)]; }
-    Space *get_space(Coord coord) { return this->spaces[coord]; }
-    void add_space(Space *space, int x, int y) 
-      { this->spaces.insert(std::pair<Coord, Space *>(Coord(x,y), space)); }
+    Space *get_space(int x, int y) { return this->spaces.get(x, y); }
+    Space *get_space(Coord coord) { return this->spaces.get(coord.x(), coord.y()); }
+    Space *find_space(const Coord &coord) { return this->spaces.get(coord.x(), coord.y()); }
 
-    void load_floor(std::string path);
+    bool load_floor(const std::string &path, std::string &error);
+    void load_grid(const char *grid, int width, int height);
     std::string render_floor();
     Space * interpret_space(char space_char, Coord coord);
     bool add_char(Character *, const Coord &coord);
     bool move_char(const Coord &from, const Coord &to);
-    void list_mob(Character *mob) { this->mob_list.insert(mob); } 
-    void unlist_mob(Character *mob) { this->mob_list.erase(this->mob_list.find(mob)); }
-    std::set<Character *> *get_mob_list() { return &(this->mob_list); }
-    std::map<Coord, Space *> *get_spaces() { return &(this->spaces); }
+    entity add_mob(const mob_data *data, const Coord &coord);
+    bool remove_mob(entity mob);
+    Entities *get_mobs() { return &(this->mobs); }
+    ChunkMap *get_spaces() { return &(this->spaces); }
+    Bitboards *get_boards() { return &(this->boards); }
+    bool passable(const Coord &coord) const { return this->boards.passable(coord); }
+
+    /* save state */
+    void save_state(std::ostream &out);
+    bool restore_state(std::istream &in, 
+                       std::map<std::string, Item *> &items,
+                       std::map<std::string, mob_data *> &mobs);
+    void clear_state();
 };
 
 #endif
@@ -12,41 +12,63 @@
  ************************************************************************/
 
 #include <ncurses.h>
-#include <typeinfo>
 #include <iomanip>
 #include <set>
+#include <list>
+#include <thread>
+#include <algorithm>
 #include "Game.hpp"
+#include "TaskGraph.hpp"
+#include "TableReader.hpp"
 #include "utils.hpp"
 
 /*************************************************************************
  * Function: Constructor 
  * Description: Loads gamedata and initializes the gamestate for play.
  * Parameters:  1) accepts a player name
+ *              2) hot_reload - development mode: the gamedata text files
+ *                 are read, and reloaded between turns when they change
+ *              3) trace_path - file to trace the game loop to, or "" 
+ *              4) dungeon - a dungeon to generate and play in place of 
+ *                 the gamedata floors, or NO_DUNGEON
  * Pre-conditions: 
  * Post-conditions:
  * Returns: none
  ************************************************************************/
-Game::Game(std::string hero_name)
+Game::Game(std::string hero_name, bool hot_reload, const std::string &trace_path,
+           const gen_params &dungeon) : 
+  autosave(SAVE_PATH, AUTOSAVE_TURNS), journal(JOURNAL_PATH), prefetcher(this), reloader(this)
 {  
-  /* open logfile for logging */
-  this->logfile.open(LOGFILE_PATH.c_str());
+  /* start the log; what is logged from here on is written out in the background */
+  this->logger.start(LOGFILE_PATH);
 
-  /* Load data */
-  this->logfile << "Loading items...\n";
-  load_items();
-  this->logfile << "Finished loading items.\n\n";
-  
-  this->logfile << "Loading mobs...\n";
-  load_mobs();
-  this->logfile << "Finished loading mobs.\n\n";
-
-  this->logfile << "Loading floors...\n";
-  load_floors();
-  this->logfile << "Finished loading floors.\n\n";  
- 
-  this->logfile << "Linking spaces...\n";
-  this->link_spaces();
-  this->logfile << "Finished linking floors.\n\n";
+  /* the trace starts before any other thread, so every thread is named in it */
+  if (!trace_path.empty()) {
+    if (this->tracer.start(trace_path)) {
+      this->tracer.name_thread("game");
+    } else {
+      this->logger.text(LEVEL_WARN, "Could not open the trace file " + trace_path);
+    }
+  }
+
+  this->hot_reload = hot_reload;
+  this->dungeon = (dungeon.floors > 0) ? Generator::clamp(dungeon) : NO_DUNGEON;
+
+  this->visit_clock = 0;
+  this->loaded_floors = 0;
+  this->quest_target_num = NO_ID;
+  this->floor_budget = FLOOR_BUDGET;
+  this->world_seed = rand();
+
+  /* 
+   * Load data, from the gamedata built into the game or the asset pack
+   * if either has been built and this is not development mode. Floors 
+   * are only indexed (or generated), apart from the starting floor; each
+   * is loaded when first needed
+   */
+  this->logger.text(LEVEL_INFO, "Loading gamedata...");
+  this->load_gamedata();
+  this->logger.text(LEVEL_INFO, "Finished loading gamedata.");
 
   /* 
    * Set initial game conditions 
@@ -54,7 +76,7 @@ Game::Game(std::string hero_name)
    *  add and equip the global constant starting equipment,
    *  set the game to in progress and the number of days passed to 0
    */
-  this->current_floor = this->floors[STARTING_MAP];
+  this->current_floor = this->get_floor(this->floor_names.find(STARTING_MAP));
   this->player.set_name(hero_name);
   this->player.set_coord(STARTING_COORD.x(), STARTING_COORD.y());
   this->player.add_item(this->items[STARTING_WPN]);
@@ -63,15 +85,21 @@ Game::Game(std::string hero_name)
   this->player.equip_item(this->items[STARTING_AMR]);
   this->current_floor->add_char(&player, STARTING_COORD);
 
-  this->quest_target = new Mob( this->mobs[QUEST_TARGET_ID], QUEST_TARGET_COORD );
-  this->floors[QUEST_TARGET_FLOOR]->add_char(quest_target, QUEST_TARGET_COORD );
-  this->floors[QUEST_TARGET_FLOOR]->list_mob(quest_target);
-
   this->in_progress = true;
   this->days_passed = 0;
+  this->changed_floor = false;
+  this->save_gen = 0;
+
+  /* nearby floors are loaded in the background from here on */
+  this->prefetcher.start();
+
+  /* in development mode, changed gamedata is reloaded between turns */
+  if (this->hot_reload && !this->reloader.start()) {
+    this->logger.text(LEVEL_WARN, "Could not watch the gamedata for changes");
+  }
 
-  this->logfile << "Game ready!\n";
-  this->logfile.close();
+  this->logger.text(LEVEL_INFO, "Game ready!");
+  this->logger.record(LEVEL_INFO, EV_GAME_START, this->world_seed);
 }
 
 
@@ -85,9 +113,14 @@ Game::Game(std::string hero_name)
  ************************************************************************/
 Game::~Game()
 {
+  /* the watcher and loader read the game data, so they stop before anything is freed */
+  this->reloader.stop();
+  this->prefetcher.stop();
+  this->tracer.stop();
+
   for( auto i = floors.begin(); i != floors.end(); i++ ) {
-    delete i->second;
-    i->second = NULL;
+    delete *i;
+    *i = NULL;
   }
   for( auto i = items.begin(); i != items.end(); i++ ) {
     delete i->second;
@@ -98,7 +131,12 @@ Game::~Game()
     i->second = NULL;
   }
 
-  this->logfile.close();
+  if (this->profiler.has_samples()) {
+    this->logger.text(LEVEL_INFO, "Turn profile:\n" + this->profiler.report());
+  }
+
+  /* the log stops last, so it has everything the other threads logged */
+  this->logger.stop();
 }
 
 
@@ -112,6 +150,16 @@ Game::~Game()
  ************************************************************************/
 void Game::read_input(int input)
 {
+  ProfileScope timing(this->profiler, PHASE_READ_INPUT);
+  TraceScope trace(this->tracer, TRACE_INPUT);
+
+  /* a new game's journal starts from a snapshot of its initial state */
+  if (!this->journal.is_open()) {
+    this->journal.discard();
+    this->journal.start(0);
+    this->take_snapshot(true);
+  }
+
   switch(input){
     case KEY_UP:
     case 'w':
@@ -152,7 +200,21 @@ void Game::read_input(int input)
     case 'Q':
       this->in_progress = false;
       break;
+
+    /* debug keys: turn profiling on or off, and report the timings so far */
+    case 'P':
+      this->profiler.set_enabled(!this->profiler.is_enabled());
+      this->messages.push_back(this->profiler.is_enabled() ? "Profiling on.\n" : "Profiling off.\n");
+      break;
+
+    case 'p':
+      this->report_profile();
+      break;
   }
+
+  this->check_reload();
+  this->prefetch_floors();
+  this->check_autosave(input == 'Q');
 }
 
 
@@ -187,30 +249,31 @@ Coord Game::coord_from_direction(const Coord &coord, const direction &dir)
 
 /*************************************************************************
  * Function:    link_spaces
- * Description: provides each space with a pointer to adjacent spaces  
- * Parameters: none
+ * Description: provides each space of a floor with a pointer to adjacent
+ *              spaces, chunk by chunk. The shared wall is linked to nothing
+ * Parameters: floor - the floor to link
  * Pre-conditions: none
  * Post-conditions: spaces 
  * Returns: none
  ************************************************************************/
-void Game::link_spaces()
+void Game::link_spaces(Floor *floor)
 {
-  std::map<Coord, Space*> *spaces;
-  direction dir;
-  Coord check_coord;
-
-  for (auto i = this->floors.begin(); i != this->floors.end(); i++){
-    spaces = i->second->get_spaces();
-    for (auto j = spaces->begin(); j != spaces->end(); j++){
-      for (int k = 0; k < 4; k++){
-        dir = static_cast<direction>(k);
-        check_coord = coord_from_direction( j->first, dir );
-        if ( spaces->find( check_coord ) != spaces->end() ){
-          j->second->link( (*spaces)[check_coord], dir );
-        }
+  ChunkMap *spaces = floor->get_spaces();
+
+  spaces->visit([this, spaces](Space *space) {
+    direction dir;
+    Coord check_coord;
+    Space *adjacent;
+
+    for (int k = 0; k < 4; k++){
+      dir = static_cast<direction>(k);
+      check_coord = coord_from_direction( space->get_coord(), dir );
+      adjacent = spaces->get( check_coord.x(), check_coord.y() );
+      if ( adjacent != NULL ){
+        space->link( adjacent, dir );
       }
     }
-  }
+  });
 }
 
 
@@ -229,16 +292,21 @@ void Game::link_spaces()
 void Game::player_rest()
 {
   std::stringstream ss;
-  if (this->current_floor->get_mob_list()->size() == 0) {
+  if (this->current_floor->get_mobs()->size() == 0) {
     this->inc_day();
+    this->player.rest();
+    this->autosave.tick();
+    ss << "r " << this->days_passed << ' ' << this->player.get_hp();
+    this->journal.record(ss.str());
+    ss.str("");
     ss << "You rest and recover health.\n"
        << "You've now been in the dungeon for " << this->days_passed 
        << " days.\n";
-    this->player.rest();
     if (this->days_passed > MAX_DAYS) {
       ss << "You've taken too long to clear the dungeon.\n";
       ss << "GAME OVER\n";
       this->in_progress = false;
+      this->logger.record(LEVEL_INFO, EV_GAME_END, this->days_passed, 0);
     }
   } else {
     ss << "You cannot rest while there are monsters nearby.\n";
@@ -265,12 +333,12 @@ void Game::player_get_items()
   /*  Get the player's space and the items present at that space. */
   Space *space = this->current_floor->get_space(player.get_coord());
   std::vector<Item*> *itm = space->get_items();
-  std::vector<std::string> removed_item_ids;
+  std::vector<int> removed_item_nums;
 
   /* 
    * If there are items, then for each item, 
    *  ask if the player wants to get the item,
-   *    then add the item to the player's inventory and record its id to remove
+   *    then add the item to the player's inventory and record its number to remove
    *    from the space
    */
   if( itm->size() > 0) {
@@ -284,7 +352,8 @@ void Game::player_get_items()
         refresh();
 
         player.add_item(*i);
-        removed_item_ids.push_back( (*i)->id() );
+        removed_item_nums.push_back( (*i)->num() );
+        this->journal.record("g " + (*i)->id());
       }
     }
 
@@ -292,7 +361,7 @@ void Game::player_get_items()
     getch();
   
     /* remove all taken items from the space */
-    for( auto i = removed_item_ids.begin(); i != removed_item_ids.end(); i++) {
+    for( auto i = removed_item_nums.begin(); i != removed_item_nums.end(); i++) {
         space->remove_item( *i );
     }
   } else {
@@ -341,7 +410,7 @@ void Game::print_player_character_sheet()
  ************************************************************************/
 void Game::manage_player_inventory()
 {
-  std::map<Item *, int> *inventory = player.get_inventory(); /* player inventory */
+  Inventory *inventory = player.get_inventory(); /* player inventory */
   char choice = ' ';
   int indx = 0;
 
@@ -411,16 +480,16 @@ void Game::manage_player_inventory()
  ************************************************************************/
 void Game::print_player_inventory()
 { 
-  std::map<Item*, int> *inventory = player.get_inventory();
+  Inventory *inventory = player.get_inventory();
   char idx = 'a'; /* a character to identify each item */
 
   printw("You are currently carrying:\n");
 
-  for( auto i = inventory->begin(); i != inventory->end(); i++ ){
+  for( int i = 0; i < inventory->size(); i++ ){
     printw("%c) ",  idx++); /* increment the identifying character */
-    printw(i->first->name().c_str()); /* print the item name */
-    if (i->second > 1) {              /* and quantity, if more than one */
-      printw("(%i)", i->second);
+    printw(inventory->at(i).item->name().c_str()); /* print the item name */
+    if (inventory->at(i).count > 1) {              /* and quantity, if more than one */
+      printw("(%i)", inventory->at(i).count);
     }
     printw("\n");
   }
@@ -438,14 +507,14 @@ void Game::print_player_inventory()
 Item* Game::get_player_inventory_selection(const char *prompt)
 {
   clear();
-  std::map<Item *, int> *inventory = player.get_inventory();
+  Inventory *inventory = player.get_inventory();
   int selection = ' ';
   Item* inventory_item = NULL;
   this->print_player_inventory();
 
   /*
    *  display a prompt, then loop to validate input.
-   *    Align character input with map "index" by adjusting by 'a'
+   *    Align character input with the inventory index by adjusting by 'a'
    */
   printw(prompt);
   while(((selection = getch() - 'a') < 0 || selection >= inventory->size()) && 
@@ -455,14 +524,9 @@ Item* Game::get_player_inventory_selection(const char *prompt)
     printw(prompt);
   }
   
-  /* 
-   *  unless cancelled, advance the map iterator to the selected item,
-   *    then return it
-   */
+  /* unless cancelled, return the selected item */
   if ( (selection + 'a') != ' ' ) { 
-    auto it = inventory->begin();
-    std::advance(it, selection);
-    inventory_item = it->first;
+    inventory_item = inventory->at(selection).item;
   }
 
   return inventory_item;
@@ -500,6 +564,7 @@ void Game::player_drop_item()
       printw("You drop the %s\n", item->name().c_str());
       player.remove_item(item);
       this->current_floor->get_space(player.get_coord())->add_item(item);
+      this->journal.record("d " + item->id());
     }
   }
 
@@ -526,8 +591,9 @@ void Game::player_equip_item()
   refresh();
 
   /* equip  if possible or display a failure message */
-  if (typeid(*item) == typeid(Armor) || typeid(*item) == typeid(Weapon)){
+  if (item->equippable()){
     player.equip_item(item);
+    this->journal.record("e " + item->id());
     printw("You equipped the %s\n", item->name().c_str());
   } else {
     printw("You can't equip that!\n");
@@ -581,46 +647,53 @@ void Game::player_examine_item()
  ************************************************************************/
 void Game::move_player(const direction &dir)
 {
+  ProfileScope timing(this->profiler, PHASE_MOVE_PLAYER);
   Coord from = this->player.get_coord();
   Coord to = coord_from_direction(from, dir);
   Space *to_space = this->current_floor->get_space(to.x(), to.y());
+  std::stringstream event;  /* stringstream to build journal records */
 
-  /* if the space is not empty, then attack the character present there */
-  if ( to_space->get_character() != NULL ) {
-      this->player_attack_mob( to_space->get_character() );
+  /* if the space is not empty, then attack the monster present there */
+  if ( to_space->get_mob() != NO_ENTITY ) {
+      this->player_attack_mob( to_space->get_mob() );
 
   /* otherwise, if there are no characters present */
   } else {
 
     /* if passable, move the player there, unless the player is encumbered */
-    if(to_space->passable()){
+    if(this->current_floor->passable(to)){
       if ( player.encumbered() ){
         this->messages.push_back("You are too encumbered to move.\n");
-      } else {
-        this->current_floor->move_char(from, to);
+      } else if (this->move_on_floor(from, to)) {
+        event << "m " << from.x() << ' ' << from.y() << ' ' << to.x() << ' ' << to.y();
+        this->journal.record(event.str());
       }
     
     /* if not passable, check for other actions */
     } else {
 
+      switch (to_space->get_kind()) {
+
       /* walls */
-      if ( typeid(*to_space) == typeid(Wall)){
+      case TILE_WALL:
         this->messages.push_back("There is a wall blocking the way...");
+        break;
 
       /* 
        * doors - check to see if locked. If not, then open. If so, then
        *  check to see if the PC holds the key. If so, open. 
        */
-      } else if ( typeid(*to_space) == typeid(Door) ) {
+      case TILE_DOOR:
         this->messages.push_back("There is a door blocking the way...");
 
         if (to_space->is_locked()){
           this->messages.push_back(" and it's locked.\n");
-          std::string key_ID = dynamic_cast<Door*>(to_space)->key_str();
+          Item *key = this->get_item(static_cast<Door*>(to_space)->get_key());
 
-          if ( this->player.has(this->items[key_ID])) {
+          if ( this->player.has(key)) {
             this->messages.push_back("You have the key, so you unlock and open the door.\n");
-            dynamic_cast<Door*>(to_space)->open();
+            static_cast<Door*>(to_space)->open();
+            event << "o " << to.x() << ' ' << to.y();
 
           } else {
             this->messages.push_back("You do not have the key.\n");
@@ -628,15 +701,26 @@ void Game::move_player(const direction &dir)
 
         } else {
           this->messages.push_back(" but it's not locked.\nYou open the door.");
-          dynamic_cast<Door*>(to_space)->open();
+          static_cast<Door*>(to_space)->open();
+          event << "o " << to.x() << ' ' << to.y();
         }
+        break;
 
       /* secrets (sshhhh) */
-      } else if ( typeid(*to_space) == typeid(SecretDoor) ){
+      case TILE_SECRET_DOOR:
         this->messages.push_back("There is a wall blocking the way...\n"
                                  "on closer inspection, you find a switch embedded in the wall.\n"
                                  "Pressing the switch reveals a secret passage.\n");
-        dynamic_cast<SecretDoor*>(to_space)->open();
+        static_cast<SecretDoor*>(to_space)->open();
+        event << "o " << to.x() << ' ' << to.y();
+        break;
+
+      default:
+        break;
+      }
+
+      if (event.str() != "") {
+        this->journal.record(event.str());
       }
     }
 
@@ -658,27 +742,50 @@ void Game::move_player(const direction &dir)
     }
 
     /* check for and traverse stairs */
-    if (typeid(*to_space) == typeid(DownStair)) {
-      this->messages.push_back("You descend the stairs to a deeper level...\n");
-      to_space->delete_character();
-      player.set_coord(dynamic_cast<Stair*>(to_space)->get_linked_coord());
-      this->current_floor = this->floors[dynamic_cast<Stair*>(to_space)->get_linked_floor_ID()];
-      this->current_floor->get_space(player.get_coord())->add_character(&player);
-
-    } else if (typeid(*to_space) == typeid(UpStair)) {
-      this->messages.push_back("You ascend the stairs to a higher level...\n");
-      to_space->delete_character();
-      player.set_coord(dynamic_cast<Stair*>(to_space)->get_linked_coord());
-      this->current_floor = this->floors[dynamic_cast<Stair*>(to_space)->get_linked_floor_ID()];
-      this->current_floor->get_space(player.get_coord())->add_character(&player);
+    if (to_space->get_kind() == TILE_DOWN_STAIR) {
+      this->take_stair(static_cast<Stair*>(to_space), "You descend the stairs to a deeper level...\n");
+    } else if (to_space->get_kind() == TILE_UP_STAIR) {
+      this->take_stair(static_cast<Stair*>(to_space), "You ascend the stairs to a higher level...\n");
     }
   }
 
   /* a movement related action triggers a mob turn */
+  this->autosave.tick();
   move_mobs();
 }
 
 
+/*************************************************************************
+ * Function: take_stair
+ * Description: moves the player up or down a stair to the stair it is
+ *              linked to, on another floor
+ * Parameters: stair - the stair the player stands on
+ *             message - the message telling the player which way
+ * Pre-conditions: the player is on the stair
+ * Post-conditions: the player is on the linked stair, and that floor is
+ *                  the current floor
+ * Returns: none
+ ************************************************************************/
+void Game::take_stair(Stair *stair, const char *message)
+{
+  TraceScope trace(this->tracer, TRACE_STAIR, stair->get_linked_floor());
+  std::stringstream event;
+
+  this->messages.push_back(message);
+  stair->delete_character();
+  player.set_coord(stair->get_linked_coord());
+  this->current_floor = this->get_floor(stair->get_linked_floor());
+  this->current_floor->get_space(player.get_coord())->add_character(&player);
+  this->changed_floor = true;
+  this->evict_floors(0);
+  this->logger.record(LEVEL_INFO, EV_FLOOR_CHANGE, stair->get_linked_floor(),
+                      player.get_coord().x(), player.get_coord().y());
+  event << "f " << this->floor_names.name(stair->get_linked_floor()) << ' '
+        << player.get_coord().x() << ' ' << player.get_coord().y();
+  this->journal.record(event.str());
+}
+
+
 /*************************************************************************
  * Function: player_attack_mob
  * Description: handles attacks from the player on monsters
@@ -689,20 +796,30 @@ void Game::move_player(const direction &dir)
  *                  character may have been awarded experience.
  * Returns: none
  ************************************************************************/
-void Game::player_attack_mob(Character *mob)
+void Game::player_attack_mob(entity mob)
 {
+  Entities *mobs = this->current_floor->get_mobs();
+  uint32_t slot = mobs->find(mob);
+  Coord mob_coord = mobs->get_coord(slot);
   std::stringstream attack_string; /* stringstream to accumulate a message */
+  std::stringstream event;         /* stringstream to build journal records */
 
   /* Describe a hit or miss. */
-  attack_string << "You attack " << mob->get_name();
+  attack_string << "You attack " << mobs->get_name(slot);
   attack_data atk = player.attack();
 
-  if(mob->defend(atk)){
+  if(mobs->defend(slot, atk)){
     attack_string << " for "
                   << atk.damage_roll
                   << " damage.\n";
+    event << "h " << mob_coord.x() << ' ' << mob_coord.y() << ' ' << mobs->get_hp(slot);
+    this->journal.record(event.str());
+    this->logger.record(LEVEL_INFO, EV_PLAYER_ATTACK, mob_coord.x(), mob_coord.y(),
+                        atk.damage_roll, mobs->get_hp(slot));
   } else {
     attack_string << " but miss.\n";
+    this->logger.record(LEVEL_INFO, EV_PLAYER_ATTACK, mob_coord.x(), mob_coord.y(),
+                        0, mobs->get_hp(slot));
   }
 
   /* push and clear the message */
@@ -712,45 +829,76 @@ void Game::player_attack_mob(Character *mob)
   /* 
    * check to see if the monster has been killed,
    *  if so, display another message, 
-   *    drop the mob's inventory into its last known location,
    *    award the PC some experience,
+   *    then drop the mob's inventory into its last known location,
    *    remove the mob from the space,
-   *    unlist it from the floor's listing,
-   *    and free the memory.
+   *    and destroy it.
    */
-  if (dynamic_cast<Mob*>(mob)->is_dead()) {
+  if (mobs->is_dead(slot)) {
     attack_string << "You have slain "
-                  << mob->get_name()
+                  << mobs->get_name(slot)
                   << '\n';
 
     this->messages.push_back(attack_string.str());
     attack_string.str("");
 
-    Space *space = this->current_floor->get_space(mob->get_coord());
-    
-    for (auto i = mob->get_inventory()->begin(); i != mob->get_inventory()->end(); i++) {
-      space->add_item(i->first);
-    }
-
-    int exp = dynamic_cast<Mob*>(mob)->get_experience();
+    int exp = mobs->get_experience(slot);
     attack_string << "You have gained " << exp << " experience!\n";
     this->messages.push_back(attack_string.str());
 
-    player.add_experience(dynamic_cast<Mob*>(mob)->get_experience());
+    player.add_experience(exp);
 
-    if ( mob == this->quest_target ) {
+    if ( mobs->get_kind(slot)->num == this->quest_target_num ) {
       this->messages.push_back("Congratulations!\n YOU WIN!\n");
       this->in_progress = false;
+      this->logger.record(LEVEL_INFO, EV_GAME_END, this->days_passed, 1);
     }
 
-    if (space->delete_character()){
-      this->current_floor->unlist_mob(mob);
-      delete mob;
-    }
+    event.str("");
+    event << "k " << mob_coord.x() << ' ' << mob_coord.y();
+    this->journal.record(event.str());
+    this->logger.record(LEVEL_INFO, EV_MOB_KILLED, mobs->get_kind(slot)->num,
+                        mob_coord.x(), mob_coord.y());
+    event.str("");
+    event << "x " << player.get_experience() << ' ' << player.get_level() << ' '
+          << player.get_max_hp() << ' ' << player.get_b_atk();
+    this->journal.record(event.str());
+
+    this->remove_mob(mob);
   }
 } 
 
 
+/*************************************************************************
+ * Function: remove_mob
+ * Description: removes a slain monster from the current floor, dropping 
+ *              its inventory into its last known location
+ * Parameters: mob - the monster to remove
+ * Pre-conditions: none
+ * Post-conditions: the monster, if it was on the current floor, will
+ *                  have been destroyed
+ * Returns: none
+ ************************************************************************/
+void Game::remove_mob(entity mob)
+{
+  Entities *mobs = this->current_floor->get_mobs();
+  uint32_t slot = mobs->find(mob);
+  Space *space;
+
+  if (slot != NO_SLOT) {
+    space = this->current_floor->get_space(mobs->get_coord(slot));
+
+    if (mobs->get_inventory(slot) != NULL) {
+      for (int i = 0; i < mobs->get_inventory(slot)->size(); i++) {
+        space->add_item(mobs->get_inventory(slot)->at(i).item);
+      }
+    }
+
+    this->current_floor->remove_mob(mob);
+  }
+}
+
+
 /*************************************************************************
  * Function: render
  * Description: renders the floor
@@ -761,6 +909,8 @@ void Game::player_attack_mob(Character *mob)
  ************************************************************************/
 std::string Game::render()
 {
+  ProfileScope timing(this->profiler, PHASE_RENDER);
+  TraceScope trace(this->tracer, TRACE_RENDER);
   std::string render_str = this->current_floor->render_floor();
   render_str += '\n';
   render_str += this->print_status_bar();
@@ -775,6 +925,24 @@ std::string Game::render()
 }
 
 
+/*************************************************************************
+ * Function: report_profile
+ * Description: shows the turn phase timings so far, and writes them to
+ *              the log
+ * Parameters: none
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: none
+ ************************************************************************/
+void Game::report_profile()
+{
+  std::string table = this->profiler.report();
+
+  this->messages.push_back(table);
+  this->logger.text(LEVEL_INFO, "Turn profile:\n" + table);
+}
+
+
 /*************************************************************************
  * Function: print_status_bar
  * Description: prints a status bar with information about the character
@@ -798,7 +966,9 @@ std::string Game::print_status_bar()
 
 /*************************************************************************
  * Function: move_mobs
- * Description: handles pathing and moving of the monsters on the current floor
+ * Description: handles pathing and moving of the monsters on the current
+ *              floor. The monsters plan their moves toward the player
+ *              together, then make them in turn.
  * Parameters: none
  * Pre-conditions: none
  * Post-conditions: The monsters may have moved or attacked. 
@@ -807,55 +977,24 @@ std::string Game::print_status_bar()
  ************************************************************************/
 void Game::move_mobs()
 {
+  ProfileScope timing(this->profiler, PHASE_MOVE_MOBS);
+  Entities *mobs = this->current_floor->get_mobs();
+  const mob_ai *ai;
+
   /* 
-   * get a listing of the monsters on the floor and 
-   *  construct two vectors of moves:
+   * each monster plans two sets of moves:
    *    1) priority moves (taking the monster closer to the player, or
    *    2) secondary moves, made only if the monster cannot advance directly to
    *       the player.
-   *  It's no dijkstra, but whoever said goblins were smart?
    */
-  std::set<Character *> *mob_list = this->current_floor->get_mob_list();
-  std::vector<direction> primary_moves;
-  std::vector<direction> secondary_moves;
-  
-  Coord player_coord = player.get_coord();
-  Coord mob_coord;
-
-  for (auto i = mob_list->begin(); i != mob_list->end(); i++){
-    mob_coord = (*i)->get_coord();
-    
-    if ( player_coord.x() < mob_coord.x() ) {
-      primary_moves.push_back(LEFT);
-      secondary_moves.push_back(RIGHT);
-    } else if ( player_coord.x() > mob_coord.x() ) {
-      primary_moves.push_back(RIGHT);
-      secondary_moves.push_back(LEFT);
-    } else {
-      secondary_moves.push_back(LEFT);
-      secondary_moves.push_back(RIGHT);
-    }
-
-    if ( player_coord.y() < mob_coord.y() ) {
-      primary_moves.push_back(UP);
-      secondary_moves.push_back(DOWN);
-    } else if ( player_coord.y() > mob_coord.y() ) {
-      primary_moves.push_back(DOWN);
-      secondary_moves.push_back(UP);
-    } else {
-      secondary_moves.push_back(UP);
-      secondary_moves.push_back(DOWN);
-    }
+  mobs->plan_moves(player.get_coord());
 
-    if ( !mob_make_moves(*i, primary_moves) ) {
-      mob_make_moves(*i, secondary_moves);
-    }
+  for (uint32_t i = 0; i < mobs->size(); i++){
+    TraceScope trace(this->tracer, TRACE_MOB_DECISION, mobs->get_kind(i)->num);
+    ai = &mobs->get_ai(i);
 
-    while( primary_moves.size() > 0 ) {
-      primary_moves.pop_back();
-    }
-    while( secondary_moves.size() > 0) {
-      secondary_moves.pop_back();
+    if ( !mob_make_moves(i, ai->primary, ai->n_primary) ) {
+      mob_make_moves(i, ai->secondary, ai->n_secondary);
     }
   }
 }
@@ -865,28 +1004,35 @@ void Game::move_mobs()
  * Function: mob_make_moves
  * Description: attempts to move the passed monster in the passed directions
  *              in random order until a move was made or all moves were tried.
- * Parameters:  1) Character *mob - the monster to move
- *              2) vector<direction> &moves - the moves to try
+ * Parameters:  1) uint32_t mob - the slot of the monster to move
+ *              2) const direction *moves - the moves to try
+ *              3) int n_moves - how many moves there are
  *            
  * Pre-conditions: none
  * Post-conditions: the monster may have been moved or may have attacked.
  * Returns: true on success (a move was made) or false on failure (no moves)
  ************************************************************************/
-bool Game::mob_make_moves(Character *mob, const std::vector<direction> &moves)
+bool Game::mob_make_moves(uint32_t mob, const direction *moves, int n_moves)
 {
+  ProfileScope timing(this->profiler, PHASE_MOB_MAKE_MOVES);
   bool moved = false;
   Coord space;
+  Coord from = this->current_floor->get_mobs()->get_coord(mob);
+  std::stringstream event;  /* stringstream to build journal records */
 
-  if (moves.size() != 0){
-    int i = rand() % moves.size(),
+  if (n_moves != 0){
+    int i = rand() % n_moves,
         j = 0;
     
-    while ( j < moves.size() && !moved ) {
-      space = coord_from_direction(mob->get_coord(), moves.at((i+j) % moves.size()));
+    while ( j < n_moves && !moved ) {
+      space = coord_from_direction(from, moves[(i+j) % n_moves]);
       if (player.get_coord() == space){
         mob_attack_player(mob);
         moved = true;
-      } else if ( this->current_floor->move_char(mob->get_coord(), space )) { 
+      } else if ( this->move_on_floor(from, space )) { 
+        event << "m " << from.x() << ' ' << from.y() << ' ' << space.x() << ' ' << space.y();
+        this->journal.record(event.str());
+        LOG_DEBUG(this->logger, EV_MOB_MOVE, from.x(), from.y(), space.x(), space.y());
         moved = true;
       }
       j++;
@@ -900,13 +1046,14 @@ bool Game::mob_make_moves(Character *mob, const std::vector<direction> &moves)
 /*************************************************************************
  * Function: mob_attack_player
  * Description: handles attacks of monsters on the player character
- * Parameters: mob - the attacking monster
+ * Parameters: mob - the slot of the attacking monster
  * Pre-conditions: none
  * Post-conditions: the player's hp may have been adjusted and may be dead.
  * Returns: true, if hit. False, if missed.
  ************************************************************************/
-bool Game::mob_attack_player(Character *mob)
+bool Game::mob_attack_player(uint32_t mob)
 {
+  Entities *mobs = this->current_floor->get_mobs();
   bool hit = false;
 
   /* 
@@ -919,14 +1066,22 @@ bool Game::mob_attack_player(Character *mob)
    */
   if (!player.is_dead()){     
     std::stringstream ss;
-    ss << mob->get_name() << " attacks you ";
+    std::stringstream event;  /* stringstream to build journal records */
+    ss << mobs->get_name(mob) << " attacks you ";
 
-    attack_data atk = mob->attack();
+    attack_data atk = mobs->attack(mob);
     if ( player.defend(atk) )  {
       ss << "and hits for " << atk.damage_roll << " damage.\n";
       hit = true;
+      this->logger.record(LEVEL_INFO, EV_MOB_ATTACK, mobs->get_kind(mob)->num,
+                          atk.damage_roll, player.get_hp());
+      event << "h " << player.get_coord().x() << ' ' << player.get_coord().y() 
+            << ' ' << player.get_hp();
+      this->journal.record(event.str());
     } else {
       ss << "but it misses.\n";
+      this->logger.record(LEVEL_INFO, EV_MOB_ATTACK, mobs->get_kind(mob)->num,
+                          0, player.get_hp());
     }
 
     this->messages.push_back(ss.str());
@@ -935,6 +1090,7 @@ bool Game::mob_attack_player(Character *mob)
       player.set_hp(0);
       this->messages.push_back("You have died!\n");
       this->in_progress = false;
+      this->logger.record(LEVEL_INFO, EV_GAME_END, this->days_passed, 0);
     }
   }
 
@@ -943,269 +1099,1736 @@ bool Game::mob_attack_player(Character *mob)
 
 
 /*************************************************************************
- * Function: load_floors
- * Description: loads the floor data
+ * Function: move_on_floor
+ * Description: moves a character on the current floor, timing the move
+ *              when profiling
+ * Parameters: from - the character's space
+ *             to - the space to move it to
+ * Pre-conditions: none
+ * Post-conditions: the character may have been moved
+ * Returns: bool - true if the character was moved
+ ************************************************************************/
+bool Game::move_on_floor(const Coord &from, const Coord &to)
+{
+  ProfileScope timing(this->profiler, PHASE_MOVE_CHAR);
+
+  return this->current_floor->move_char(from, to);
+}
+
+
+/*************************************************************************
+ * Function: load_gamedata
+ * Description: loads the item and monster data, indexes the floors and 
+ *              loads the starting floor, as a graph of tasks run on a 
+ *              pool of threads. Each item table, loot table and floor
+ *              index entry is read by its own task into its own container,
+ *              and merge tasks then fill the game's maps. The starting 
+ *              floor's layout is read and linked alongside the tables; 
+ *              only the placing of its items and monsters waits for them.
+ *              Each task logs to its own stream, and the logs are written
+ *              out in order once every task has finished.
  * Parameters: none
- * Pre-conditions: item data and monster data must have been loaded first
- * Post-conditions: the floor data will have been loaded
+ * Pre-conditions: the world seed must have been set
+ * Post-conditions: the gamedata is loaded, the floors are indexed and the
+ *                  starting floor is loaded
  * Returns: none
  ************************************************************************/
-void Game::load_floors()
+void Game::load_gamedata()
 {
-  std::stringstream map_path_ss;  /* map path */
-  std::stringstream data_path_ss; /* map data path */
-  std::ifstream map_data_file;    /* map data file stream */
-  std::string map_id;             /* map_id value */
-  Space *space;                   /* space variable for interacting with spaces during load */
-  std::string data_object;        /* string to hold object type */
-  std::string tgt_id;             /* string to hold target (monster, item, weapon, etc) ID */
-  int obj_x, obj_y,               /* Coordinate variables... */
-      coord_x, coord_y; 
-  std::string line;               /* string to hold input lines streamed */
-  std::stringstream line_ss;      /* stringstream to stream from individual lines */
-  Floor *new_floor;               /* temp new floor variable, holds prior to insertion */
+  TaskGraph loader;
+  std::list<std::ostringstream> logs;           /* one log per task */
+  std::ostringstream *log;
+  std::map<std::string, Item*> item_parts[3];   /* each item table's items */
+  std::vector<mob_data*> mob_list;              /* monsters, without loot */
+  std::vector<std::string> loot_files;          /* loot table file names */
+  std::vector<std::vector<std::pair<std::string, int>>> loot_parts; /* each loot table */
+  std::vector<std::string> floor_IDs;           /* each floor file's floor ID */
+  gen_content content;                          /* what a generated dungeon holds */
+  std::vector<int> deps;
+  int items_task, mobs_task, content_task, index_task, layout_task;
+  int floor_count = 0;
+  Floor *start = NULL;
+  bool packed = !this->hot_reload && (this->pack.open_embedded() || this->pack.open(PACK_PATH));
+
+  if (packed) {
+    logs.emplace_back();
+    log = &logs.back();
+    items_task = mobs_task = loader.add([this, log]() {
+      *log << "\tLoading asset pack\n";
+      this->load_pack();
+      this->intern_items();
+      this->intern_mobs();
+    }, deps);
 
-  /*
-   *  Initialize the map number to 1 and increment while looping through all existing files,
-   *  in the map path root following the naming convention "floor_XX.mp/.dat"
-   *
-   *  Parse each pair into a Floor object, made up of spaces, containing monsters and items.
-   */
-  int map_num = 1;
-  map_path_ss   << MAP_PATH_ROOT << "floor_" << map_num << ".mp";
-  data_path_ss  << MAP_PATH_ROOT << "floor_" << map_num << ".dat";
-
-  while(file_exists(map_path_ss.str().c_str()) && file_exists(data_path_ss.str().c_str())){
- 
-    /* make a new Floor, load the floor layout into it, then open the datafile and begin parsing */
-    new_floor = new Floor;
-    new_floor->load_floor(map_path_ss.str().c_str()); 
-    map_data_file.open(data_path_ss.str().c_str());
-    map_data_file >> map_id;    
-    std::getline(map_data_file, line);
-    
-    this->logfile << "\tLoading \"" << map_id << "\"\n";
+  } else {
+    /* items, one task per table */
+    logs.emplace_back();
+    log = &logs.back();
+    deps.push_back(loader.add([this, &item_parts, log]() { 
+      this->load_generic_items(item_parts[0], *log); 
+    }, std::vector<int>()));
+    logs.emplace_back();
+    log = &logs.back();
+    deps.push_back(loader.add([this, &item_parts, log]() { 
+      this->load_weapons(item_parts[1], *log); 
+    }, std::vector<int>()));
+    logs.emplace_back();
+    log = &logs.back();
+    deps.push_back(loader.add([this, &item_parts, log]() { 
+      this->load_armor(item_parts[2], *log); 
+    }, std::vector<int>()));
+
+    items_task = loader.add([this, &item_parts]() {
+      for (int i = 0; i < 3; i++) {
+        this->items.insert(item_parts[i].begin(), item_parts[i].end());
+      }
+      this->intern_items();
+    }, deps);
+
+    /* monsters, with one task for the monster table and one per loot table */
+    list_files(MOB_LOOT_DIR.c_str(), ".tbl", loot_files);
+    loot_parts.resize(loot_files.size());
+    deps.clear();
+
+    logs.emplace_back();
+    log = &logs.back();
+    deps.push_back(loader.add([this, &mob_list, log]() { 
+      this->load_mobs(mob_list, *log); 
+    }, std::vector<int>()));
+
+    for (size_t i = 0; i < loot_files.size(); i++) {
+      logs.emplace_back();
+      log = &logs.back();
+      deps.push_back(loader.add([this, &loot_files, &loot_parts, i, log]() {
+        this->load_loot(loot_files[i], loot_parts[i], *log);
+      }, std::vector<int>()));
+    }
 
-    /* 
-     * while there are entries in the data file, 
-     *  read the associated object identifier and coordinate location
-     *  then branch based on type
-     */
-    while(std::getline(map_data_file, line)){
-      line_ss.clear();
-      line_ss.str(line);
-      line_ss >> data_object >> obj_x >> obj_y;
-      space = new_floor->get_space(obj_x, obj_y);
-      
-      /* doors. If they have an entry, they're locked */
-      if (data_object == "door") {
-        if (line_ss >> tgt_id) {
-          dynamic_cast<Door*>( space )->set_key( tgt_id );
+    logs.emplace_back();
+    log = &logs.back();
+    mobs_task = loader.add([this, &mob_list, &loot_files, &loot_parts, log]() {
+      for (auto i = mob_list.begin(); i != mob_list.end(); i++) {
+        auto loot = std::lower_bound(loot_files.begin(), loot_files.end(), (*i)->id + ".tbl");
+        if (loot != loot_files.end() && *loot == (*i)->id + ".tbl") {
+          (*i)->loot = loot_parts[loot - loot_files.begin()];
         }
-      
-      /* stairs, linked to another stair on another floor  */
-      } else if (data_object == "stair") {
-        line_ss >> tgt_id >> coord_x >> coord_y;
-        dynamic_cast<Stair*>( space )->set_linked_floor_ID( tgt_id );
-        dynamic_cast<Stair*>( space )->set_linked_coord(Coord(coord_x, coord_y));
-
-      /* items from the loaded item map */
-      } else if (data_object == "item") {
-        line_ss >> tgt_id;
-        space->add_item( this->items[tgt_id] );        
+        *log << "\tLoaded mob, " << (*i)->id << '\n';
+        this->mobs.insert(std::pair<std::string, mob_data*>((*i)->id, *i));
+      }
+      this->intern_mobs();
+    }, deps);
+  }
 
-      /* monsters from  the loaded monster data map */
-      } else if (data_object == "mob") {
+  /* 
+   * a generated dungeon takes the place of the gamedata floors. It is
+   * populated from the loaded items and monsters, one task per floor, and
+   * each floor's grid is kept packed, to be unpacked when it is built
+   */
+  if (this->dungeon.floors > 0) {
+    deps.clear();
+    deps.push_back(items_task);
+    deps.push_back(mobs_task);
+    content_task = loader.add([this, &content]() { this->gather_content(content); }, deps);
+
+    this->generated_floors.resize(this->dungeon.floors);
+    this->generated_grids.resize(this->dungeon.floors);
+    deps.clear();
+    for (int i = 0; i < this->dungeon.floors; i++) {
+      deps.push_back(loader.add([this, &content, i]() {
+        gen_floor *floor = &this->generated_floors[i];
+        Generator(this->dungeon, content).generate(i, *floor);
+        pack_grid(floor->glyphs, this->generated_grids[i]);
+        std::vector<char>().swap(floor->glyphs);
+      }, std::vector<int>(1, content_task)));
+    }
 
-        line_ss >> tgt_id;
-        this->logfile << "\tread " << tgt_id << " -> " << mobs[tgt_id]->name << '\n';
+    logs.emplace_back();
+    log = &logs.back();
+    index_task = loader.add([this, log]() {
+      floor_source source;
+      for (size_t i = 0; i < this->generated_floors.size(); i++) {
+        source.map_num = 0;
+        source.pack_index = -1;
+        source.gen_index = i;
+        this->add_floor(this->generated_floors[i].id, source);
+      }
+      *log << "\tGenerated " << this->dungeon.floors << " floors of " << this->dungeon.width 
+           << 'x' << this->dungeon.height << " from seed " << this->dungeon.seed << '\n';
+    }, deps);
 
-        Character *mob = new Mob(this->mobs[tgt_id], Coord(obj_x, obj_y));
-        std::vector<std::pair<std::string, int>> *loot_table;
-        loot_table = &(this->mobs[tgt_id]->loot);
+  } else if (packed) {
+    index_task = loader.add([this]() { this->index_pack_floors(); }, std::vector<int>());
 
-        /* determine monster inventory based on the loaded loot table entry for the mob (by ID) */
-        for (auto i = loot_table->begin(); i != loot_table->end(); i++){
-          if ((rand() % 100 + 1) <= i->second){
-            this->logfile << "\t\tgiving " << tgt_id << " " << i->first << '\n';            
-            mob->add_item(this->items[i->first]);
-          }
-        }
+  } else {
+    /* 
+     * floors, with one index task per file following the naming 
+     * convention "floor_XX.mp/.dat" in the map path root
+     */
+    while (file_exists(this->floor_path(floor_count + 1, ".mp").c_str()) &&
+           file_exists(this->floor_path(floor_count + 1, ".dat").c_str())) {
+      floor_count++;
+    }
+    floor_IDs.resize(floor_count);
+    deps.clear();
 
-        /* list the monster on its floor and add it to the correct space */
-        new_floor->list_mob(mob);
-        space->add_character(mob);
-      }
+    for (int i = 0; i < floor_count; i++) {
+      deps.push_back(loader.add([this, &floor_IDs, i]() { 
+        this->index_floor(i + 1, floor_IDs[i]); 
+      }, std::vector<int>()));
     }
 
-    /* inser the floor into the map for lookups based on ID and safekeeping until freeing */
-    this->floors.insert(std::pair<std::string, Floor*>(map_id, new_floor));
-    
-    /*
-     * Close the open data file prior to opening the next,
-     * increment the map number, clear both path stringstreams, and load the next paths
-     */
-    map_data_file.close();
-    map_num++;
-    map_path_ss.str("");
-    data_path_ss.str("");
-    map_path_ss   << MAP_PATH_ROOT << "floor_" << map_num << ".mp";
-    data_path_ss  << MAP_PATH_ROOT << "floor_" << map_num << ".dat";
-  }    
+    logs.emplace_back();
+    log = &logs.back();
+    index_task = loader.add([this, &floor_IDs, log]() {
+      floor_source source;
+      for (size_t i = 0; i < floor_IDs.size(); i++) {
+        source.map_num = i + 1;
+        source.pack_index = -1;
+        source.gen_index = -1;
+        this->add_floor(floor_IDs[i], source);
+        *log << "\tIndexed \"" << floor_IDs[i] << "\"\n";
+      }
+    }, deps);
+  }
+
+  /* the starting floor; its layout needs only the index */
+  logs.emplace_back();
+  log = &logs.back();
+  layout_task = loader.add([this, &start, log]() {
+    start = this->build_layout(this->floor_names.find(STARTING_MAP), *log);
+    this->link_spaces(start);
+  }, std::vector<int>(1, index_task));
+
+  logs.emplace_back();
+  log = &logs.back();
+  deps.clear();
+  deps.push_back(layout_task);
+  deps.push_back(items_task);
+  deps.push_back(mobs_task);
+  loader.add([this, &start, log]() {
+    this->load_floor_objects(start, this->floor_names.find(STARTING_MAP), true, *log);
+  }, deps);
+
+  loader.run(std::max(1, static_cast<int>(std::thread::hardware_concurrency())));
+
+  for (auto i = logs.begin(); i != logs.end(); i++) {
+    if (!i->str().empty()) {
+      this->logger.text(LEVEL_INFO, i->str());
+    }
+  }
+  this->adopt_floor(this->floor_names.find(STARTING_MAP), start);
 }
 
 
 /*************************************************************************
- * Function: load items
- * Description: loads item data from a table into a map, using item ID as
- *              a key. 
+ * Function: index_pack_floors
+ * Description: records where every floor in the asset pack can be loaded
+ *              from, by floor ID, without loading any of them
  * Parameters: none
+ * Pre-conditions: the pack must be open
+ * Post-conditions: the floor index will have been built
+ * Returns: none
+ ************************************************************************/
+void Game::index_pack_floors()
+{
+  floor_source source;            /* where the floor is loaded from */
+
+  for (uint32_t i = 0; i < this->pack.floor_count(); i++) {
+    source.map_num = 0;
+    source.pack_index = i;
+    source.gen_index = -1;
+    this->add_floor(this->pack.string(this->pack.floors()[i].id), source);
+  }
+}
+
+
+/*************************************************************************
+ * Function: index_floor
+ * Description: reads the floor ID at the top of a floor_N.dat file
+ * Parameters: map_num - the N of the file
+ *             floor_ID - set to the floor ID
  * Pre-conditions: none
- * Post-conditions: item data is loaded into Game::items
+ * Post-conditions: none
  * Returns: none
  ************************************************************************/
-void Game::load_items()
+void Game::index_floor(int map_num, std::string &floor_ID)
 {
-  std::ifstream item_table(ITEM_TBL_PATH.c_str());  /* input file stream for item data */
-  std::string item_ID,          /* a string to hold the item ID  */
-              item_name,        /* a string to hold the item name */
-              item_desc,        /* a string to hold the item description */
-              line;             /* a string to hold line by line input */
-  std::stringstream line_ss;    /* stringstream to stream line by line   */ 
-  double item_weight,           /* doubles to hold item weight and value */
-         item_value;
+  TableReader map_data_file;
+  slice id;
 
-  int i;  /* an integer to use as an index value for custom parser location */
+  if (map_data_file.open(this->floor_path(map_num, ".dat")) && 
+      map_data_file.next_record() && map_data_file.read_word(id)) {
+    floor_ID = id.str();
+  }
+}
 
 
-  /*
-   *  Loop through all lines in the item table,
-   *    load each item's information, 
-   *      log the item, 
-   *        and insert the item into the Game::items map
-   *    Repeat for weapon class and armor class items
-   */
+/*************************************************************************
+ * Function: gather_content
+ * Description: gathers what a generated dungeon is populated with from 
+ *              the game's loaded data
+ * Parameters: content - set to the content
+ * Pre-conditions: item data and monster data must have been loaded first
+ * Post-conditions: none
+ * Returns: none
+ ************************************************************************/
+void Game::gather_content(gen_content &content)
+{
+  gather_content(this->items, this->mobs, content);
+}
 
-  /* generic items */
-  while( std::getline(item_table, line) ){
-    i = 0;
 
-    item_ID = str_parse_string(line, i);
-    item_name = str_parse_string(line, i);
-    item_desc = str_parse_string(line, i);
-    item_weight = str_parse_double(line, i);
-    item_value = str_parse_double(line, i);     
+/*************************************************************************
+ * Function: gather_content
+ * Description: gathers what a generated dungeon is populated with from 
+ *              loaded data: every monster but the quest target, the
+ *              weakest first; the quest target, as the boss; every item 
+ *              a monster can drop; and every key. Shared by the game and
+ *              vr_dungeon, so both populate a seed's dungeon alike
+ * Parameters: items - the loaded items, by item ID
+ *             mobs - the loaded monsters, with their loot, by monster ID
+ *             content - set to the content
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: none
+ ************************************************************************/
+void Game::gather_content(const std::map<std::string, Item*> &items,
+                          const std::map<std::string, mob_data*> &mobs, gen_content &content)
+{
+  std::vector<std::pair<double, std::string>> ranked;   /* challenge rating and ID */
+  std::set<std::string> loot;
 
-    this->logfile << "\tLoading generic item, " << item_ID << '\n';
-    this->items.insert(std::pair<std::string, Item*>
-      (item_ID, new Item(item_ID, item_name, item_desc, item_weight, item_value)));  
+  for (auto i = mobs.begin(); i != mobs.end(); i++) {
+    if (i->first == QUEST_TARGET_ID) {
+      content.boss = i->first;
+    } else {
+      ranked.push_back(std::pair<double, std::string>(i->second->cr, i->first));
+    }
+    for (auto j = i->second->loot.begin(); j != i->second->loot.end(); j++) {
+      loot.insert(j->first);
+    }
   }
+  std::stable_sort(ranked.begin(), ranked.end());
+  for (auto i = ranked.begin(); i != ranked.end(); i++) {
+    content.mobs.push_back(i->second);
+  }
+  content.loot.assign(loot.begin(), loot.end());
 
-  item_table.close();
-  
-  int damage_die_n,
-      damage_die_sides,
-      damage_die_mod;
+  for (auto i = items.begin(); i != items.end(); i++) {
+    if (i->first.compare(0, GEN_KEY_PREFIX.size(), GEN_KEY_PREFIX) == 0) {
+      content.keys.push_back(i->first);
+    }
+  }
+}
 
-  item_table.open(WPN_TBL_PATH.c_str());
-
-  /* weapon class items */
-  while( std::getline(item_table, line) ) {
-    i = 0;
-    item_ID = str_parse_string(line, i);
-    item_name = str_parse_string(line, i);
-    item_desc = str_parse_string(line, i);
-    item_weight = str_parse_double(line, i);
-    item_value = str_parse_double(line, i);
-
-    damage_die_n = int(str_parse_double(line, i));
-    damage_die_sides = int(str_parse_double(line, i));
-    damage_die_mod = int(str_parse_double(line, i));
-    this->logfile << "\tLoading weapon, " << item_ID << '\n';
-    this->items.insert(std::pair<std::string, Item*>(item_ID, 
-    new Weapon( item_ID, 
-                item_name, 
-                item_desc, 
-                item_weight, 
-                item_value, 
-                damage_die_n, 
-                damage_die_sides, 
-                damage_die_mod)));  
-  }
-
-  item_table.close();
-  
-  item_table.open(AMR_TBL_PATH);
 
-  int ac;
-  
-  /* armor class items */
-  while( std::getline(item_table, line) ) {
-    i = 0;
-    item_ID = str_parse_string(line, i);
-    item_name = str_parse_string(line, i);
-    item_desc = str_parse_string(line, i);
-    item_weight = str_parse_double(line, i);
-    item_value = str_parse_double(line, i);  
-    ac = int(str_parse_double(line, i));
-    this->logfile << "\tLoading armor, " << item_ID << '\n';
-    this->items.insert(std::pair<std::string, Item*>
-    (item_ID, new Armor(item_ID, item_name, item_desc, item_weight, item_value, ac)));  
-  }
-  item_table.close();  
+/*************************************************************************
+ * Function: add_floor
+ * Description: numbers a floor and records where it can be loaded from.
+ *              The floor tables grow to hold the new floor, unloaded.
+ * Parameters: floor_ID - the ID of the floor
+ *             source - where the floor is loaded from
+ * Pre-conditions: no floor is loaded
+ * Post-conditions: the floor is in the index
+ * Returns: int - the floor's number
+ ************************************************************************/
+int Game::add_floor(const std::string &floor_ID, const floor_source &source)
+{
+  int floor_num = this->floor_names.intern(floor_ID);
+
+  this->floor_sources.resize(this->floor_names.size());
+  this->floors.resize(this->floor_names.size(), NULL);
+  this->dormant_floors.resize(this->floor_names.size());
+  this->floor_visits.resize(this->floor_names.size(), 0);
+  this->floor_sources[floor_num] = source;
+
+  return floor_num;
 }
 
 
 /*************************************************************************
- * Function: load mobs
- * Description: load the monster information into a map of structs holding
- *              the initialization information for monsters of a particular
- *              type, keyed by a unique string ID.
+ * Function: intern_items
+ * Description: numbers every loaded item, so that spaces, doors and the 
+ *              player can refer to items by number during play
  * Parameters: none
- * Pre-conditions: none
- * Post-conditions: the monster data is loaded into a map
+ * Pre-conditions: the item data must have been loaded
+ * Post-conditions: every item has its number, and the item table holds
+ *                  every item at its number
  * Returns: none
  ************************************************************************/
-void Game::load_mobs()
+void Game::intern_items()
 {
-  std::ifstream mob_table(MOB_TBL.c_str());
-  std::ifstream mob_loot_table;
-  std::string line;
-  int i;
-  std::string loot_id;
-  int loot_chance;
-  mob_data *data;
+  for (auto i = this->items.begin(); i != this->items.end(); i++) {
+    i->second->set_num(this->item_names.intern(i->first));
+    this->item_table.push_back(i->second);
+  }
+}
 
-  while(std::getline(mob_table, line)) {
-    i = 0;
 
-    data = new mob_data;
+/*************************************************************************
+ * Function: intern_mobs
+ * Description: numbers every loaded monster type, and finds the number of
+ *              the quest target
+ * Parameters: none
+ * Pre-conditions: the monster data must have been loaded
+ * Post-conditions: every monster type has its number, and the monster
+ *                  table holds every monster type at its number
+ * Returns: none
+ ************************************************************************/
+void Game::intern_mobs()
+{
+  for (auto i = this->mobs.begin(); i != this->mobs.end(); i++) {
+    i->second->num = this->mob_names.intern(i->first);
+    this->mob_table.push_back(i->second);
+  }
+  this->quest_target_num = this->mob_names.find(QUEST_TARGET_ID);
+}
+
+
+/*************************************************************************
+ * Function: get_item
+ * Description: returns an item by its number
+ * Parameters: item_num - the item number
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: Item * - the item, or NULL if there is no such item
+ ************************************************************************/
+Item *Game::get_item(int item_num)
+{
+  Item *item = NULL;
 
-    data->id   = str_parse_string(line, i);
-    data->name = str_parse_string(line, i);
-    data->render_char = str_parse_string(line, i)[0];
-    data->ac = static_cast<int>(str_parse_double(line, i));
-    data->hp = static_cast<int>(str_parse_double(line, i));
-    data->die_n = static_cast<int>(str_parse_double(line, i));
-    data->die_s = static_cast<int>(str_parse_double(line, i));
-    data->die_m = static_cast<int>(str_parse_double(line, i));
-    data->b_atk = static_cast<int>(str_parse_double(line, i));
-    data->cr = str_parse_double(line, i);
-
-    this->logfile << "\tCreating loot table for " << data->id << '\n';
-    mob_loot_table.open((MOB_LOOT_DIR + data->id + std::string(".tbl")).c_str());
-    while(std::getline(mob_loot_table, line)){
-      i = 0;
-      loot_id = str_parse_string(line, i);
-      loot_chance = static_cast<int>(str_parse_double(line, i));
-      data->loot.push_back(std::pair<std::string, int>(loot_id, loot_chance));
-      this->logfile << "\t\tAdded " << loot_id << " with chance " << loot_chance << '\n';
+  if (item_num >= 0 && item_num < static_cast<int>(this->item_table.size())) {
+    item = this->item_table[item_num];
+  }
+
+  return item;
+}
+
+
+/*************************************************************************
+ * Function: floor_path
+ * Description: returns the path of a floor's text gamedata file
+ * Parameters: map_num - the N of floor_N
+ *             extension - ".mp" for the layout, ".dat" for the data
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: std::string - the path
+ ************************************************************************/
+std::string Game::floor_path(int map_num, const std::string &extension)
+{
+  std::stringstream path_ss;
+
+  path_ss << MAP_PATH_ROOT << "floor_" << map_num << extension;
+
+  return path_ss.str();
+}
+
+
+/*************************************************************************
+ * Function: get_floor
+ * Description: returns a floor, loading it first if it is not loaded. A
+ *              floor being prefetched is waited for rather than loaded
+ *              twice.
+ * Parameters: floor_num - the number of the floor
+ * Pre-conditions: none
+ * Post-conditions: the floor is loaded and marked as just visited
+ * Returns: Floor * - the floor, or NULL if there is no such floor
+ ************************************************************************/
+Floor *Game::get_floor(int floor_num)
+{
+  Floor *floor = NULL;
+  int ready_num;                  /* number of the prefetched floor */
+  std::ostringstream log;         /* load messages */
+
+  if (floor_num >= 0 && floor_num < this->floor_names.size()) {
+    floor = this->floors[floor_num];
+
+    if (floor == NULL && this->prefetcher.is_pending(floor_num)) {
+      floor = this->prefetcher.wait(ready_num);
+      this->adopt_floor(floor_num, floor);
+
+    } else if (floor == NULL) {
+      floor = this->assemble_floor(floor_num, 
+                                   this->dormant_floors[floor_num].unpack(this->item_names,
+                                                                          this->mob_names),
+                                   log);
+      this->adopt_floor(floor_num, floor);
+      if (!log.str().empty()) {
+        this->logger.text(LEVEL_INFO, log.str());
+      }
     }
 
-    this->logfile << "\tLoaded mob, " << data->id << '\n';
-    this->mobs.insert(std::pair<std::string, mob_data*>(data->id, data));
-    mob_loot_table.close();
+    this->floor_visits[floor_num] = ++(this->visit_clock);
+  }
+
+  return floor;
+}
+
+
+/*************************************************************************
+ * Function: assemble_floor
+ * Description: builds and links a floor. A floor that was evicted is 
+ *              built with its saved state; any other floor is populated
+ *              from its data. Also called on the prefetcher's loader 
+ *              thread: it only reads game data that does not change 
+ *              during play, and writes nothing but the new floor.
+ * Parameters: floor_num - the number of the floor
+ *             state - the floor's dormant state, or "" to populate it
+ *             log - stream for load messages
+ * Pre-conditions: the floor must be in the index
+ * Post-conditions: none
+ * Returns: Floor * - the new floor, not yet added to the loaded floors
+ ************************************************************************/
+Floor *Game::assemble_floor(int floor_num, const std::string &state, std::ostream &log)
+{
+  TraceScope trace(this->tracer, TRACE_FLOOR_LOAD, floor_num);
+  Floor *floor = this->build_layout(floor_num, log);
+  this->link_spaces(floor);
+  this->load_floor_objects(floor, floor_num, state.empty(), log);
+
+  if (!state.empty()) {
+    std::stringstream state_ss(state);
+    floor->restore_state(state_ss, this->items, this->mobs);
   }
 
-  mob_table.close();
+  this->logger.record(LEVEL_INFO, EV_FLOOR_LOAD, floor_num, !state.empty());
+
+  return floor;
+}
+
+
+/*************************************************************************
+ * Function: adopt_floor
+ * Description: adds a newly built floor to the loaded floors
+ * Parameters: floor_num - the number of the floor
+ *             floor - the floor
+ * Pre-conditions: the floor must not already be loaded
+ * Post-conditions: the floor is loaded, and its dormant state is dropped
+ * Returns: none
+ ************************************************************************/
+void Game::adopt_floor(int floor_num, Floor *floor)
+{
+  this->dormant_floors[floor_num].clear();
+  this->floors[floor_num] = floor;
+  this->floor_visits[floor_num] = ++(this->visit_clock);
+  this->loaded_floors++;
 }
+
+
+/*************************************************************************
+ * Function: prefetch_floors
+ * Description: called once a turn. Adopts a floor the prefetcher has
+ *              finished, then, if the prefetcher is idle, asks it to load
+ *              the floor behind the first stair within PREFETCH_RANGE of
+ *              the player whose floor is not loaded yet.
+ * Parameters: none
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: none
+ ************************************************************************/
+void Game::prefetch_floors()
+{
+  Space *space;
+  int ready_num;                  /* number of the prefetched floor */
+  int floor_num;                  /* number of a nearby stair's floor */
+  Coord here = this->player.get_coord();
+  Floor *ready = this->prefetcher.collect(ready_num);
+  bool requested = false;
+
+  if (ready != NULL) {
+    if (this->floors[ready_num] == NULL) {
+      this->adopt_floor(ready_num, ready);
+    } else {
+      delete ready;
+    }
+  }
+
+  for (int dy = -PREFETCH_RANGE; dy <= PREFETCH_RANGE && !requested && 
+       !this->prefetcher.is_busy(); dy++) {
+    for (int dx = -PREFETCH_RANGE; dx <= PREFETCH_RANGE && !requested; dx++) {
+      space = this->current_floor->find_space(Coord(here.x() + dx, here.y() + dy));
+
+      if (space != NULL && space->is_stair()) {
+        floor_num = static_cast<Stair*>(space)->get_linked_floor();
+
+        if (floor_num != NO_ID && this->floors[floor_num] == NULL) {
+          /* make room for it now, so it is not evicted as soon as it arrives */
+          this->evict_floors(1);
+          requested = this->prefetcher.request(floor_num, 
+                        this->dormant_floors[floor_num].unpack(this->item_names, this->mob_names));
+        }
+      }
+    }
+  }
+}
+
+
+/*************************************************************************
+ * Function: build_layout
+ * Description: builds a floor's spaces from its generated grid, the asset
+ *              pack or its .mp file, without anything placed on them
+ * Parameters: floor_num - the number of the floor
+ *             log - stream for load messages
+ * Pre-conditions: the floor must be in the index
+ * Post-conditions: none
+ * Returns: Floor * - the new floor, with no spaces if its layout could 
+ *          not be loaded
+ ************************************************************************/
+Floor *Game::build_layout(int floor_num, std::ostream &log)
+{
+  floor_source source = this->floor_sources[floor_num];
+  Floor *new_floor = new Floor;   /* the floor being built */
+
+  if (source.gen_index >= 0) {
+    const gen_floor *floor = &this->generated_floors[source.gen_index];
+    std::vector<char> glyphs;
+    unpack_grid(this->generated_grids[source.gen_index], floor->width * floor->height, glyphs);
+    new_floor->load_grid(glyphs.data(), floor->width, floor->height);
+
+  } else if (source.pack_index >= 0) {
+    const pack_floor *floor = &this->pack.floors()[source.pack_index];
+    const char *grid = this->pack.grid(floor);
+
+    if (grid != NULL) {
+      new_floor->load_grid(grid, floor->width, floor->height);
+    }
+
+  } else {
+    std::string error;
+    if (!new_floor->load_floor(this->floor_path(source.map_num, ".mp"), error)) {
+      log << '\t' << error << '\n';
+    }
+  }
+
+  return new_floor;
+}
+
+
+/*************************************************************************
+ * Function: load_floor_objects
+ * Description: places a floor's objects from its generated objects, the
+ *              asset pack or its .dat file. Doors and stairs are always placed; items and 
+ *              monsters only when populating. Loot is rolled from a seed
+ *              derived from the world seed and the floor ID, so a floor
+ *              is populated the same way whenever it is first built.
+ * Parameters: floor - the floor, as built by build_layout
+ *             floor_num - the number of the floor
+ *             populate - true to place the floor's items and monsters
+ *             log - stream for load messages
+ *
+ * Pre-conditions: item data and monster data must have been loaded first,
+ *                 and the floor must be in the index
+ * Post-conditions: the floor's objects will have been placed
+ * Returns: none
+ ************************************************************************/
+void Game::load_floor_objects(Floor *new_floor, int floor_num, bool populate, std::ostream &log)
+{
+  const std::string &floor_ID = this->floor_names.name(floor_num);
+  floor_source source = this->floor_sources[floor_num];
+  unsigned int seed = this->world_seed;
+  std::string data_object;        /* string to hold object type */
+  std::string tgt_id;             /* string to hold target (monster, item, weapon, etc) ID */
+  int obj_x, obj_y,               /* Coordinate variables... */
+      coord_x, coord_y; 
+
+  for (size_t i = 0; i < floor_ID.size(); i++) {
+    seed = seed * 31 + floor_ID[i];
+  }
+
+  log << "\tLoading \"" << floor_ID << "\"\n";
+
+  if (source.gen_index >= 0) {
+    const std::vector<gen_object> &objects = this->generated_floors[source.gen_index].objects;
+
+    for (auto j = objects.begin(); j != objects.end(); j++) {
+      if (populate || j->object == "door" || j->object == "stair") {
+        this->place_floor_object(new_floor, j->object, j->x, j->y, j->target, j->x2, j->y2, 
+                                 &seed, log);
+      }
+    }
+
+  } else if (source.pack_index >= 0) {
+    const std::string object_names[] = { "door", "stair", "item", "mob" };
+    const pack_floor *floor = &this->pack.floors()[source.pack_index];
+    const pack_object *object;
+
+    for (uint32_t j = floor->object_first; 
+         j < floor->object_first + floor->object_count && j < this->pack.object_count(); j++) {
+      object = &this->pack.objects()[j];
+      if (object->kind == PACK_DOOR || object->kind == PACK_STAIR ||
+          (populate && object->kind <= PACK_OBJ_MOB)) {
+        this->place_floor_object(new_floor, object_names[object->kind], object->x, object->y,
+                                 this->pack.string(object->target), object->x2, object->y2, &seed, log);
+      }
+    }
+
+  } else {
+    TableReader map_data_file;      /* map data file reader */
+    slice object, target;           /* object type and target ID fields */
+
+    /* open the datafile, skip its ID record and begin parsing */
+    map_data_file.open(this->floor_path(source.map_num, ".dat"));
+    map_data_file.next_record();
+
+    /* 
+     * while there are entries in the data file, 
+     *  read the associated object identifier and coordinate location
+     *  and the fields that follow for its type, then place it.
+     *  Malformed entries are logged and skipped
+     */
+    while (map_data_file.next_record()) {
+      target.size = 0;
+      coord_x = coord_y = 0;
+      if (map_data_file.read_word(object) && map_data_file.read_int(obj_x) && 
+          map_data_file.read_int(obj_y) &&
+          (map_data_file.at_record_end() || map_data_file.read_word(target)) &&
+          (map_data_file.at_record_end() || 
+           (map_data_file.read_int(coord_x) && map_data_file.read_int(coord_y)))) {
+        if (populate || object == "door" || object == "stair") {
+          data_object.assign(object.data, object.size);
+          tgt_id.assign(target.data, target.size);
+          this->place_floor_object(new_floor, data_object, obj_x, obj_y, tgt_id, coord_x, coord_y, 
+                                   &seed, log);
+        }
+      } else {
+        log << '\t' << map_data_file.error() << '\n';
+      }
+    }
+  }
+
+  /* the quest target lives on its floor from the start; a generated one is among the objects */
+  if (populate && source.gen_index < 0 && floor_ID == QUEST_TARGET_FLOOR) {
+    new_floor->add_mob( this->mob_table[this->quest_target_num], QUEST_TARGET_COORD );
+  }
+}
+
+
+/*************************************************************************
+ * Function: evict_floors
+ * Description: while more floors are loaded than the floor budget allows,
+ *              unloads the least recently visited floor, keeping only its
+ *              saved state, packed, until it is visited again
+ * Parameters: spare - room to leave in the budget for floors about to load
+ * Pre-conditions: none
+ * Post-conditions: at most floor_budget - spare floors (and always the 
+ *                  current floor) are loaded
+ * Returns: none
+ ************************************************************************/
+void Game::evict_floors(int spare)
+{
+  int oldest;                     /* number of the least recently visited floor */
+  std::stringstream state;
+
+  while (this->floor_budget > 0 && this->loaded_floors > 1 &&
+         this->loaded_floors + spare > this->floor_budget) {
+    oldest = NO_ID;
+
+    for (int i = 0; i < this->floor_names.size(); i++) {
+      if (this->floors[i] != NULL && this->floors[i] != this->current_floor && 
+          (oldest == NO_ID || this->floor_visits[i] < this->floor_visits[oldest])) {
+        oldest = i;
+      }
+    }
+
+    state.str("");
+    this->floors[oldest]->save_state(state);
+    this->dormant_floors[oldest].pack(state.str(), this->item_names, this->mob_names);
+    delete this->floors[oldest];
+    this->floors[oldest] = NULL;
+    this->loaded_floors--;
+    this->logger.record(LEVEL_INFO, EV_FLOOR_EVICT, oldest);
+  }
+}
+
+
+/*************************************************************************
+ * Function: place_floor_object
+ * Description: places an object read from a floor's data onto the floor.
+ *              A record off the floor's spaces, or naming an item or
+ *              monster that is not loaded, is logged and skipped, as is
+ *              loot naming an item that is not loaded
+ * Parameters: floor - the floor being loaded
+ *             data_object - the object type (door, stair, item or mob)
+ *             x, y - the location of the object
+ *             tgt_id - the door's key, the stair's linked floor, or the
+ *                      item or monster ID
+ *             x2, y2 - the linked coordinate of a stair
+ *             seed - the floor's seed for monster loot rolls
+ *             log - stream for load messages
+ *
+ * Pre-conditions: item data and monster data must have been loaded first
+ * Post-conditions: the object will have been placed, if it could be
+ * Returns: none
+ ************************************************************************/
+void Game::place_floor_object(Floor *floor, const std::string &data_object, int x, int y,
+                              const std::string &tgt_id, int x2, int y2, unsigned int *seed,
+                              std::ostream &log)
+{
+  Space *space = floor->get_space(x, y);
+  auto item = this->items.find(tgt_id);
+  auto data = this->mobs.find(tgt_id);
+
+  if (space == NULL) {
+    log << "\tskipped " << data_object << " at " << x << ',' << y << ": no space there\n";
+
+  /* doors. If they have an entry, they're locked */
+  } else if (data_object == "door") {
+    if (tgt_id != "" && space->get_kind() == TILE_DOOR) {
+      static_cast<Door*>( space )->set_key( this->item_names.find(tgt_id) );
+    }
+  
+  /* stairs, linked to another stair on another floor  */
+  } else if (data_object == "stair" && space->is_stair()) {
+    static_cast<Stair*>( space )->set_linked_floor( this->floor_names.find(tgt_id) );
+    static_cast<Stair*>( space )->set_linked_coord(Coord(x2, y2));
+
+  /* items from the loaded item map */
+  } else if (data_object == "item") {
+    if (item != this->items.end()) {
+      space->add_item( item->second );
+    } else {
+      log << "\tskipped item " << tgt_id << ": no such item\n";
+    }
+
+  /* monsters from  the loaded monster data map */
+  } else if (data_object == "mob" && data == this->mobs.end()) {
+    log << "\tskipped mob " << tgt_id << ": no such monster\n";
+
+  } else if (data_object == "mob") {
+    log << "\tread " << tgt_id << " -> " << data->second->name << '\n';
+
+    /* put the monster on its space */
+    entity mob = floor->add_mob(data->second, Coord(x, y));
+    Entities *mobs = floor->get_mobs();
+    std::vector<std::pair<std::string, int>> *loot_table;
+    loot_table = &(data->second->loot);
+
+    /* determine monster inventory based on the loaded loot table entry for the mob (by ID) */
+    for (auto i = loot_table->begin(); i != loot_table->end(); i++){
+      if ((rand_r(seed) % 100 + 1) <= i->second){
+        log << "\t\tgiving " << tgt_id << " " << i->first << '\n';            
+        item = this->items.find(i->first);
+        if (mob != NO_ENTITY && item != this->items.end()) {
+          mobs->add_item(mobs->find(mob), item->second);
+        }
+      }
+    }
+  }
+}
+
+
+/*************************************************************************
+ * Function: parse_reload
+ * Description: called on the reloader's thread. Re-reads the changed 
+ *              gamedata and keeps only what differs from the loaded data:
+ *              new and changed items, new and changed monsters (a changed
+ *              loot table changes its monster), and the layout of every 
+ *              floor whose .mp or .dat file changed, rebuilt without its
+ *              items or monsters. A layout that cannot be read is left 
+ *              out. Nothing the game holds is changed.
+ * Parameters: reload - holds the changed paths; filled with the changes
+ * Pre-conditions: the game must not be changing its data
+ * Post-conditions: none
+ * Returns: none
+ ************************************************************************/
+void Game::parse_reload(gamedata_reload &reload)
+{
+  std::map<std::string, Item*> items;   /* every item, read again */
+  std::vector<mob_data*> mobs;          /* every monster, read again */
+  bool items_changed = false, mobs_changed = false;
+  Floor *floor;
+
+  for (auto i = reload.paths.begin(); i != reload.paths.end(); i++) {
+    reload.log << "\tChanged: " << *i << '\n';
+    items_changed = items_changed || i->compare(0, ITEM_DIR.size(), ITEM_DIR) == 0;
+    mobs_changed = mobs_changed || i->compare(0, MOB_DIR.size(), MOB_DIR) == 0;
+  }
+
+  if (items_changed) {
+    this->load_generic_items(items, reload.log);
+    this->load_weapons(items, reload.log);
+    this->load_armor(items, reload.log);
+
+    for (auto i = items.begin(); i != items.end(); i++) {
+      auto loaded = this->items.find(i->first);
+      if (loaded != this->items.end() && loaded->second->same_as(i->second)) {
+        delete i->second;
+      } else {
+        reload.items.push_back(i->second);
+      }
+    }
+  }
+
+  if (mobs_changed) {
+    this->load_mobs(mobs, reload.log);
+
+    for (auto i = mobs.begin(); i != mobs.end(); i++) {
+      if (file_exists((MOB_LOOT_DIR + (*i)->id + ".tbl").c_str())) {
+        this->load_loot((*i)->id + ".tbl", (*i)->loot, reload.log);
+      }
+
+      auto loaded = this->mobs.find((*i)->id);
+      if (loaded != this->mobs.end() && loaded->second->same_as(**i)) {
+        delete *i;
+      } else {
+        reload.mobs.push_back(*i);
+      }
+    }
+  }
+
+  /* only floors read from text files can be rebuilt from them */
+  for (int i = 0; i < this->floor_names.size(); i++) {
+    if (this->floor_sources[i].pack_index < 0 && this->floor_sources[i].gen_index < 0 &&
+        (reload.paths.count(this->floor_path(this->floor_sources[i].map_num, ".mp")) > 0 ||
+         reload.paths.count(this->floor_path(this->floor_sources[i].map_num, ".dat")) > 0)) {
+      floor = this->build_layout(i, reload.log);
+
+      if (floor->get_spaces()->empty()) {
+        delete floor;
+      } else {
+        this->link_spaces(floor);
+        this->load_floor_objects(floor, i, false, reload.log);
+        reload.floors[i] = floor;
+      }
+    }
+  }
+}
+
+
+/*************************************************************************
+ * Function: check_reload
+ * Description: called once a turn. Applies gamedata the reloader has read
+ *              since the last turn. Changed items and monster data are 
+ *              updated in place, so everything holding them sees the 
+ *              change, and the monsters of a changed kind take its new 
+ *              stats. New items and monsters are added. A loaded floor 
+ *              whose layout changed is swapped for the rebuilt layout, 
+ *              with its state carried over. Floors that are not loaded 
+ *              read their files again when they are next loaded.
+ * Parameters: none
+ * Pre-conditions: none
+ * Post-conditions: the game data matches the gamedata files as read
+ * Returns: none
+ ************************************************************************/
+void Game::check_reload()
+{
+  gamedata_reload *reload = this->reloader.collect();
+  std::ostringstream log;
+  std::stringstream summary;
+  int changed_items = 0, changed_mobs = 0, changed_floors = 0;
+  int old_hp, hp;
+  Entities *mobs;
+
+  if (reload != NULL) {
+    /* a floor being prefetched may be built from the data about to change */
+    this->prefetcher.stop();
+
+    log << "Reloading gamedata...\n" << reload->log.str();
+
+    for (auto i = reload->items.begin(); i != reload->items.end(); i++) {
+      auto loaded = this->items.find((*i)->id());
+
+      if (loaded == this->items.end()) {
+        (*i)->set_num(this->item_names.intern((*i)->id()));
+        this->item_table.push_back(*i);
+        this->items.insert(std::pair<std::string, Item*>((*i)->id(), *i));
+        *i = NULL;
+        changed_items++;
+      } else if (loaded->second->update(*i)) {
+        changed_items++;
+      } else {
+        log << '\t' << (*i)->id() << " changed kind, and is only reloaded on a restart\n";
+      }
+    }
+
+    /* the weight carried is kept as items are picked up, so is totalled again */
+    this->player.get_inventory()->reweigh();
+
+    for (auto i = reload->mobs.begin(); i != reload->mobs.end(); i++) {
+      auto loaded = this->mobs.find((*i)->id);
+
+      if (loaded == this->mobs.end()) {
+        (*i)->num = this->mob_names.intern((*i)->id);
+        this->mob_table.push_back(*i);
+        this->mobs.insert(std::pair<std::string, mob_data*>((*i)->id, *i));
+        *i = NULL;
+      } else {
+        old_hp = loaded->second->hp;
+        (*i)->num = loaded->second->num;
+        *loaded->second = **i;
+
+        /* 
+         * monsters of the kind on loaded floors read its new stats from
+         * it. One that was unhurt stays unhurt; others keep their hit 
+         * points, up to the new maximum
+         */
+        for (auto j = this->floors.begin(); j != this->floors.end(); j++) {
+          if (*j != NULL) {
+            mobs = (*j)->get_mobs();
+            for (uint32_t k = 0; k < mobs->size(); k++) {
+              if (mobs->get_kind(k)->num == loaded->second->num) {
+                hp = mobs->get_hp(k);
+                mobs->set_hp(k, (hp == old_hp || hp > loaded->second->hp) ? loaded->second->hp : hp);
+              }
+            }
+          }
+        }
+      }
+      changed_mobs++;
+    }
+
+    for (auto i = reload->floors.begin(); i != reload->floors.end(); i++) {
+      if (this->floors[i->first] != NULL && this->swap_floor(i->first, i->second, log)) {
+        i->second = NULL;
+        changed_floors++;
+      }
+    }
+
+    summary << "Reloaded gamedata: " << changed_items << " items, " << changed_mobs 
+            << " monsters and " << changed_floors << " floors changed.\n";
+    log << summary.str();
+    this->logger.text(LEVEL_INFO, log.str());
+    this->logger.record(LEVEL_INFO, EV_RELOAD, changed_items, changed_mobs, changed_floors);
+    this->messages.push_back(summary.str());
+
+    this->reloader.finish();
+    this->prefetcher.start();
+  }
+}
+
+
+/*************************************************************************
+ * Function: swap_floor
+ * Description: replaces a loaded floor with a rebuilt layout, carrying 
+ *              over its opened doors, items and monsters, and the player
+ *              if it is the current floor. Anything left on a tile the 
+ *              new layout no longer has is lost. If the player could not
+ *              stand where they are on the new layout, the old floor is 
+ *              kept.
+ * Parameters: floor_num - the number of the loaded floor
+ *             floor - the rebuilt layout, with its doors and stairs
+ *             log - stream for reload messages
+ * Pre-conditions: the floor must be loaded
+ * Post-conditions: if swapped, the game owns the new floor and the old 
+ *                  one is freed
+ * Returns: bool - true if the floor was swapped
+ ************************************************************************/
+bool Game::swap_floor(int floor_num, Floor *floor, std::ostream &log)
+{
+  Floor *old_floor = this->floors[floor_num];
+  bool current = (old_floor == this->current_floor);
+  Space *here = NULL;
+  std::stringstream state;
+  bool swapped = true;
+
+  old_floor->save_state(state);
+  floor->restore_state(state, this->items, this->mobs);
+
+  if (current) {
+    here = floor->find_space(this->player.get_coord());
+    old_floor->get_space(this->player.get_coord())->delete_character();
+    swapped = (here != NULL && here->add_character(&this->player));
+
+    if (!swapped) {
+      old_floor->add_char(&this->player, this->player.get_coord());
+      log << '\t' << this->floor_names.name(floor_num) 
+          << " kept: the player's tile is not open on the new layout\n";
+    }
+  }
+
+  if (swapped) {
+    this->floors[floor_num] = floor;
+    if (current) {
+      this->current_floor = floor;
+    }
+    delete old_floor;
+  }
+
+  return swapped;
+}
+
+
+/*************************************************************************
+ * Function: load_pack
+ * Description: loads the item and monster data from the mapped asset
+ *              pack instead of the gamedata text files. Floors are built
+ *              from the pack as they are needed (see build_layout).
+ * Parameters: none
+ * Pre-conditions: the pack must be open
+ * Post-conditions: the game data will have been loaded
+ * Returns: none
+ ************************************************************************/
+void Game::load_pack()
+{
+  const pack_item *item;
+  const pack_mob *mob;
+  const pack_loot *loot;
+  std::string item_ID;
+  mob_data *data;
+
+  /* items, weapons and armor */
+  for (uint32_t i = 0; i < this->pack.item_count(); i++) {
+    item = &this->pack.items()[i];
+    item_ID = this->pack.string(item->id);
+
+    if (item->kind == PACK_WEAPON) {
+      this->items.insert(std::pair<std::string, Item*>(item_ID, 
+        new Weapon(item_ID, this->pack.string(item->name), this->pack.string(item->description),
+                   item->weight, item->value, item->die_n, item->die_s, item->die_m)));
+    } else if (item->kind == PACK_ARMOR) {
+      this->items.insert(std::pair<std::string, Item*>(item_ID, 
+        new Armor(item_ID, this->pack.string(item->name), this->pack.string(item->description),
+                  item->weight, item->value, item->ac)));
+    } else {
+      this->items.insert(std::pair<std::string, Item*>(item_ID, 
+        new Item(item_ID, this->pack.string(item->name), this->pack.string(item->description),
+                 item->weight, item->value)));
+    }
+  }
+
+  /* monsters and their loot tables */
+  for (uint32_t i = 0; i < this->pack.mob_count(); i++) {
+    mob = &this->pack.mobs()[i];
+    data = new mob_data;
+    data->id = this->pack.string(mob->id);
+    data->name = this->pack.string(mob->name);
+    data->render_char = mob->render_char;
+    data->ac = mob->ac;
+    data->hp = mob->hp;
+    data->die_n = mob->die_n;
+    data->die_s = mob->die_s;
+    data->die_m = mob->die_m;
+    data->b_atk = mob->b_atk;
+    data->cr = mob->cr;
+
+    for (uint32_t j = mob->loot_first; 
+         j < mob->loot_first + mob->loot_count && j < this->pack.loot_count(); j++) {
+      loot = &this->pack.loot()[j];
+      data->loot.push_back(std::pair<std::string, int>(this->pack.string(loot->item), loot->chance));
+    }
+
+    this->mobs.insert(std::pair<std::string, mob_data*>(data->id, data));
+  }
+}
+
+
+/*************************************************************************
+ * Function: load_generic_items
+ * Description: loads generic item data from the item table into a map, 
+ *              using item ID as a key. 
+ * Parameters: items - the map to load into
+ *             log - stream for load messages
+ * Pre-conditions: none
+ * Post-conditions: item data is loaded into items
+ * Returns: none
+ ************************************************************************/
+void Game::load_generic_items(std::map<std::string, Item*> &items, std::ostream &log)
+{
+  TableReader item_table;       /* reader for the item table */
+  slice item_ID,                /* the item ID  */
+        item_name,              /* the item name */
+        item_desc;              /* the item description */
+  double item_weight,           /* doubles to hold item weight and value */
+         item_value;
+
+  /*
+   *  Loop through all records in the item table,
+   *    load each item's information, 
+   *      log the item, 
+   *        and insert the item into the map
+   *  Malformed records are logged and skipped
+   */
+  if (!item_table.open(ITEM_TBL_PATH)) {
+    log << '\t' << item_table.error() << '\n';
+  }
+
+  while (item_table.next_record()) {
+    if (item_table.read_string(item_ID) && item_table.read_string(item_name) &&
+        item_table.read_string(item_desc) && item_table.read_double(item_weight) &&
+        item_table.read_double(item_value)) {
+      log << "\tLoading generic item, " << item_ID << '\n';
+      items.insert(std::pair<std::string, Item*>(item_ID.str(), 
+        new Item(item_ID.str(), item_name.str(), item_desc.str(), item_weight, item_value)));  
+    } else {
+      log << '\t' << item_table.error() << '\n';
+    }
+  }
+}
+
+
+/*************************************************************************
+ * Function: load_weapons
+ * Description: loads weapon class item data from the weapon table into a
+ *              map, using item ID as a key. 
+ * Parameters: items - the map to load into
+ *             log - stream for load messages
+ * Pre-conditions: none
+ * Post-conditions: item data is loaded into items
+ * Returns: none
+ ************************************************************************/
+void Game::load_weapons(std::map<std::string, Item*> &items, std::ostream &log)
+{
+  TableReader item_table;       /* reader for the weapon table */
+  slice item_ID,                /* the item ID  */
+        item_name,              /* the item name */
+        item_desc;              /* the item description */
+  double item_weight,           /* doubles to hold item weight and value */
+         item_value;
+  int damage_die_n,
+      damage_die_sides,
+      damage_die_mod;
+
+  if (!item_table.open(WPN_TBL_PATH)) {
+    log << '\t' << item_table.error() << '\n';
+  }
+
+  while (item_table.next_record()) {
+    if (item_table.read_string(item_ID) && item_table.read_string(item_name) &&
+        item_table.read_string(item_desc) && item_table.read_double(item_weight) &&
+        item_table.read_double(item_value) && item_table.read_int(damage_die_n) &&
+        item_table.read_int(damage_die_sides) && item_table.read_int(damage_die_mod)) {
+      log << "\tLoading weapon, " << item_ID << '\n';
+      items.insert(std::pair<std::string, Item*>(item_ID.str(), 
+      new Weapon( item_ID.str(), 
+                  item_name.str(), 
+                  item_desc.str(), 
+                  item_weight, 
+                  item_value, 
+                  damage_die_n, 
+                  damage_die_sides, 
+                  damage_die_mod)));  
+    } else {
+      log << '\t' << item_table.error() << '\n';
+    }
+  }
+}
+
+
+/*************************************************************************
+ * Function: load_armor
+ * Description: loads armor class item data from the armor table into a 
+ *              map, using item ID as a key. 
+ * Parameters: items - the map to load into
+ *             log - stream for load messages
+ * Pre-conditions: none
+ * Post-conditions: item data is loaded into items
+ * Returns: none
+ ************************************************************************/
+void Game::load_armor(std::map<std::string, Item*> &items, std::ostream &log)
+{
+  TableReader item_table;       /* reader for the armor table */
+  slice item_ID,                /* the item ID  */
+        item_name,              /* the item name */
+        item_desc;              /* the item description */
+  double item_weight,           /* doubles to hold item weight and value */
+         item_value;
+  int ac;
+
+  if (!item_table.open(AMR_TBL_PATH)) {
+    log << '\t' << item_table.error() << '\n';
+  }
+
+  while (item_table.next_record()) {
+    if (item_table.read_string(item_ID) && item_table.read_string(item_name) &&
+        item_table.read_string(item_desc) && item_table.read_double(item_weight) &&
+        item_table.read_double(item_value) && item_table.read_int(ac)) {
+      log << "\tLoading armor, " << item_ID << '\n';
+      items.insert(std::pair<std::string, Item*>(item_ID.str(), 
+        new Armor(item_ID.str(), item_name.str(), item_desc.str(), item_weight, item_value, ac)));  
+    } else {
+      log << '\t' << item_table.error() << '\n';
+    }
+  }
+}
+
+
+/*************************************************************************
+ * Function: load mobs
+ * Description: load the monster information into a list of structs 
+ *              holding the initialization information for monsters of a
+ *              particular type. Loot tables are loaded separately.
+ * Parameters: mobs - the list to load into
+ *             log - stream for load messages
+ * Pre-conditions: none
+ * Post-conditions: the monster data is loaded into the list
+ * Returns: none
+ ************************************************************************/
+void Game::load_mobs(std::vector<mob_data*> &mobs, std::ostream &log)
+{
+  TableReader mob_table;
+  slice id, name, render_char;
+  mob_data data;
+
+  if (!mob_table.open(MOB_TBL)) {
+    log << '\t' << mob_table.error() << '\n';
+  }
+
+  while (mob_table.next_record()) {
+    if (mob_table.read_string(id) && mob_table.read_string(name) && 
+        mob_table.read_string(render_char) && mob_table.read_int(data.ac) && 
+        mob_table.read_int(data.hp) && mob_table.read_int(data.die_n) && 
+        mob_table.read_int(data.die_s) && mob_table.read_int(data.die_m) && 
+        mob_table.read_int(data.b_atk) && mob_table.read_double(data.cr)) {
+      data.id = id.str();
+      data.name = name.str();
+      data.render_char = (render_char.size > 0) ? render_char.data[0] : '?';
+
+      log << "\tRead mob, " << data.id << '\n';
+      mobs.push_back(new mob_data(data));
+    } else {
+      log << '\t' << mob_table.error() << '\n';
+    }
+  }
+}
+
+
+/*************************************************************************
+ * Function: load_loot
+ * Description: loads a monster loot table, a list of item IDs and the 
+ *              percent chance of each being dropped
+ * Parameters: file_name - the table's file name in the loot directory
+ *             loot - the list to load into
+ *             log - stream for load messages
+ * Pre-conditions: none
+ * Post-conditions: the loot table is loaded into the list
+ * Returns: none
+ ************************************************************************/
+void Game::load_loot(const std::string &file_name, std::vector<std::pair<std::string, int>> &loot,
+                     std::ostream &log)
+{
+  TableReader mob_loot_table;
+  slice loot_id;
+  int loot_chance;
+
+  log << "\tCreating loot table " << file_name << '\n';
+  if (!mob_loot_table.open(MOB_LOOT_DIR + file_name)) {
+    log << '\t' << mob_loot_table.error() << '\n';
+  }
+
+  while (mob_loot_table.next_record()) {
+    if (mob_loot_table.read_string(loot_id) && mob_loot_table.read_int(loot_chance)) {
+      loot.push_back(std::pair<std::string, int>(loot_id.str(), loot_chance));
+      log << "\t\tAdded " << loot_id << " with chance " << loot_chance << '\n';
+    } else {
+      log << '\t' << mob_loot_table.error() << '\n';
+    }
+  }
+}
+
+
+/*************************************************************************
+ * Function: check_autosave
+ * Description: applies the autosave policy at the end of a turn. A snapshot
+ *              is taken every AUTOSAVE_TURNS turns, whenever a stair was
+ *              taken, and whenever the journal has grown long enough to
+ *              slow down recovery. Quitting writes a final save before
+ *              returning; a game that has been won or lost discards its
+ *              save.
+ *
+ * Parameters: quitting - true if the player chose to quit
+ * Pre-conditions: none
+ * Post-conditions: a snapshot may have been started, written or discarded
+ * Returns: none
+ ************************************************************************/
+void Game::check_autosave(bool quitting)
+{
+  this->autosave.reap();
+
+  if (quitting) {
+    this->take_snapshot(false);
+  } else if (!this->in_progress) {
+    this->autosave.discard();
+    this->journal.discard();
+  } else if (this->autosave.due() || this->changed_floor ||
+             this->journal.records() >= JOURNAL_ROLL_RECORDS) {
+    this->take_snapshot(true);
+  }
+
+  /* journal generations covered by a snapshot on disk are no longer needed */
+  this->journal.prune(this->autosave.get_saved_tag());
+  this->changed_floor = false;
+}
+
+
+/*************************************************************************
+ * Function: take_snapshot
+ * Description: starts a new journal generation and snapshots the game. 
+ *              The snapshot is tagged with the new generation, so once it
+ *              is on disk, the older generations can be pruned.
+ * Parameters: background - false to write the snapshot before returning
+ * Pre-conditions: none
+ * Post-conditions: a snapshot may have been started or written
+ * Returns: none
+ ************************************************************************/
+void Game::take_snapshot(bool background)
+{
+  this->autosave.reap(!background);
+
+  /* a snapshot still being written keeps its turn; try again next turn */
+  if (!this->autosave.in_flight()) {
+    this->journal.rotate();
+    this->autosave.snapshot(this, this->journal.generation(), background);
+    this->logger.record(LEVEL_INFO, EV_SNAPSHOT, this->journal.generation(), background);
+  }
+}
+
+
+/*************************************************************************
+ * Function: save_state
+ * Description: writes the game state (game progress, the player character
+ *              and the mutable state of every floor) to a stream.
+ * Parameters: out - the stream to write to
+ * Pre-conditions: none
+ * Post-conditions: the game state will have been written to out
+ * Returns: none
+ ************************************************************************/
+void Game::save_state(std::ostream &out)
+{
+  std::string floor_ID;
+  Inventory *inventory = this->player.get_inventory();
+
+  for (int i = 0; i < this->floor_names.size(); i++) {
+    if (this->floors[i] == this->current_floor) {
+      floor_ID = this->floor_names.name(i);
+    }
+  }
+
+  out << SAVE_HEADER << '\n';
+  out << "game " << this->days_passed << ' ' << floor_ID << '\n';
+  out << "journal " << this->journal.generation() << '\n';
+  out << "seed " << this->world_seed << '\n';
+  out << this->dungeon_record();
+  out << "name \"" << this->player.get_name() << "\"\n";
+  out << "player " << this->player.get_coord().x() << ' ' 
+                   << this->player.get_coord().y() << ' '
+                   << this->player.get_hp() << ' '
+                   << this->player.get_max_hp() << ' '
+                   << this->player.get_b_atk() << ' '
+                   << this->player.get_level() << ' '
+                   << this->player.get_experience();
+  for (int i = STR; i <= CHA; i++) {
+    out << ' ' << this->player.get_ability(static_cast<ability>(i));
+  }
+  out << '\n';
+
+  out << "equip " << this->player.get_weapon()->id() << ' ' 
+                  << this->player.get_armor()->id() << '\n';
+  for (int i = 0; i < inventory->size(); i++) {
+    out << "inv " << inventory->at(i).item->id() << ' ' << inventory->at(i).count << '\n';
+  }
+
+  for (int i = 0; i < this->floor_names.size(); i++) {
+    if (this->floors[i] != NULL) {
+      out << "floor " << this->floor_names.name(i) << '\n';
+      this->floors[i]->save_state(out);
+    }
+  }
+  for (int i = 0; i < this->floor_names.size(); i++) {
+    if (!this->dormant_floors[i].empty()) {
+      out << "floor " << this->floor_names.name(i) << '\n' 
+          << this->dormant_floors[i].unpack(this->item_names, this->mob_names);
+    }
+  }
+
+  out << SAVE_FOOTER << '\n';
+}
+
+
+/*************************************************************************
+ * Function: restore_state
+ * Description: restores the game state from a stream written by save_state
+ * Parameters: in - the stream to read from
+ * Pre-conditions: the gamedata must have been loaded
+ * Post-conditions: the game state will match the saved state
+ * Returns: bool - true if the state was restored
+ ************************************************************************/
+bool Game::restore_state(std::istream &in)
+{
+  std::string line, record, tgt_id, floor_ID, dormant;
+  std::stringstream line_ss;
+  int x, y, n, i, floor_num;
+  bool restored = false;
+
+  std::getline(in, line);
+  if (line == SAVE_HEADER) {
+
+    /* a floor being prefetched may be built from state about to be replaced */
+    this->prefetcher.stop();
+
+    /* the player is placed again once its floor and coordinate are known */
+    this->current_floor->get_space(this->player.get_coord())->delete_character();
+    this->player.get_inventory()->clear();
+
+    while (std::getline(in, line)) {
+      line_ss.clear();
+      line_ss.str(line);
+      line_ss >> record;
+
+      if (record == "game") {
+        line_ss >> this->days_passed >> floor_ID;
+
+      } else if (record == "journal") {
+        line_ss >> this->save_gen;
+
+      } else if (record == "name") {
+        i = 0;
+        this->player.set_name(str_parse_string(line, i));
+
+      } else if (record == "player" && (line_ss >> x >> y)) {
+        this->player.set_coord(x, y);
+        line_ss >> n; this->player.set_hp(n);
+        line_ss >> n; this->player.set_max_hp(n);
+        line_ss >> n; this->player.set_b_atk(n);
+        line_ss >> n; this->player.set_level(n);
+        line_ss >> n; this->player.set_experience(n);
+        for (int j = STR; j <= CHA; j++) {
+          line_ss >> n; 
+          this->player.set_ability(static_cast<ability>(j), n);
+        }
+
+      } else if (record == "equip" && (line_ss >> tgt_id)) {
+        this->player.equip_item(this->items[tgt_id]);
+        line_ss >> tgt_id;
+        this->player.equip_item(this->items[tgt_id]);
+
+      } else if (record == "inv" && (line_ss >> tgt_id >> n)) {
+        for (int j = 0; j < n; j++) {
+          this->player.add_item(this->items[tgt_id]);
+        }
+
+      } else if (record == "seed") {
+        line_ss >> this->world_seed;
+
+      /* 
+       * loaded floors are restored now; the rest are kept as dormant
+       * state, to be restored if they are ever loaded
+       */
+      } else if (record == "floor" && (line_ss >> tgt_id)) {
+        floor_num = this->floor_names.find(tgt_id);
+        if (floor_num != NO_ID && this->floors[floor_num] != NULL) {
+          this->floors[floor_num]->restore_state(in, this->items, this->mobs);
+        } else {
+          dormant = "";
+          while (std::getline(in, line) && line != "end") {
+            dormant += line + '\n';
+          }
+          dormant += "end\n";
+          if (floor_num != NO_ID) {
+            this->dormant_floors[floor_num].pack(dormant, this->item_names, this->mob_names);
+          }
+        }
+
+      } else if (record == SAVE_FOOTER) {
+        restored = true;
+      }
+    }
+
+    floor_num = this->floor_names.find(floor_ID);
+    if (floor_num != NO_ID) {
+      this->current_floor = this->get_floor(floor_num);
+      this->evict_floors(0);
+    }
+    this->current_floor->add_char(&this->player, this->player.get_coord());
+    this->prefetcher.start();
+  }
+
+  return restored;
+}
+
+
+/*************************************************************************
+ * Function: load_save
+ * Description: recovers the game saved at SAVE_PATH. The save is read in
+ *              full and checked for its header and footer, and for the
+ *              dungeon it was saved in, before any of the game state is
+ *              touched. The journal written since the 
+ *              save is then replayed on top of it, and a new snapshot is
+ *              started so the replayed journal need not be read again.
+ * Parameters: none
+ * Pre-conditions: the gamedata must have been loaded
+ * Post-conditions: the game state may have been restored
+ * Returns: bool - true if a save was restored
+ ************************************************************************/
+bool Game::load_save()
+{
+  std::ifstream save_file(SAVE_PATH.c_str());
+  std::stringstream contents;
+  std::string footer = SAVE_FOOTER + '\n';
+  std::string data;
+  bool restored = false;
+
+  contents << save_file.rdbuf();
+  data = contents.str();
+
+  /* a game in a generated dungeon is only restored into the same dungeon */
+  if (data.compare(0, SAVE_HEADER.size(), SAVE_HEADER) == 0 &&
+      data.size() >= footer.size() &&
+      data.compare(data.size() - footer.size(), footer.size(), footer) == 0 &&
+      (this->dungeon_record().empty() ? data.find("\ndungeon ") == std::string::npos :
+                                        data.find('\n' + this->dungeon_record()) != std::string::npos)) {
+    restored = this->restore_state(contents);
+  }
+
+  if (restored) {
+    this->journal.start(this->replay_journal(this->save_gen));
+    this->take_snapshot(true);
+  }
+
+  return restored;
+}
+
+
+/*************************************************************************
+ * Function: dungeon_record
+ * Description: returns the save record of the generated dungeon
+ * Parameters: none
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: std::string - the record, or "" if the dungeon is not generated
+ ************************************************************************/
+std::string Game::dungeon_record()
+{
+  std::stringstream record;
+
+  if (this->dungeon.floors > 0) {
+    record << "dungeon " << this->dungeon.floors << ' ' << this->dungeon.width << ' ' 
+           << this->dungeon.height << ' ' << this->dungeon.seed << '\n';
+  }
+
+  return record.str();
+}
+
+
+/*************************************************************************
+ * Function: replay_journal
+ * Description: applies the journal files from generation gen onward, in 
+ *              order, until a generation has no file. A final record cut
+ *              short by a crash (no trailing newline) is ignored.
+ * Parameters: gen - the first generation to replay
+ * Pre-conditions: the game state must be the snapshot for generation gen
+ * Post-conditions: the game state will include every journaled event
+ * Returns: int - the last generation replayed (gen, if there were none)
+ ************************************************************************/
+int Game::replay_journal(int gen)
+{
+  std::ifstream journal_file;
+  std::string line;
+  int last_gen = gen;
+
+  journal_file.open(this->journal.gen_path(gen).c_str());
+
+  while (journal_file.is_open()) {
+    while (std::getline(journal_file, line)) {
+      if (!journal_file.eof()) {
+        this->apply_event(line);
+      }
+    }
+    journal_file.close();
+    journal_file.clear();
+
+    last_gen = gen++;
+    journal_file.open(this->journal.gen_path(gen).c_str());
+  }
+
+  return last_gen;
+}
+
+
+/*************************************************************************
+ * Function: apply_event
+ * Description: applies one journal record to the game state. Records hold
+ *              the outcome of an event rather than the input that caused
+ *              it, so dice rolls are never repeated:
+ *                m x y x y   - a character moved on the current floor
+ *                h x y hp    - a character's hp changed from an attack
+ *                k x y       - a monster was slain
+ *                x exp level max_hp b_atk - the player gained experience
+ *                g id / d id - the player got / dropped an item
+ *                e id        - the player equipped an item
+ *                o x y       - a door or secret door was opened
+ *                f floor x y - the player took a stair
+ *                r days hp   - the player rested
+ *
+ * Parameters: event - the record to apply
+ * Pre-conditions: none
+ * Post-conditions: the game state may have changed
+ * Returns: bool - true if the record was understood
+ ************************************************************************/
+bool Game::apply_event(const std::string &event)
+{
+  std::stringstream event_ss(event);
+  std::string type, tgt_id;
+  int x, y, x2, y2, n;
+  Space *space;
+  Item *item;
+  bool applied = false;
+
+  event_ss >> type;
+
+  if (type == "m" && (event_ss >> x >> y >> x2 >> y2)) {
+    applied = this->current_floor->move_char(Coord(x, y), Coord(x2, y2));
+
+  } else if (type == "h" && (event_ss >> x >> y >> n)) {
+    space = this->current_floor->get_space(x, y);
+    if ((applied = (space->get_mob() != NO_ENTITY))) {
+      this->current_floor->get_mobs()->set_hp(this->current_floor->get_mobs()->find(space->get_mob()), n);
+    } else if ((applied = (space->get_character() != NULL))) {
+      space->get_character()->set_hp(n);
+    }
+
+  } else if (type == "k" && (event_ss >> x >> y)) {
+    space = this->current_floor->get_space(x, y);
+    if ((applied = (space->get_mob() != NO_ENTITY))) {
+      this->remove_mob(space->get_mob());
+    }
+
+  } else if (type == "x" && (event_ss >> n >> x >> y >> x2)) {
+    this->player.set_experience(n);
+    this->player.set_level(x);
+    this->player.set_max_hp(y);
+    this->player.set_b_atk(x2);
+    applied = true;
+
+  } else if (type == "g" && (event_ss >> tgt_id)) {
+    space = this->current_floor->get_space(this->player.get_coord());
+    item = space->remove_item(this->item_names.find(tgt_id));
+    if ((applied = (item != NULL))) {
+      this->player.add_item(item);
+    }
+
+  } else if (type == "d" && (event_ss >> tgt_id)) {
+    space = this->current_floor->get_space(this->player.get_coord());
+    this->player.remove_item(this->items[tgt_id]);
+    applied = space->add_item(this->items[tgt_id]);
+
+  } else if (type == "e" && (event_ss >> tgt_id)) {
+    this->player.equip_item(this->items[tgt_id]);
+    applied = true;
+
+  } else if (type == "o" && (event_ss >> x >> y)) {
+    space = this->current_floor->get_space(x, y);
+    if (space != NULL && space->get_kind() == TILE_DOOR) {
+      applied = static_cast<Door*>(space)->open();
+    } else if (space != NULL && space->get_kind() == TILE_SECRET_DOOR) {
+      applied = static_cast<SecretDoor*>(space)->open();
+    }
+
+  } else if (type == "f" && (event_ss >> tgt_id >> x >> y)) {
+    n = this->floor_names.find(tgt_id);
+    if ((applied = (n != NO_ID))) {
+      this->current_floor->get_space(this->player.get_coord())->delete_character();
+      this->player.set_coord(x, y);
+      this->current_floor = this->get_floor(n);
+      this->current_floor->add_char(&this->player, this->player.get_coord());
+      this->evict_floors(0);
+    }
+
+  } else if (type == "r" && (event_ss >> n >> x)) {
+    this->days_passed = n;
+    this->player.set_hp(x);
+    applied = true;
+  }
+
+  return applied;
+}
+
@@ -15,18 +15,38 @@
 #include "Floor.hpp"
 #include "Space.hpp"
 #include "Character.hpp"
+#include "Autosave.hpp"
+#include "Journal.hpp"
+#include "AssetPack.hpp"
+#include "Prefetcher.hpp"
+#include "Reloader.hpp"
+#include "NameTable.hpp"
+#include "Logger.hpp"
+#include "Profiler.hpp"
+#include "Tracer.hpp"
+#include "Generator.hpp"
+#include "DormantFloor.hpp"
 #include <fstream>
 #include <sstream>
 #include <set>
 
 /* Gamedata paths */
 const std::string MAP_PATH_ROOT   = "gamedata/maps/";
+const std::string ITEM_DIR        = "gamedata/items/";
+const std::string MOB_DIR         = "gamedata/mobs/";
 const std::string ITEM_TBL_PATH   = "gamedata/items/items.tbl";
 const std::string WPN_TBL_PATH    = "gamedata/items/weapons.tbl";
 const std::string AMR_TBL_PATH    = "gamedata/items/armor.tbl";
 const std::string LOGFILE_PATH    = "gamedata/log";
 const std::string MOB_TBL         = "gamedata/mobs/mobs.tbl";
 const std::string MOB_LOOT_DIR    = "gamedata/mobs/loot/";
+const std::string PACK_PATH       = "gamedata/gamedata.pak";
+const std::string SAVE_PATH       = "gamedata/save";
+const std::string JOURNAL_PATH    = "gamedata/journal";
+
+/* save file markers */
+const std::string SAVE_HEADER = "vrsave 1";
+const std::string SAVE_FOOTER = "eof";
 
 /* starting player information */
 const std::string STARTING_MAP = "floor001";
@@ -40,35 +60,113 @@ const Coord QUEST_TARGET_COORD = Coord(4,7);
 
 /* gameplay constants */
 const int MAX_DAYS = 5;
+const int AUTOSAVE_TURNS = 50;
+const int JOURNAL_ROLL_RECORDS = 2000;  /* journal records that force a snapshot */
+const int FLOOR_BUDGET = 2;             /* floors kept loaded at once, 0 for no limit */
+
+/* where a floor's layout and data are loaded from */
+struct floor_source {
+  int map_num;      /* the N of floor_N.mp/.dat, for text gamedata */
+  int pack_index;   /* the floor record, for an asset pack */
+  int gen_index;    /* the generated floor, for a generated dungeon */
+};
 
 class Game{
   private:
     std::vector<std::string> messages;      /* container of messages to print per round */
-    std::map<std::string, Floor*> floors;   /* game floors */
-    std::map<std::string, Item*> items;     /* game item data */
-    std::map<std::string, mob_data*> mobs;  /* map of mobID to data */
+    NameTable floor_names;                  /* every floor's ID, loaded or not */
+    std::vector<floor_source> floor_sources;  /* where each floor is loaded from */
+    std::vector<Floor*> floors;             /* each floor, or NULL if not loaded */
+    std::vector<DormantFloor> dormant_floors;  /* packed state of evicted floors, or empty */
+    std::vector<long> floor_visits;         /* when each loaded floor was last visited */
+    gen_params dungeon;                     /* the generated dungeon, or NO_DUNGEON */
+    std::vector<gen_floor> generated_floors;  /* each generated floor's objects, by level */
+    std::vector<std::string> generated_grids; /* each generated floor's grid, packed as runs */
+    int loaded_floors;                      /* floors loaded at once */
+    long visit_clock;                       /* counts floor visits, for eviction order */
+    int floor_budget;                       /* floors kept loaded at once, 0 for no limit */
+    unsigned int world_seed;                /* seeds each floor's loot rolls */
+    std::map<std::string, Item*> items;     /* game item data, by item ID for loading */
+    std::map<std::string, mob_data*> mobs;  /* map of mobID to data, for loading */
+    NameTable item_names;                   /* item ID of each item number */
+    std::vector<Item*> item_table;          /* item of each item number */
+    NameTable mob_names;                    /* mob ID of each monster number */
+    std::vector<mob_data*> mob_table;       /* data of each monster number */
+    int quest_target_num;                   /* the number of the quest target monster */
 
     Player player;                          /* the player character */
-    Mob *quest_target;                      /* */
     bool in_progress;                       /* whether the game is in progress */
     Floor *current_floor;                   /* pointer to the current floor */
-    std::ofstream logfile;                  /* logfile */
+    Logger logger;                          /* event log, written out in the background */
+    Profiler profiler;                      /* turn phase timings, when profiling */
+    Tracer tracer;                          /* span trace of the game loop, when tracing */
+    AssetPack pack;                         /* mapped asset pack, if one was built */
+    Autosave autosave;                      /* autosave policy and snapshot writer */
+    Journal journal;                        /* event journal since the last snapshot */
+    Prefetcher prefetcher;                  /* loads nearby floors in the background */
+    Reloader reloader;                      /* re-reads changed gamedata, in development mode */
+    bool hot_reload;                        /* whether the game is in development mode */
 
     int days_passed;
+    bool changed_floor;                     /* whether a stair was taken this turn */
+    int save_gen;                           /* journal generation of the restored save */
     
   public:
     /* constructors destructors */
-    Game(std::string hero_name);
+    Game(std::string hero_name, bool hot_reload = false, const std::string &trace_path = "",
+         const gen_params &dungeon = NO_DUNGEON);
     ~Game();
 
     /* methods for loading game objects */
-    void load_floors();
-    void link_spaces();
-    void load_items();
-    void load_mobs();
+    void load_gamedata();
+    void index_pack_floors();
+    void index_floor(int map_num, std::string &floor_ID);
+    void gather_content(gen_content &content);
+    static void gather_content(const std::map<std::string, Item*> &items,
+                               const std::map<std::string, mob_data*> &mobs, gen_content &content);
+    int add_floor(const std::string &floor_ID, const floor_source &source);
+    void intern_items();
+    void intern_mobs();
+    Item *get_item(int item_num);
+    std::string floor_path(int map_num, const std::string &extension);
+    Floor *get_floor(int floor_num);
+    Floor *build_layout(int floor_num, std::ostream &log);
+    void load_floor_objects(Floor *floor, int floor_num, bool populate, std::ostream &log);
+    Floor *assemble_floor(int floor_num, const std::string &state, std::ostream &log);
+    void adopt_floor(int floor_num, Floor *floor);
+    void prefetch_floors();
+    void evict_floors(int spare);
+    void set_floor_budget(int budget) { this->floor_budget = budget; }
+    void link_spaces(Floor *floor);
+    static void load_generic_items(std::map<std::string, Item*> &items, std::ostream &log);
+    static void load_weapons(std::map<std::string, Item*> &items, std::ostream &log);
+    static void load_armor(std::map<std::string, Item*> &items, std::ostream &log);
+    static void load_mobs(std::vector<mob_data*> &mobs, std::ostream &log);
+    static void load_loot(const std::string &file_name,
+                          std::vector<std::pair<std::string, int>> &loot, std::ostream &log);
+    void load_pack();
+    void place_floor_object(Floor *floor, const std::string &data_object, int x, int y,
+                            const std::string &tgt_id, int x2, int y2, unsigned int *seed,
+                            std::ostream &log);
+
+    /* methods for reloading changed gamedata in development mode */
+    void parse_reload(gamedata_reload &reload);
+    void check_reload();
+    bool swap_floor(int floor_num, Floor *floor, std::ostream &log);
+
+    /* methods for saving and restoring the game state */
+    void save_state(std::ostream &out);
+    bool restore_state(std::istream &in);
+    bool load_save();
+    std::string dungeon_record();
+    void check_autosave(bool quitting);
+    void take_snapshot(bool background);
+    int replay_journal(int gen);
+    bool apply_event(const std::string &event);
 
     /* player-related methods */
     void move_player(const direction &dir);
+    void take_stair(Stair *stair, const char *message);
     void manage_player_inventory();
     Item* get_player_inventory_selection(const char *prompt);
     void print_player_inventory();
@@ -76,14 +174,16 @@ class Game{
     void player_drop_item();
     void player_examine_item();
     void player_equip_item();
-    void player_attack_mob(Character *mob);
+    void player_attack_mob(entity mob);
+    void remove_mob(entity mob);
     void player_rest();
     void print_player_character_sheet();
 
     /* monster-related methods */
     void move_mobs();
-    bool mob_make_moves(Character *mob, const std::vector<direction> &moves);
-    bool mob_attack_player(Character *mob);
+    bool mob_make_moves(uint32_t mob, const direction *moves, int n_moves);
+    bool mob_attack_player(uint32_t mob);
+    bool move_on_floor(const Coord &from, const Coord &to);
    
     /* misc. game methods */
     void read_input(int input);
@@ -92,6 +192,9 @@ class Game{
     std::string print_status_bar();
     Coord coord_from_direction(const Coord &coord, const direction &dir);
     bool is_in_progress() { return this->in_progress; }
+    Profiler &get_profiler() { return this->profiler; }
+    Tracer &get_tracer() { return this->tracer; }
+    void report_profile();
 };
 
 #endif
@@ -0,0 +1,736 @@
+/*************************************************************************
+ * Program Filename: Generator.cpp
+ * Author: David Bacher-Hicks
+ * Date: 19 October 2026
+ * Description: A class definition file for a Generator class. A floor is
+ *              generated from a seed of its own, mixed from the dungeon's
+ *              seed and its level, so the same dungeon is generated
+ *              whichever floors are generated and on whichever threads.
+ *              Every open tile is joined to the region anchors: rooms
+ *              hold their anchor, caves keep only what can be reached
+ *              from theirs, and corridors run from anchor to anchor up
+ *              the partition. Everything carved can therefore be reached
+ *              from the floor's entry once its doors are opened.
+ * Input:  none
+ * Output: floor_N.mp/.dat files, when a floor is exported
+ ************************************************************************/
+
+#include <set>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <cstdlib>
+#include <algorithm>
+#include "Generator.hpp"
+#include "Space.hpp"
+#include "Character.hpp"
+
+/* the partition */
+const int GEN_MIN_REGION = 10;      /* smallest region side */
+const int GEN_MAX_REGION = 28;      /* regions with a longer side are always split */
+const int GEN_CAVE_CHANCE = 25;     /* percent of regions that hold a cave */
+const int GEN_CAVE_FILL = 55;       /* percent of a cave's tiles open to start with */
+const int GEN_CAVE_STEPS = 4;       /* smoothing steps of a cave */
+
+/* doors */
+const int GEN_DOOR_CHANCE = 50;     /* percent of room entrances with a door */
+const int GEN_SECRET_CHANCE = 10;   /* percent of doors that are secret */
+const int GEN_LOCK_CHANCE = 25;     /* percent of doors locked with the floor's key */
+
+/* what lies about */
+const int GEN_TILES_PER_MOB = 150;  /* open tiles to each monster */
+const int GEN_TILES_PER_ITEM = 400; /* open tiles to each item */
+const int GEN_SAFE_RADIUS = 3;      /* tiles around the entry kept free of monsters */
+const int GEN_PICK_TRIES = 200;     /* random tiles tried for a free open tile */
+
+/* salts, so the seeds mixed for stairs and floors differ */
+const unsigned int SALT_STAIR = 1;
+const unsigned int SALT_FLOOR = 2;
+
+/*************************************************************************
+ * Function: Generator
+ * Description: constructor
+ * Parameters: params - the dungeon's size and seed, clamped to the sizes
+ *                      that can be generated
+ *             content - what the dungeon is populated with
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: none
+ ************************************************************************/
+Generator::Generator(const gen_params &params, const gen_content &content)
+{
+  this->params = clamp(params);
+  this->content = content;
+}
+
+
+/*************************************************************************
+ * Function: clamp
+ * Description: clamps a dungeon's size to the sizes that can be generated
+ * Parameters: params - the dungeon's size and seed
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: gen_params - the clamped size, with the same seed
+ ************************************************************************/
+gen_params Generator::clamp(const gen_params &params)
+{
+  gen_params clamped = params;
+
+  clamped.floors = std::min(std::max(params.floors, 0), GEN_MAX_FLOORS);
+  clamped.width = std::min(std::max(params.width, GEN_MIN_SIDE), GEN_MAX_SIDE);
+  clamped.height = std::min(std::max(params.height, GEN_MIN_SIDE), GEN_MAX_SIDE);
+
+  return clamped;
+}
+
+
+/*************************************************************************
+ * Function: floor_id
+ * Description: returns the floor ID of a level, floor001 being the first
+ * Parameters: level - the level, from 0
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: std::string - the floor ID
+ ************************************************************************/
+std::string Generator::floor_id(int level)
+{
+  std::ostringstream id;
+
+  id << "floor" << std::setw(3) << std::setfill('0') << level + 1;
+
+  return id.str();
+}
+
+
+/*************************************************************************
+ * Function: mix
+ * Description: mixes a number and a salt into a seed, so that nearby
+ *              numbers give unrelated seeds
+ * Parameters: seed - the seed
+ *             n - the number
+ *             salt - what the seed is for
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: unsigned int - the mixed seed
+ ************************************************************************/
+unsigned int Generator::mix(unsigned int seed, unsigned int n, unsigned int salt)
+{
+  unsigned int mixed = seed ^ (n * 0x9e3779b9u) ^ (salt * 0x85ebca6bu);
+
+  mixed ^= mixed >> 16;
+  mixed *= 0x7feb352du;
+  mixed ^= mixed >> 15;
+  mixed *= 0x846ca68bu;
+  mixed ^= mixed >> 16;
+
+  return mixed;
+}
+
+
+/*************************************************************************
+ * Function: stair_coord
+ * Description: returns where the stairs between two levels are: the down
+ *              stair of the upper level and the up stair of the lower one
+ *              share it. Even boundaries are in the right half of the
+ *              floor and odd ones in the left, so a floor's two stairs
+ *              never meet, and neither meets the starting tile.
+ * Parameters: boundary - the upper level
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: Coord - the stairs' coordinate, at least 2 tiles from the edge
+ ************************************************************************/
+Coord Generator::stair_coord(int boundary) const
+{
+  unsigned int seed = mix(this->params.seed, boundary, SALT_STAIR);
+  int half = (this->params.width - 4) / 2;
+  int x = 2 + rand_r(&seed) % half + (boundary % 2 == 0 ? half : 0);
+  int y = 2 + rand_r(&seed) % (this->params.height - 4);
+
+  return Coord(x, y);
+}
+
+
+/*************************************************************************
+ * Function: entry_coord
+ * Description: returns where the player first enters a level: its up
+ *              stair, or the starting tile on the first level
+ * Parameters: level - the level
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: Coord - the entry
+ ************************************************************************/
+Coord Generator::entry_coord(int level) const
+{
+  return level == 0 ? STARTING_COORD : this->stair_coord(level - 1);
+}
+
+
+/*************************************************************************
+ * Function: generate
+ * Description: generates a floor of the dungeon: partitions it, carves a
+ *              room or cave in each region and the corridors joining
+ *              them, sets its stairs and doors, and leaves its key,
+ *              items and monsters about it. Deeper floors draw on more
+ *              of the monsters, up to the strongest on the last, which
+ *              also holds the boss.
+ * Parameters: level - the level of the floor, from 0
+ *             floor - set to the floor
+ * Pre-conditions: level is less than the number of floors
+ * Post-conditions: none
+ * Returns: none
+ ************************************************************************/
+void Generator::generate(int level, gen_floor &floor) const
+{
+  unsigned int seed = mix(this->params.seed, level, SALT_FLOOR);
+  bool last = (level == this->params.floors - 1);
+  Coord entry = this->entry_coord(level);
+  Coord coord;
+  std::vector<region> regions;
+  std::vector<Coord> locked;            /* the locked doors */
+  std::vector<uint32_t> reached;        /* tiles reached with the doors locked */
+  std::set<uint32_t> taken;             /* tiles holding a monster */
+  std::string key;
+  gen_object object;
+  size_t open_tiles;
+  int kinds;                            /* how many of the monsters this floor draws on */
+  bool placed;
+
+  floor.id = floor_id(level);
+  floor.width = this->params.width;
+  floor.height = this->params.height;
+  floor.glyphs.assign(static_cast<size_t>(floor.width) * floor.height, WALL_C);
+  floor.objects.clear();
+
+  if (!this->content.keys.empty()) {
+    key = this->content.keys[level % this->content.keys.size()];
+  }
+
+  /* regions, each leaf holding a room or a cave */
+  this->split(regions, &seed);
+  for (size_t i = 0; i < regions.size(); i++) {
+    if (regions[i].children[0] == -1) {
+      if (static_cast<int>(rand_r(&seed) % 100) < GEN_CAVE_CHANCE) {
+        this->carve_cave(floor, regions[i], &seed);
+      } else {
+        this->carve_room(floor, regions[i], &seed);
+      }
+    }
+  }
+
+  /* corridors, from the deepest regions up, so each region's halves have anchors */
+  for (size_t i = regions.size(); i-- > 0;) {
+    if (regions[i].children[0] != -1) {
+      this->carve_corridor(floor, regions[regions[i].children[0]].anchor,
+                           regions[regions[i].children[1]].anchor, &seed);
+      regions[i].anchor = regions[regions[i].children[rand_r(&seed) % 2]].anchor;
+    }
+  }
+
+  /* stairs */
+  this->connect(floor, regions, entry, &seed);
+  object.x2 = object.y2 = 0;
+  if (level > 0) {
+    floor.glyphs[entry.y() * floor.width + entry.x()] = UP_STAIR_C;
+    object.object = "stair";
+    object.x = object.x2 = entry.x();
+    object.y = object.y2 = entry.y();
+    object.target = floor_id(level - 1);
+    floor.objects.push_back(object);
+  }
+  if (!last) {
+    coord = this->stair_coord(level);
+    this->connect(floor, regions, coord, &seed);
+    floor.glyphs[coord.y() * floor.width + coord.x()] = DOWN_STAIR_C;
+    object.object = "stair";
+    object.x = object.x2 = coord.x();
+    object.y = object.y2 = coord.y();
+    object.target = floor_id(level + 1);
+    floor.objects.push_back(object);
+  }
+  object.x2 = object.y2 = 0;
+
+  /*
+   * doors, and the key to the locked ones, somewhere that can be reached
+   * from the entry with them locked. If there is nowhere, none is locked
+   */
+  this->place_doors(floor, entry, key, locked, &seed);
+  if (!locked.empty()) {
+    for (auto i = locked.begin(); i != locked.end(); i++) {
+      floor.glyphs[i->y() * floor.width + i->x()] = WALL_C;
+    }
+    this->reachable(floor, entry, reached);
+    for (auto i = locked.begin(); i != locked.end(); i++) {
+      floor.glyphs[i->y() * floor.width + i->x()] = CLOSED_DOOR_C;
+    }
+
+    placed = false;
+    for (size_t i = 0; i < reached.size() && !placed; i++) {
+      uint32_t tile = reached[(rand_r(&seed) % reached.size() + i) % reached.size()];
+      if (floor.glyphs[tile] == EMPTY_SPACE_C &&
+          !(tile == static_cast<uint32_t>(entry.y() * floor.width + entry.x()))) {
+        object.object = "item";
+        object.x = tile % floor.width;
+        object.y = tile / floor.width;
+        object.target = key;
+        floor.objects.push_back(object);
+        placed = true;
+      }
+    }
+
+    if (placed) {
+      for (auto i = locked.begin(); i != locked.end(); i++) {
+        object.object = "door";
+        object.x = i->x();
+        object.y = i->y();
+        object.target = key;
+        floor.objects.push_back(object);
+      }
+    }
+  }
+
+  /* items and monsters, by how much of the floor is open */
+  open_tiles = std::count(floor.glyphs.begin(), floor.glyphs.end(), EMPTY_SPACE_C);
+
+  for (size_t i = 0; i < open_tiles / GEN_TILES_PER_ITEM && !this->content.loot.empty(); i++) {
+    if (this->pick_open(floor, entry, &seed, coord)) {
+      object.object = "item";
+      object.x = coord.x();
+      object.y = coord.y();
+      object.target = this->content.loot[rand_r(&seed) % this->content.loot.size()];
+      floor.objects.push_back(object);
+    }
+  }
+
+  kinds = 1 + ((level + 1) * (static_cast<int>(this->content.mobs.size()) - 1)) / this->params.floors;
+  for (size_t i = 0; i < open_tiles / GEN_TILES_PER_MOB && !this->content.mobs.empty(); i++) {
+    if (this->pick_open(floor, entry, &seed, coord) &&
+        taken.insert(coord.y() * floor.width + coord.x()).second) {
+      object.object = "mob";
+      object.x = coord.x();
+      object.y = coord.y();
+      object.target = this->content.mobs[rand_r(&seed) % kinds];
+      floor.objects.push_back(object);
+    }
+  }
+
+  /* the boss, on the last floor */
+  placed = this->content.boss.empty() || !last;
+  for (int i = 0; i < GEN_PICK_TRIES && !placed; i++) {
+    if (this->pick_open(floor, entry, &seed, coord) &&
+        taken.insert(coord.y() * floor.width + coord.x()).second) {
+      object.object = "mob";
+      object.x = coord.x();
+      object.y = coord.y();
+      object.target = this->content.boss;
+      floor.objects.push_back(object);
+      placed = true;
+    }
+  }
+}
+
+
+/*************************************************************************
+ * Function: split
+ * Description: partitions the floor inside its outer wall. A region is
+ *              split across its longer side when it is longer than
+ *              GEN_MAX_REGION, and half the time when it is long enough
+ *              to give two regions of at least GEN_MIN_REGION.
+ * Parameters: regions - set to the regions; the first is the whole floor,
+ *                       and each region's halves come after it
+ *             seed - the floor's seed
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: none
+ ************************************************************************/
+void Generator::split(std::vector<region> &regions, unsigned int *seed) const
+{
+  region whole = { 1, 1, this->params.width - 2, this->params.height - 2, { -1, -1 }, Coord(0, 0) };
+  region halves[2];
+  bool across;                          /* split into left and right halves */
+  int side, cut;
+
+  regions.clear();
+  regions.push_back(whole);
+
+  for (size_t i = 0; i < regions.size(); i++) {
+    across = regions[i].width >= regions[i].height;
+    side = across ? regions[i].width : regions[i].height;
+
+    if (side >= 2 * GEN_MIN_REGION && (side > GEN_MAX_REGION || rand_r(seed) % 2 == 0)) {
+      cut = GEN_MIN_REGION + rand_r(seed) % (side - 2 * GEN_MIN_REGION + 1);
+      halves[0] = halves[1] = regions[i];
+      if (across) {
+        halves[0].width = cut;
+        halves[1].x += cut;
+        halves[1].width -= cut;
+      } else {
+        halves[0].height = cut;
+        halves[1].y += cut;
+        halves[1].height -= cut;
+      }
+
+      regions[i].children[0] = regions.size();
+      regions[i].children[1] = regions.size() + 1;
+      regions.push_back(halves[0]);
+      regions.push_back(halves[1]);
+    }
+  }
+}
+
+
+/*************************************************************************
+ * Function: carve_room
+ * Description: carves a room of random size inside a region, leaving a
+ *              wall between it and the region's edge
+ * Parameters: floor - the floor
+ *             leaf - the region; its anchor is set to the room's middle
+ *             seed - the floor's seed
+ * Pre-conditions: the region is at least GEN_MIN_REGION on a side
+ * Post-conditions: the room is open
+ * Returns: none
+ ************************************************************************/
+void Generator::carve_room(gen_floor &floor, region &leaf, unsigned int *seed) const
+{
+  int inner_width = leaf.width - 2, inner_height = leaf.height - 2;
+  int room_width = 3 + rand_r(seed) % (inner_width - 2);
+  int room_height = 3 + rand_r(seed) % (inner_height - 2);
+  int left = leaf.x + 1 + rand_r(seed) % (inner_width - room_width + 1);
+  int top = leaf.y + 1 + rand_r(seed) % (inner_height - room_height + 1);
+
+  for (int y = top; y < top + room_height; y++) {
+    std::fill(floor.glyphs.begin() + y * floor.width + left,
+              floor.glyphs.begin() + y * floor.width + left + room_width, EMPTY_SPACE_C);
+  }
+
+  leaf.anchor = Coord(left + room_width / 2, top + room_height / 2);
+}
+
+
+/*************************************************************************
+ * Function: carve_cave
+ * Description: carves a cave inside a region: its tiles start open at
+ *              random, and are smoothed by a cellular automaton, a tile
+ *              becoming wall when most of its neighbours are. Only what
+ *              can be reached from the region's middle is kept.
+ * Parameters: floor - the floor
+ *             leaf - the region; its anchor is set to its middle
+ *             seed - the floor's seed
+ * Pre-conditions: the region is at least GEN_MIN_REGION on a side
+ * Post-conditions: the cave is open
+ * Returns: none
+ ************************************************************************/
+void Generator::carve_cave(gen_floor &floor, region &leaf, unsigned int *seed) const
+{
+  int inner_width = leaf.width - 2, inner_height = leaf.height - 2;
+  int left = leaf.x + 1, top = leaf.y + 1;
+  int middle = (inner_height / 2) * inner_width + inner_width / 2;
+  std::vector<char> open(inner_width * inner_height), next(inner_width * inner_height);
+  std::vector<char> kept(inner_width * inner_height, 0);
+  std::vector<int> frontier;
+  int walls, tile, x, y;
+
+  for (size_t i = 0; i < open.size(); i++) {
+    open[i] = static_cast<int>(rand_r(seed) % 100) < GEN_CAVE_FILL;
+  }
+
+  /* tiles outside the region count as wall */
+  for (int step = 0; step < GEN_CAVE_STEPS; step++) {
+    for (y = 0; y < inner_height; y++) {
+      for (x = 0; x < inner_width; x++) {
+        walls = 0;
+        for (int dy = -1; dy <= 1; dy++) {
+          for (int dx = -1; dx <= 1; dx++) {
+            if ((dx != 0 || dy != 0) &&
+                (x + dx < 0 || x + dx >= inner_width || y + dy < 0 || y + dy >= inner_height ||
+                 !open[(y + dy) * inner_width + x + dx])) {
+              walls++;
+            }
+          }
+        }
+        next[y * inner_width + x] = walls < 5;
+      }
+    }
+    open.swap(next);
+  }
+
+  /* the middle is always open, and what joins it is kept */
+  for (int dy = -1; dy <= 1; dy++) {
+    for (int dx = -1; dx <= 1; dx++) {
+      open[middle + dy * inner_width + dx] = 1;
+    }
+  }
+
+  kept[middle] = 1;
+  frontier.push_back(middle);
+  while (!frontier.empty()) {
+    tile = frontier.back();
+    frontier.pop_back();
+    x = tile % inner_width;
+    y = tile / inner_width;
+    floor.glyphs[(top + y) * floor.width + left + x] = EMPTY_SPACE_C;
+
+    const int neighbours[4][3] = { { x > 0, -1, 0 }, { x + 1 < inner_width, 1, 0 },
+                                   { y > 0, 0, -1 }, { y + 1 < inner_height, 0, 1 } };
+    for (int i = 0; i < 4; i++) {
+      tile = (y + neighbours[i][2]) * inner_width + x + neighbours[i][1];
+      if (neighbours[i][0] && open[tile] && !kept[tile]) {
+        kept[tile] = 1;
+        frontier.push_back(tile);
+      }
+    }
+  }
+
+  leaf.anchor = Coord(left + inner_width / 2, top + inner_height / 2);
+}
+
+
+/*************************************************************************
+ * Function: carve_corridor
+ * Description: carves a corridor between two tiles, along one axis and
+ *              then the other, leaving anything already open as it is
+ * Parameters: floor - the floor
+ *             from, to - the ends of the corridor
+ *             seed - the floor's seed, choosing which axis is first
+ * Pre-conditions: both ends are inside the floor's outer wall
+ * Post-conditions: the corridor is open
+ * Returns: none
+ ************************************************************************/
+void Generator::carve_corridor(gen_floor &floor, const Coord &from, const Coord &to,
+                               unsigned int *seed) const
+{
+  Coord corner = (rand_r(seed) % 2 == 0) ? Coord(to.x(), from.y()) : Coord(from.x(), to.y());
+  const Coord *legs[2][2] = { { &from, &corner }, { &corner, &to } };
+  int x, y, step_x, step_y;
+  char *tile;
+
+  for (int i = 0; i < 2; i++) {
+    x = legs[i][0]->x();
+    y = legs[i][0]->y();
+    step_x = (legs[i][1]->x() > x) - (legs[i][1]->x() < x);
+    step_y = (legs[i][1]->y() > y) - (legs[i][1]->y() < y);
+
+    while (true) {
+      tile = &floor.glyphs[y * floor.width + x];
+      if (*tile == WALL_C) {
+        *tile = EMPTY_SPACE_C;
+      }
+      if (x == legs[i][1]->x() && y == legs[i][1]->y()) {
+        break;
+      }
+      x += step_x;
+      y += step_y;
+    }
+  }
+}
+
+
+/*************************************************************************
+ * Function: connect
+ * Description: opens a tile and carves a corridor from it to the anchor
+ *              of the leaf region holding it
+ * Parameters: floor - the floor
+ *             regions - the floor's regions, with their anchors
+ *             coord - the tile
+ *             seed - the floor's seed
+ * Pre-conditions: the tile is inside the floor's outer wall
+ * Post-conditions: the tile is joined to the rest of the floor
+ * Returns: none
+ ************************************************************************/
+void Generator::connect(gen_floor &floor, const std::vector<region> &regions, const Coord &coord,
+                        unsigned int *seed) const
+{
+  const region *leaf = &regions[0];
+  const region *half;
+
+  while (leaf->children[0] != -1) {
+    half = &regions[leaf->children[1]];
+    if (coord.x() >= half->x && coord.y() >= half->y) {
+      leaf = half;
+    } else {
+      leaf = &regions[leaf->children[0]];
+    }
+  }
+
+  this->carve_corridor(floor, coord, leaf->anchor, seed);
+}
+
+
+/*************************************************************************
+ * Function: place_doors
+ * Description: sets doors where a one tile passage opens into a room or
+ *              cave, never two side by side. Some are secret, and some of
+ *              the rest are locked with the floor's key.
+ * Parameters: floor - the floor
+ *             entry - the floor's entry, never a door
+ *             key - the floor's key, or "" to lock no doors
+ *             locked - set to the locked doors
+ *             seed - the floor's seed
+ * Pre-conditions: the floor is carved
+ * Post-conditions: none
+ * Returns: none
+ ************************************************************************/
+void Generator::place_doors(gen_floor &floor, const Coord &entry, const std::string &key,
+                            std::vector<Coord> &locked, unsigned int *seed) const
+{
+  const std::vector<char> &glyphs = floor.glyphs;
+  int width = floor.width;
+  int tile, sides[2], open_around;
+  bool passage, into_room;
+
+  locked.clear();
+
+  for (int y = 1; y < floor.height - 1; y++) {
+    for (int x = 1; x < width - 1; x++) {
+      tile = y * width + x;
+
+      /* open on two opposite sides and walled on the others, and not by a door */
+      passage = false;
+      if (glyphs[tile] == EMPTY_SPACE_C && !(x == entry.x() && y == entry.y()) &&
+          glyphs[tile - 1] != CLOSED_DOOR_C && glyphs[tile - 1] != HIDDEN_DOOR_C &&
+          glyphs[tile - width] != CLOSED_DOOR_C && glyphs[tile - width] != HIDDEN_DOOR_C) {
+        if (glyphs[tile - width] == WALL_C && glyphs[tile + width] == WALL_C &&
+            glyphs[tile - 1] != WALL_C && glyphs[tile + 1] != WALL_C) {
+          sides[0] = tile - 1;
+          sides[1] = tile + 1;
+          passage = true;
+        } else if (glyphs[tile - 1] == WALL_C && glyphs[tile + 1] == WALL_C &&
+                   glyphs[tile - width] != WALL_C && glyphs[tile + width] != WALL_C) {
+          sides[0] = tile - width;
+          sides[1] = tile + width;
+          passage = true;
+        }
+      }
+
+      /* that opens into a room or cave on one side */
+      into_room = false;
+      for (int i = 0; i < 2 && passage && !into_room; i++) {
+        open_around = 0;
+        for (int dy = -1; dy <= 1; dy++) {
+          for (int dx = -1; dx <= 1; dx++) {
+            open_around += (glyphs[sides[i] + dy * width + dx] != WALL_C);
+          }
+        }
+        into_room = (open_around >= 6);
+      }
+
+      if (into_room && static_cast<int>(rand_r(seed) % 100) < GEN_DOOR_CHANCE) {
+        if (static_cast<int>(rand_r(seed) % 100) < GEN_SECRET_CHANCE) {
+          floor.glyphs[tile] = HIDDEN_DOOR_C;
+        } else {
+          floor.glyphs[tile] = CLOSED_DOOR_C;
+          if (!key.empty() && static_cast<int>(rand_r(seed) % 100) < GEN_LOCK_CHANCE) {
+            locked.push_back(Coord(x, y));
+          }
+        }
+      }
+    }
+  }
+}
+
+
+/*************************************************************************
+ * Function: reachable
+ * Description: finds every tile that can be reached from a tile without
+ *              passing through a wall
+ * Parameters: floor - the floor
+ *             from - the tile
+ *             reached - set to the index of each tile reached
+ * Pre-conditions: the tile is open
+ * Post-conditions: none
+ * Returns: none
+ ************************************************************************/
+void Generator::reachable(const gen_floor &floor, const Coord &from, std::vector<uint32_t> &reached) const
+{
+  std::vector<bool> seen(floor.glyphs.size(), false);
+  const int steps[4] = { -1, 1, -floor.width, floor.width };
+  uint32_t tile, next;
+
+  reached.clear();
+  tile = from.y() * floor.width + from.x();
+  seen[tile] = true;
+  reached.push_back(tile);
+
+  /* the reached tiles are also the queue; the outer wall keeps every step inside */
+  for (size_t i = 0; i < reached.size(); i++) {
+    tile = reached[i];
+    for (int j = 0; j < 4; j++) {
+      next = tile + steps[j];
+      if (!seen[next] && floor.glyphs[next] != WALL_C) {
+        seen[next] = true;
+        reached.push_back(next);
+      }
+    }
+  }
+}
+
+
+/*************************************************************************
+ * Function: pick_open
+ * Description: picks an open tile at random, away from the entry
+ * Parameters: floor - the floor
+ *             entry - the floor's entry
+ *             seed - the floor's seed
+ *             coord - set to the tile
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: bool - false if none was found in GEN_PICK_TRIES tries
+ ************************************************************************/
+bool Generator::pick_open(const gen_floor &floor, const Coord &entry, unsigned int *seed,
+                          Coord &coord) const
+{
+  bool picked = false;
+  int x, y;
+
+  for (int i = 0; i < GEN_PICK_TRIES && !picked; i++) {
+    x = 1 + rand_r(seed) % (floor.width - 2);
+    y = 1 + rand_r(seed) % (floor.height - 2);
+    if (floor.glyphs[y * floor.width + x] == EMPTY_SPACE_C &&
+        (abs(x - entry.x()) > GEN_SAFE_RADIUS || abs(y - entry.y()) > GEN_SAFE_RADIUS)) {
+      coord = Coord(x, y);
+      picked = true;
+    }
+  }
+
+  return picked;
+}
+
+
+/*************************************************************************
+ * Function: export_floor
+ * Description: writes a generated floor as a layout file and a data file,
+ *              as the shipped floors are written
+ * Parameters: floor - the floor
+ *             mp_path - the path of the layout file
+ *             dat_path - the path of the data file
+ * Pre-conditions: none
+ * Post-conditions: the files hold the floor
+ * Returns: bool - true if both files were written
+ ************************************************************************/
+bool Generator::export_floor(const gen_floor &floor, const std::string &mp_path,
+                             const std::string &dat_path)
+{
+  std::ofstream layout(mp_path.c_str(), std::ios::binary);
+  std::ofstream data(dat_path.c_str());
+
+  for (int y = 0; y < floor.height && layout; y++) {
+    layout.write(&floor.glyphs[y * floor.width], floor.width);
+    layout << '\n';
+  }
+
+  data << floor.id << '\n';
+  for (auto i = floor.objects.begin(); i != floor.objects.end() && data; i++) {
+    data << i->object << ' ' << i->x << ' ' << i->y;
+    if (!i->target.empty()) {
+      data << ' ' << i->target;
+    }
+    if (i->object == "stair") {
+      data << ' ' << i->x2 << ' ' << i->y2;
+    }
+    data << '\n';
+  }
+
+  layout.close();
+  data.close();
+
+  return !layout.fail() && !data.fail();
+}
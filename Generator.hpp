@@ -0,0 +1,103 @@
+/*************************************************************************
+ * Program Filename: Generator.hpp
+ * Author: David Bacher-Hicks
+ * Date: 19 October 2026
+ * Description: A class declaration file for a Generator class, which
+ *              generates the floors of a dungeon from a seed. Each floor
+ *              is split into regions by binary space partitioning; each
+ *              region holds a room or a cellular cave, and the regions
+ *              are joined by corridors. Doors are set where corridors
+ *              meet rooms, some locked with the floor's key, which is
+ *              always left where it can be reached without passing a
+ *              locked door. The stair between two floors is at a point
+ *              derived from the seed alone, so every floor can be
+ *              generated on its own, in any order or at once.
+ * Input:  none
+ * Output: floor_N.mp/.dat files, when a floor is exported
+ ************************************************************************/
+
+#ifndef GENERATOR_HPP
+#define GENERATOR_HPP
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "Coord.hpp"
+
+/* the size and seed of a generated dungeon */
+struct gen_params {
+  int floors;                       /* how many floors, or 0 for none */
+  int width;
+  int height;
+  unsigned int seed;
+};
+
+const gen_params NO_DUNGEON = { 0, 0, 0, 0 };
+const int GEN_MIN_SIDE = 24;        /* smallest floor side generated */
+const int GEN_MAX_SIDE = 8192;      /* largest floor side generated */
+const int GEN_MAX_FLOORS = 999;     /* floor IDs have three digits */
+const std::string GEN_KEY_PREFIX = "key_";  /* the ID prefix of items that are keys */
+
+/* what a generated dungeon is populated with */
+struct gen_content {
+  std::vector<std::string> mobs;    /* monster IDs, weakest first */
+  std::vector<std::string> loot;    /* IDs of items left lying about */
+  std::vector<std::string> keys;    /* key item IDs, each floor taking the next */
+  std::string boss;                 /* monster left on the last floor, or "" */
+};
+
+/* an object on a generated floor, with the fields of a .dat record */
+struct gen_object {
+  std::string object;               /* door, stair, item or mob */
+  int x, y;
+  std::string target;               /* key, linked floor, item or monster ID */
+  int x2, y2;                       /* a stair's linked coordinate */
+};
+
+/* a generated floor: its layout grid, as a Layout's, and its objects */
+struct gen_floor {
+  std::string id;
+  int width;
+  int height;
+  std::vector<char> glyphs;
+  std::vector<gen_object> objects;
+};
+
+class Generator {
+  private:
+    /* a region of the partition: a leaf holds a room or cave */
+    struct region {
+      int x, y, width, height;
+      int children[2];              /* indices of the halves, or -1 for a leaf */
+      Coord anchor;                 /* an open tile every corridor to it meets */
+    };
+
+    gen_params params;
+    gen_content content;
+
+    static unsigned int mix(unsigned int seed, unsigned int n, unsigned int salt);
+    void split(std::vector<region> &regions, unsigned int *seed) const;
+    void carve_room(gen_floor &floor, region &leaf, unsigned int *seed) const;
+    void carve_cave(gen_floor &floor, region &leaf, unsigned int *seed) const;
+    void carve_corridor(gen_floor &floor, const Coord &from, const Coord &to,
+                        unsigned int *seed) const;
+    void connect(gen_floor &floor, const std::vector<region> &regions, const Coord &coord,
+                 unsigned int *seed) const;
+    void place_doors(gen_floor &floor, const Coord &entry, const std::string &key,
+                     std::vector<Coord> &locked, unsigned int *seed) const;
+    void reachable(const gen_floor &floor, const Coord &from, std::vector<uint32_t> &reached) const;
+    bool pick_open(const gen_floor &floor, const Coord &entry, unsigned int *seed, Coord &coord) const;
+
+  public:
+    Generator(const gen_params &params, const gen_content &content);
+
+    static gen_params clamp(const gen_params &params);
+    static std::string floor_id(int level);
+    Coord stair_coord(int boundary) const;
+    Coord entry_coord(int level) const;
+    void generate(int level, gen_floor &floor) const;
+    static bool export_floor(const gen_floor &floor, const std::string &mp_path,
+                             const std::string &dat_path);
+};
+
+#endif
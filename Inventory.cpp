@@ -0,0 +1,159 @@
+/*************************************************************************
+ * Program Filename: Inventory.cpp
+ * Author: David Bacher-Hicks
+ * Date: 19 October 2026
+ * Description: A class definition file for an Inventory class. Removing
+ *              the last of a kind of item closes the gap its entry leaves,
+ *              keeping the order of the rest.
+ * Input:  none
+ * Output: none
+ ************************************************************************/
+
+#include "Inventory.hpp"
+#include "Item.hpp"
+
+/*************************************************************************
+ * Function: Inventory
+ * Description: constructor; the inventory starts empty
+ * Parameters: none
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: none
+ ************************************************************************/
+Inventory::Inventory()
+{
+  this->n_entries = 0;
+  this->weight = 0;
+}
+
+
+/*************************************************************************
+ * Function: find
+ * Description: finds the entry of a kind of item
+ * Parameters: item - the item
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: int - the entry's index, or NO_ID if none is carried
+ ************************************************************************/
+int Inventory::find(Item *item) const
+{
+  int index = NO_ID;
+
+  for (int i = 0; i < this->n_entries && index == NO_ID; i++) {
+    if (this->at(i).item == item) {
+      index = i;
+    }
+  }
+
+  return index;
+}
+
+
+/*************************************************************************
+ * Function: count
+ * Description: counts the items of a kind carried
+ * Parameters: item - the item
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: int - how many are carried
+ ************************************************************************/
+int Inventory::count(Item *item) const
+{
+  int index = this->find(item);
+
+  return index == NO_ID ? 0 : this->at(index).count;
+}
+
+
+/*************************************************************************
+ * Function: add
+ * Description: adds an item, in a new entry at the end if none of its
+ *              kind is carried
+ * Parameters: item - the item to add
+ * Pre-conditions: none
+ * Post-conditions: the item and its weight are carried
+ * Returns: none
+ ************************************************************************/
+void Inventory::add(Item *item)
+{
+  int index = this->find(item);
+  inventory_entry added = { item, 1 };
+
+  if (index != NO_ID) {
+    this->entry(index).count++;
+  } else if (this->n_entries < INVENTORY_INLINE) {
+    this->inline_entries[this->n_entries++] = added;
+  } else {
+    this->more_entries.push_back(added);
+    this->n_entries++;
+  }
+
+  this->weight += item->weight();
+}
+
+
+/*************************************************************************
+ * Function: remove
+ * Description: removes an item, and its entry if it was the last of its
+ *              kind
+ * Parameters: item - the item to remove
+ * Pre-conditions: none
+ * Post-conditions: the item may have been removed
+ * Returns: bool - true if the item was carried and removed
+ ************************************************************************/
+bool Inventory::remove(Item *item)
+{
+  int index = this->find(item);
+
+  if (index != NO_ID) {
+    if (--this->entry(index).count == 0) {
+      for (int i = index; i + 1 < this->n_entries; i++) {
+        this->entry(i) = this->entry(i + 1);
+      }
+      if (this->n_entries > INVENTORY_INLINE) {
+        this->more_entries.pop_back();
+      }
+      this->n_entries--;
+    }
+
+    /* an empty inventory weighs nothing, whatever rounding built up */
+    this->weight = (this->n_entries == 0) ? 0 : this->weight - item->weight();
+  }
+
+  return index != NO_ID;
+}
+
+
+/*************************************************************************
+ * Function: clear
+ * Description: removes every item
+ * Parameters: none
+ * Pre-conditions: none
+ * Post-conditions: the inventory is empty
+ * Returns: none
+ ************************************************************************/
+void Inventory::clear()
+{
+  this->more_entries.clear();
+  this->n_entries = 0;
+  this->weight = 0;
+}
+
+
+/*************************************************************************
+ * Function: reweigh
+ * Description: totals the weight carried again, after the weight of an
+ *              item carried was changed
+ * Parameters: none
+ * Pre-conditions: none
+ * Post-conditions: the weight matches the items' weights
+ * Returns: none
+ ************************************************************************/
+void Inventory::reweigh()
+{
+  this->weight = 0;
+
+  for (int i = 0; i < this->n_entries; i++) {
+    this->weight += this->at(i).item->weight() * this->at(i).count;
+  }
+}
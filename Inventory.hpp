@@ -0,0 +1,58 @@
+/*************************************************************************
+ * Program Filename: Inventory.hpp
+ * Author: David Bacher-Hicks
+ * Date: 19 October 2026
+ * Description: A class declaration file for an Inventory class, the items
+ *              a character carries. Each kind of item carried is an entry
+ *              of the item and a count, kept in the order the kind was
+ *              first picked up, so entries can be shown and chosen by
+ *              index. The first entries are held inline, the rest in a
+ *              vector. The total weight carried is kept as items are
+ *              added and removed, so checking it costs nothing.
+ * Input:  none
+ * Output: none
+ ************************************************************************/
+
+#ifndef INVENTORY_HPP
+#define INVENTORY_HPP
+
+#include <vector>
+#include "NameTable.hpp"
+
+class Item;
+
+const int INVENTORY_INLINE = 8;     /* entries held without allocating */
+
+/* a kind of item carried, and how many */
+struct inventory_entry {
+  Item *item;
+  int count;
+};
+
+class Inventory {
+  private:
+    inventory_entry inline_entries[INVENTORY_INLINE];
+    std::vector<inventory_entry> more_entries;   /* entries past the inline ones */
+    int n_entries;
+    double weight;                  /* total weight of every item carried */
+
+    inventory_entry &entry(int index)
+      { return index < INVENTORY_INLINE ? this->inline_entries[index] : this->more_entries[index - INVENTORY_INLINE]; }
+
+  public:
+    Inventory();
+
+    int size() const { return this->n_entries; }
+    const inventory_entry &at(int index) const
+      { return index < INVENTORY_INLINE ? this->inline_entries[index] : this->more_entries[index - INVENTORY_INLINE]; }
+    int find(Item *item) const;
+    int count(Item *item) const;
+    double get_weight() const { return this->weight; }
+
+    void add(Item *item);
+    bool remove(Item *item);
+    void clear();
+    void reweigh();
+};
+
+#endif
@@ -17,6 +17,7 @@
  *             item_description - a brief description of the item
  *             item_weight - weight of the item (lbs)
  *             item_value - value of the item
+ *             kind - the kind of item, given by a subclass
  *
  * Pre-conditions: none
  * Post-conditions: none
@@ -26,12 +27,129 @@ Item::Item(std::string item_ID,
            std::string item_name,
            std::string item_description,
            double item_weight,
-           double item_value)
+           double item_value,
+           item_kind kind)
 {
+  this->kind = kind;
   this->item_ID = item_ID;
+  this->item_num = NO_ID;
   this->item_name = item_name;
   this->item_description = item_description;
   this->item_weight = item_weight;
   this->item_value = item_value;
   this->is_passable = true;
 }
+
+
+/*************************************************************************
+ * Function: same_as
+ * Description: compares an item with another, such as the same item read
+ *              again from a changed table
+ * Parameters: other - the other item
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: bool - true if both are the same kind of item with the same
+ *          stats
+ ************************************************************************/
+bool Item::same_as(Item *other)
+{
+  return this->kind == other->kind &&
+         this->item_name == other->item_name &&
+         this->item_description == other->item_description &&
+         this->item_weight == other->item_weight &&
+         this->item_value == other->item_value;
+}
+
+
+/*************************************************************************
+ * Function: update
+ * Description: takes the stats of another item of the same kind. The item
+ *              keeps its ID and number, so everything that holds it sees
+ *              the new stats.
+ * Parameters: from - the item to take the stats of
+ * Pre-conditions: none
+ * Post-conditions: the item may have been updated
+ * Returns: bool - true if the items are the same kind and it was updated
+ ************************************************************************/
+bool Item::update(Item *from)
+{
+  bool same_kind = (this->kind == from->kind);
+
+  if (same_kind) {
+    this->item_name = from->item_name;
+    this->item_description = from->item_description;
+    this->item_weight = from->item_weight;
+    this->item_value = from->item_value;
+  }
+
+  return same_kind;
+}
+
+
+/*************************************************************************
+ * Function: Weapon::same_as
+ * Description: as Item::same_as, also comparing the damage die
+ * Parameters: other - the other item
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: bool - true if both are weapons with the same stats
+ ************************************************************************/
+bool Weapon::same_as(Item *other)
+{
+  return Item::same_as(other) && 
+         this->damage_die == static_cast<Weapon *>(other)->damage_die;
+}
+
+
+/*************************************************************************
+ * Function: Weapon::update
+ * Description: as Item::update, also taking the damage die
+ * Parameters: from - the item to take the stats of
+ * Pre-conditions: none
+ * Post-conditions: the item may have been updated
+ * Returns: bool - true if both are weapons and it was updated
+ ************************************************************************/
+bool Weapon::update(Item *from)
+{
+  bool updated = Item::update(from);
+
+  if (updated) {
+    this->damage_die = static_cast<Weapon *>(from)->damage_die;
+  }
+
+  return updated;
+}
+
+
+/*************************************************************************
+ * Function: Armor::same_as
+ * Description: as Item::same_as, also comparing the armor class
+ * Parameters: other - the other item
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: bool - true if both are armor with the same stats
+ ************************************************************************/
+bool Armor::same_as(Item *other)
+{
+  return Item::same_as(other) && this->AC == static_cast<Armor *>(other)->AC;
+}
+
+
+/*************************************************************************
+ * Function: Armor::update
+ * Description: as Item::update, also taking the armor class
+ * Parameters: from - the item to take the stats of
+ * Pre-conditions: none
+ * Post-conditions: the item may have been updated
+ * Returns: bool - true if both are armor and it was updated
+ ************************************************************************/
+bool Armor::update(Item *from)
+{
+  bool updated = Item::update(from);
+
+  if (updated) {
+    this->AC = static_cast<Armor *>(from)->AC;
+  }
+
+  return updated;
+}
@@ -12,6 +12,10 @@
 
 #include <string>
 #include "Die.hpp"
+#include "NameTable.hpp"
+
+/* the kinds of item, telling items apart without RTTI */
+enum item_kind { ITEM_GENERIC, ITEM_WEAPON, ITEM_ARMOR };
 
         //////////////////////////////////////////////////////////
        //                    Item                              //
@@ -19,8 +23,10 @@
 
 class Item {
   private:
+    item_kind   kind;
     bool        is_passable;
     std::string item_ID;
+    int         item_num;       /* dense item number, set once loaded */
     std::string item_name;
     std::string item_description;
     double      item_weight;
@@ -31,15 +37,23 @@ class Item {
          std::string item_name, 
          std::string item_description, 
          double item_weight,
-         double item_value);
+         double item_value,
+         item_kind kind = ITEM_GENERIC);
     virtual ~Item() {}
 
+    item_kind get_kind() const { return this->kind; }
+    bool equippable() const { return this->kind == ITEM_WEAPON || this->kind == ITEM_ARMOR; }
+
     bool passable()     { return true; }
-    std::string id()    { return this->item_ID; }
+    const std::string &id() { return this->item_ID; }
+    int num()           { return this->item_num; }
+    void set_num(int num) { this->item_num = num; }
     std::string description() { return this->item_description; }
     std::string name()  { return this->item_name; }
     double weight()     { return this->item_weight; }
     double value()      { return this->item_value; }
+    virtual bool same_as(Item *other);
+    virtual bool update(Item *from);
 //    virtual void ignore_me() {} 
 };
 
@@ -50,7 +64,7 @@ class Item {
 
 class Weapon : public Item {
   private:
-    Die *damage_die;
+    Die damage_die;
 
   public:
     Weapon(std::string item_ID, 
@@ -61,10 +75,11 @@ class Weapon : public Item {
            int damage_die_num,
            int damage_die_sides,
            int damage_die_mod) : 
-      Item(item_ID, item_name, item_description, item_weight, item_value)
-      { this->damage_die = new Die(damage_die_num, damage_die_sides, damage_die_mod); }   
-    virtual ~Weapon() { delete this->damage_die; }
-    int roll_damage() { return this->damage_die->roll(); }
+      Item(item_ID, item_name, item_description, item_weight, item_value, ITEM_WEAPON),
+      damage_die(damage_die_num, damage_die_sides, damage_die_mod) {}
+    int roll_damage() { return this->damage_die.roll(); }
+    virtual bool same_as(Item *other);
+    virtual bool update(Item *from);
 
 };
 
@@ -83,9 +98,11 @@ class Armor : public Item {
            double item_weight,
            double item_value,
            int AC) : 
-      Item(item_ID, item_name, item_description, item_weight, item_value)
+      Item(item_ID, item_name, item_description, item_weight, item_value, ITEM_ARMOR)
       { this->AC = AC; }
       int get_ac() { return this->AC; }
+      virtual bool same_as(Item *other);
+      virtual bool update(Item *from);
 };
 
 #endif
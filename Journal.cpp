@@ -0,0 +1,314 @@
+/*************************************************************************
+ * Program Filename: Journal.cpp
+ * Author: David Bacher-Hicks
+ * Date: 19 October 2026
+ * Description: A class definition file for a Journal class. Records are
+ *              buffered in memory by the game thread and written by a
+ *              flusher thread, which syncs them to disk in groups, either
+ *              once enough records are waiting or once the oldest has
+ *              waited long enough. The game thread never waits on disk.
+ *
+ *              The journal is split into generations, one file each. Each
+ *              snapshot starts a new generation, so a save plus the files
+ *              from its generation onward describe the current game.
+ * Input:  none
+ * Output: journal files
+ ************************************************************************/
+
+#include <chrono>
+#include <cstdlib>
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+#include "Journal.hpp"
+
+/*************************************************************************
+ * Function: Journal
+ * Description: constructor
+ * Parameters: path - the path prefix of the journal files; generation n
+ *                    is written to "<path>.<n>"
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: none
+ ************************************************************************/
+Journal::Journal(std::string path)
+{
+  this->path = path;
+  this->gen = 0;
+  this->gen_records = 0;
+  this->pruned_below = 0;
+  this->queued_records = 0;
+  this->running = false;
+}
+
+
+/*************************************************************************
+ * Function: ~Journal
+ * Description: destructor; flushes any buffered records
+ * Parameters: none
+ * Pre-conditions: none
+ * Post-conditions: the flusher will have been stopped
+ * Returns: none
+ ************************************************************************/
+Journal::~Journal()
+{
+  this->stop();
+}
+
+
+/*************************************************************************
+ * Function: start
+ * Description: starts appending to generation gen and starts the flusher
+ * Parameters: gen - the generation to append to
+ * Pre-conditions: none
+ * Post-conditions: the journal is open
+ * Returns: none
+ ************************************************************************/
+void Journal::start(int gen)
+{
+  if (!this->running) {
+    this->gen = gen;
+    this->gen_records = 0;
+    this->pruned_below = 0;
+    this->queue.push_back(batch());
+    this->queue.back().gen = gen;
+    this->running = true;
+    this->flusher = std::thread(&Journal::flush_loop, this);
+  }
+}
+
+
+/*************************************************************************
+ * Function: stop
+ * Description: stops the flusher once it has written all queued records
+ * Parameters: none
+ * Pre-conditions: none
+ * Post-conditions: the journal is closed
+ * Returns: none
+ ************************************************************************/
+void Journal::stop()
+{
+  if (this->running) {
+    {
+      std::lock_guard<std::mutex> guard(this->lock);
+      this->running = false;
+    }
+    this->wake.notify_one();
+    this->flusher.join();
+  }
+}
+
+
+/*************************************************************************
+ * Function: record
+ * Description: appends an event record to the current generation
+ * Parameters: event - the record, without a trailing newline
+ * Pre-conditions: none
+ * Post-conditions: the record is queued for the flusher
+ * Returns: none
+ ************************************************************************/
+void Journal::record(const std::string &event)
+{
+  bool full = false;
+
+  if (this->running) {
+    {
+      std::lock_guard<std::mutex> guard(this->lock);
+      if (this->queue.empty() || this->queue.back().gen != this->gen) {
+        this->queue.push_back(batch());
+        this->queue.back().gen = this->gen;
+      }
+      this->queue.back().records += event;
+      this->queue.back().records += '\n';
+      full = (++this->queued_records >= JOURNAL_GROUP_RECORDS);
+    }
+    this->gen_records++;
+
+    if (full) {
+      this->wake.notify_one();
+    }
+  }
+}
+
+
+/*************************************************************************
+ * Function: rotate
+ * Description: starts a new generation. Called just before a snapshot is
+ *              taken, so that the snapshot covers every record of the
+ *              earlier generations.
+ * Parameters: none
+ * Pre-conditions: none
+ * Post-conditions: new records go to the next generation
+ * Returns: int - the new generation
+ ************************************************************************/
+int Journal::rotate()
+{
+  if (this->running) {
+    {
+      std::lock_guard<std::mutex> guard(this->lock);
+      this->gen++;
+      this->queue.push_back(batch());
+      this->queue.back().gen = this->gen;
+    }
+    this->wake.notify_one();
+  } else {
+    this->gen++;
+  }
+  this->gen_records = 0;
+
+  return this->gen;
+}
+
+
+/*************************************************************************
+ * Function: flush_loop
+ * Description: the flusher thread. Waits for a group of records (or for 
+ *              the group timeout), takes the queue, and writes it to the 
+ *              generation files with one fdatasync per file.
+ * Parameters: none
+ * Pre-conditions: none
+ * Post-conditions: all queued records are on disk when the loop ends
+ * Returns: none
+ ************************************************************************/
+void Journal::flush_loop()
+{
+  std::vector<batch> batches;
+  int fd = -1,
+      fd_gen = -1;
+  bool stopping = false;
+
+  while (!stopping) {
+    {
+      std::unique_lock<std::mutex> guard(this->lock);
+      this->wake.wait_for(guard, std::chrono::milliseconds(JOURNAL_GROUP_MS));
+      batches.swap(this->queue);
+      this->queued_records = 0;
+      stopping = !this->running;
+    }
+
+    for (auto i = batches.begin(); i != batches.end(); i++) {
+      /* a new generation closes out the previous file */
+      if (i->gen != fd_gen) {
+        if (fd != -1) {
+          fdatasync(fd);
+          close(fd);
+        }
+        fd = open(this->gen_path(i->gen).c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+        fd_gen = i->gen;
+      }
+
+      size_t offset = 0;
+      ssize_t n = 0;
+      while (fd != -1 && offset < i->records.size() &&
+             (n = write(fd, i->records.data() + offset, i->records.size() - offset)) > 0) {
+        offset += n;
+      }
+    }
+
+    if (fd != -1 && !batches.empty()) {
+      fdatasync(fd);
+    }
+    batches.clear();
+  }
+
+  if (fd != -1) {
+    close(fd);
+  }
+}
+
+
+/*************************************************************************
+ * Function: gen_path
+ * Description: returns the path of a generation's journal file
+ * Parameters: gen - the generation
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: std::string - the path
+ ************************************************************************/
+std::string Journal::gen_path(int gen)
+{
+  return this->path + '.' + std::to_string(gen);
+}
+
+
+/*************************************************************************
+ * Function: list_generations
+ * Description: lists the generations that have a journal file on disk
+ * Parameters: gens - a vector to hold the generations found
+ * Pre-conditions: none
+ * Post-conditions: gens holds the generations found
+ * Returns: none
+ ************************************************************************/
+void Journal::list_generations(std::vector<int> &gens)
+{
+  std::string dir_path = ".",
+              prefix = this->path + '.';
+  size_t slash = this->path.rfind('/');
+  DIR *dir;
+  struct dirent *entry;
+  std::string name;
+  char *end;
+
+  if (slash != std::string::npos) {
+    dir_path = this->path.substr(0, slash);
+    prefix = this->path.substr(slash + 1) + '.';
+  }
+
+  if ((dir = opendir(dir_path.c_str())) != NULL) {
+    while ((entry = readdir(dir)) != NULL) {
+      name = entry->d_name;
+      if (name.compare(0, prefix.size(), prefix) == 0 && name.size() > prefix.size()) {
+        long gen = strtol(name.c_str() + prefix.size(), &end, 10);
+        if (*end == '\0') {
+          gens.push_back(static_cast<int>(gen));
+        }
+      }
+    }
+    closedir(dir);
+  }
+}
+
+
+/*************************************************************************
+ * Function: prune
+ * Description: deletes the journal files of generations older than gen,
+ *              once a snapshot covering them has been written
+ * Parameters: gen - the oldest generation to keep
+ * Pre-conditions: none
+ * Post-conditions: older journal files will have been deleted
+ * Returns: none
+ ************************************************************************/
+void Journal::prune(int gen)
+{
+  std::vector<int> gens;
+
+  if (gen > this->pruned_below) {
+    this->list_generations(gens);
+    for (auto i = gens.begin(); i != gens.end(); i++) {
+      if (*i < gen) {
+        unlink(this->gen_path(*i).c_str());
+      }
+    }
+    this->pruned_below = gen;
+  }
+}
+
+
+/*************************************************************************
+ * Function: discard
+ * Description: closes the journal and deletes every journal file
+ * Parameters: none
+ * Pre-conditions: none
+ * Post-conditions: no journal files remain
+ * Returns: none
+ ************************************************************************/
+void Journal::discard()
+{
+  std::vector<int> gens;
+
+  this->stop();
+  this->list_generations(gens);
+  for (auto i = gens.begin(); i != gens.end(); i++) {
+    unlink(this->gen_path(*i).c_str());
+  }
+}
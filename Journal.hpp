@@ -0,0 +1,66 @@
+/*************************************************************************
+ * Program Filename: Journal.hpp
+ * Author: David Bacher-Hicks
+ * Date: 19 October 2026
+ * Description: A class declaration file for a Journal class. The journal
+ *              is an append-only log of the game events applied since the
+ *              last snapshot, used to recover the game after a crash.
+ * Input:  none
+ * Output: journal files
+ ************************************************************************/
+
+#ifndef JOURNAL_HPP
+#define JOURNAL_HPP
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+/* group commit thresholds */
+const int JOURNAL_GROUP_RECORDS = 64;   /* records buffered before a flush is forced */
+const int JOURNAL_GROUP_MS      = 250;  /* longest a record waits to be flushed */
+
+class Journal {
+  private:
+    /* a run of records belonging to one journal generation */
+    struct batch {
+      int gen;
+      std::string records;
+    };
+
+    std::string path;           /* path prefix of the journal files */
+    int gen;                    /* generation new records are appended to */
+    int gen_records;            /* records appended to the current generation */
+    int pruned_below;           /* generations below this have been deleted */
+
+    std::vector<batch> queue;   /* records waiting for the flusher */
+    int queued_records;         /* records in the queue */
+    bool running;               /* whether the flusher should keep running */
+    std::mutex lock;            /* guards queue, queued_records and running */
+    std::condition_variable wake;
+    std::thread flusher;
+
+    void flush_loop();
+    void list_generations(std::vector<int> &gens);
+
+  public:
+    Journal(std::string path);
+    ~Journal();
+
+    void start(int gen);
+    void stop();
+    bool is_open() { return this->running; }
+
+    void record(const std::string &event);
+    int rotate();
+    int generation() { return this->gen; }
+    int records() { return this->gen_records; }
+
+    std::string gen_path(int gen);
+    void prune(int gen);
+    void discard();
+};
+
+#endif
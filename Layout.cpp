@@ -0,0 +1,160 @@
+/*************************************************************************
+ * Program Filename: Layout.cpp
+ * Author: David Bacher-Hicks
+ * Date: 19 October 2026
+ * Description: A class definition file for a Layout class. The layout 
+ *              file is mapped, its row boundaries are found with memchr,
+ *              and the grid is allocated once at its final size. Each row
+ *              is then checked against a glyph lookup table, without a 
+ *              branch per glyph, and copied into the grid whole. A glyph
+ *              that is not a space is an error, giving its row and column.
+ * Input:  a floor layout file
+ * Output: none
+ ************************************************************************/
+
+#include <cstring>
+#include <sstream>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "Layout.hpp"
+#include "Space.hpp"
+
+/* marks every byte that is not a space glyph */
+struct glyph_table {
+  unsigned char invalid[256];
+
+  glyph_table() {
+    const char glyphs[] = { EMPTY_SPACE_C, CLOSED_DOOR_C, WALL_C, 
+                            UP_STAIR_C, DOWN_STAIR_C, HIDDEN_DOOR_C };
+
+    memset(this->invalid, 1, sizeof(this->invalid));
+    for (size_t i = 0; i < sizeof(glyphs); i++) {
+      this->invalid[static_cast<unsigned char>(glyphs[i])] = 0;
+    }
+  }
+};
+
+static const glyph_table GLYPHS;
+
+/*************************************************************************
+ * Function: Layout
+ * Description: constructor
+ * Parameters: none
+ * Pre-conditions: none
+ * Post-conditions: the layout is empty
+ * Returns: none
+ ************************************************************************/
+Layout::Layout()
+{
+  this->width = 0;
+  this->height = 0;
+}
+
+
+/*************************************************************************
+ * Function: read
+ * Description: reads a layout file into the grid
+ * Parameters: path - the path of the layout file
+ * Pre-conditions: none
+ * Post-conditions: on success, the grid holds the layout; on failure, the
+ *                  layout is empty and error() says why
+ * Returns: bool - true if the file was read and every glyph is a space
+ ************************************************************************/
+bool Layout::read(const std::string &path)
+{
+  std::vector<std::pair<const char *, size_t>> rows;  /* start and length of each row */
+  std::ostringstream error;
+  struct stat st;
+  void *mapping = MAP_FAILED;
+  const char *data = NULL, *end = NULL, *newline;
+  const char *row_end;
+  unsigned char bad;
+  bool read = false;
+  int fd;
+
+  this->width = this->height = 0;
+  this->glyphs.clear();
+  this->message = "";
+
+  if ((fd = open(path.c_str(), O_RDONLY)) != -1) {
+    if (fstat(fd, &st) == 0) {
+      read = true;
+      if (st.st_size > 0) {
+        mapping = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        read = (mapping != MAP_FAILED);
+        if (read) {
+          data = static_cast<const char *>(mapping);
+          end = data + st.st_size;
+        }
+      }
+    }
+    close(fd);
+  }
+
+  if (!read) {
+    error << path << ": could not be opened";
+  }
+
+  /* find the rows, and the width of the grid */
+  for (const char *row = data; row < end; row = row_end + 1) {
+    newline = static_cast<const char *>(memchr(row, '\n', end - row));
+    row_end = (newline != NULL) ? newline : end;
+    rows.push_back(std::pair<const char *, size_t>(row, row_end - row));
+    if (rows.back().second > 0 && row[rows.back().second - 1] == '\r') {
+      rows.back().second--;
+    }
+    if (static_cast<int>(rows.back().second) > this->width) {
+      this->width = rows.back().second;
+    }
+  }
+  this->height = rows.size();
+  this->glyphs.assign(static_cast<size_t>(this->width) * this->height, '\0');
+
+  /* check each row as a whole, then copy it into place */
+  for (size_t y = 0; y < rows.size() && read; y++) {
+    bad = 0;
+    for (size_t x = 0; x < rows[y].second; x++) {
+      bad |= GLYPHS.invalid[static_cast<unsigned char>(rows[y].first[x])];
+    }
+
+    if (bad) {
+      size_t x = 0;
+      while (!GLYPHS.invalid[static_cast<unsigned char>(rows[y].first[x])]) {
+        x++;
+      }
+      error << path << ':' << y + 1 << ':' << x + 1 << ": unknown glyph '" 
+            << rows[y].first[x] << "'";
+      read = false;
+    } else {
+      memcpy(&this->glyphs[y * this->width], rows[y].first, rows[y].second);
+    }
+  }
+
+  if (mapping != MAP_FAILED) {
+    munmap(mapping, st.st_size);
+  }
+
+  if (!read) {
+    this->width = this->height = 0;
+    this->glyphs.clear();
+    this->message = error.str();
+  }
+
+  return read;
+}
+
+
+/*************************************************************************
+ * Function: is_glyph
+ * Description: returns whether a character is the glyph of a space
+ * Parameters: glyph - the character
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: bool - true if it is a space glyph
+ ************************************************************************/
+bool Layout::is_glyph(char glyph)
+{
+  return !GLYPHS.invalid[static_cast<unsigned char>(glyph)];
+}
@@ -0,0 +1,36 @@
+/*************************************************************************
+ * Program Filename: Layout.hpp
+ * Author: David Bacher-Hicks
+ * Date: 19 October 2026
+ * Description: A class declaration file for a Layout class: a floor 
+ *              layout (.mp) file read into a dense grid of space glyphs.
+ * Input:  a floor layout file
+ * Output: none
+ ************************************************************************/
+
+#ifndef LAYOUT_HPP
+#define LAYOUT_HPP
+
+#include <string>
+#include <vector>
+
+class Layout {
+  private:
+    int width;                  /* the length of the longest row */
+    int height;                 /* the number of rows */
+    std::vector<char> glyphs;   /* row by row; '\0' pads short rows */
+    std::string message;        /* the last error */
+
+  public:
+    Layout();
+
+    bool read(const std::string &path);
+    static bool is_glyph(char glyph);
+
+    int get_width() { return this->width; }
+    int get_height() { return this->height; }
+    const char *grid() { return this->glyphs.data(); }
+    const std::string &error() { return this->message; }
+};
+
+#endif
@@ -0,0 +1,334 @@
+/*************************************************************************
+ * Program Filename: Logger.cpp
+ * Author: David Bacher-Hicks
+ * Date: 19 October 2026
+ * Description: A class definition file for a Logger class. Writing a
+ *              record only stores it in the thread's ring, and a record
+ *              that finds the ring full is counted and dropped rather
+ *              than making the game wait. Every LOG_DRAIN_MS the drain
+ *              thread empties the rings, sorts the records by time and
+ *              writes them out as text lines of the form
+ *                [seconds] LEVEL t<ring> event name=value ...
+ *              Once the log reaches LOG_ROTATE_BYTES it is moved to log.1,
+ *              log.1 to log.2 and so on, keeping LOG_KEEP_FILES.
+ * Input:  none
+ * Output: the log file and its rotated copies
+ ************************************************************************/
+
+#include <cstdio>
+#include <chrono>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include "Logger.hpp"
+
+const log_event_info LOG_EVENTS[EV_COUNT] = {
+  { "game_start",    { "seed", NULL, NULL, NULL } },
+  { "game_end",      { "days", "won", NULL, NULL } },
+  { "floor_change",  { "floor", "x", "y", NULL } },
+  { "floor_load",    { "floor", "dormant", NULL, NULL } },
+  { "floor_evict",   { "floor", NULL, NULL, NULL } },
+  { "player_attack", { "x", "y", "damage", "hp" } },
+  { "mob_attack",    { "mob", "damage", "hp", NULL } },
+  { "mob_killed",    { "mob", "x", "y", NULL } },
+  { "mob_move",      { "x", "y", "to_x", "to_y" } },
+  { "snapshot",      { "gen", "background", NULL, NULL } },
+  { "reload",        { "items", "mobs", "floors", NULL } },
+  { "dropped",       { "records", NULL, NULL, NULL } }
+};
+
+static const char *LEVEL_NAMES[] = { "DEBUG", "INFO ", "WARN ", "ERROR" };
+
+/*************************************************************************
+ * Function: Logger
+ * Description: constructor
+ * Parameters: none
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: none
+ ************************************************************************/
+Logger::Logger()
+{
+  this->file_bytes = 0;
+  this->start_ns = now();
+  this->running = false;
+}
+
+
+/*************************************************************************
+ * Function: ~Logger
+ * Description: destructor; writes out anything still waiting
+ * Parameters: none
+ * Pre-conditions: none
+ * Post-conditions: the drain is stopped and the log file closed
+ * Returns: none
+ ************************************************************************/
+Logger::~Logger()
+{
+  this->stop();
+}
+
+
+/*************************************************************************
+ * Function: start
+ * Description: opens the log file, first moving the last run's log to
+ *              log.1, and starts the drain thread
+ * Parameters: path - the log file
+ * Pre-conditions: none
+ * Post-conditions: the drain is running if the file could be opened
+ * Returns: bool - true if the drain is running
+ ************************************************************************/
+bool Logger::start(const std::string &path)
+{
+  if (!this->running) {
+    this->path = path;
+    this->rotate();
+
+    if (this->file.is_open()) {
+      this->running = true;
+      this->drainer = std::thread(&Logger::drain_loop, this);
+    }
+  }
+
+  return this->running;
+}
+
+
+/*************************************************************************
+ * Function: stop
+ * Description: stops the drain thread, once it has written out every
+ *              record logged so far, and closes the log file
+ * Parameters: none
+ * Pre-conditions: none
+ * Post-conditions: the drain is stopped
+ * Returns: none
+ ************************************************************************/
+void Logger::stop()
+{
+  if (this->running) {
+    {
+      std::lock_guard<std::mutex> guard(this->lock);
+      this->running = false;
+    }
+    this->wake.notify_one();
+    this->drainer.join();
+    this->file.close();
+  }
+}
+
+
+/*************************************************************************
+ * Function: now
+ * Description: reads the monotonic clock records are stamped with
+ * Parameters: none
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: int64_t - the time, in nanoseconds
+ ************************************************************************/
+int64_t Logger::now()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+           std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
+/*************************************************************************
+ * Function: record
+ * Description: logs an event to the calling thread's ring. Takes no lock
+ *              once the thread has a ring. If the ring is full, the
+ *              record is dropped and counted.
+ * Parameters: level - the record's level
+ *             event - the event
+ *             a, b, c, d - the event's arguments, as named in LOG_EVENTS
+ * Pre-conditions: none
+ * Post-conditions: the record is waiting for the drain, or counted as
+ *                  dropped
+ * Returns: none
+ ************************************************************************/
+void Logger::record(log_level level, log_event event, int32_t a, int32_t b, int32_t c, int32_t d)
+{
+  this->rings.write([=](log_record &entry, uint32_t thread) {
+    entry.time_ns = now();
+    entry.level = level;
+    entry.event = event;
+    entry.thread = thread;
+    entry.args[0] = a;
+    entry.args[1] = b;
+    entry.args[2] = c;
+    entry.args[3] = d;
+  });
+}
+
+
+/*************************************************************************
+ * Function: text
+ * Description: logs a free text message, such as the gamedata load
+ *              messages. Takes the logger's lock, so is kept off the
+ *              turn path.
+ * Parameters: level - the message's level
+ *             message - the text, of one or more lines
+ * Pre-conditions: none
+ * Post-conditions: the message is waiting for the drain
+ * Returns: none
+ ************************************************************************/
+void Logger::text(log_level level, const std::string &message)
+{
+  text_record entry;
+
+  entry.time_ns = now();
+  entry.level = level;
+  entry.text = message;
+
+  std::lock_guard<std::mutex> guard(this->lock);
+  this->texts.push_back(entry);
+}
+
+
+/*************************************************************************
+ * Function: drain_loop
+ * Description: the drain thread. Drains the rings every LOG_DRAIN_MS, and
+ *              once more as it stops.
+ * Parameters: none
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: none
+ ************************************************************************/
+void Logger::drain_loop()
+{
+  std::unique_lock<std::mutex> guard(this->lock);
+
+  while (this->running) {
+    this->wake.wait_for(guard, std::chrono::milliseconds(LOG_DRAIN_MS));
+    guard.unlock();
+    this->drain();
+    guard.lock();
+  }
+  guard.unlock();
+
+  this->drain();
+}
+
+
+/*************************************************************************
+ * Function: drain
+ * Description: empties every ring and the waiting text, and writes them
+ *              to the log file in time order
+ * Parameters: none
+ * Pre-conditions: called only from the drain thread
+ * Post-conditions: the rings are empty, up to records logged meanwhile
+ * Returns: none
+ ************************************************************************/
+void Logger::drain()
+{
+  std::vector<text_record> texts;
+  std::vector<log_record> batch;
+  std::ostringstream line;
+  std::vector<text_record>::iterator text;
+
+  {
+    std::lock_guard<std::mutex> guard(this->lock);
+    texts.swap(this->texts);
+  }
+
+  this->rings.drain([&batch](const log_record &entry) { batch.push_back(entry); },
+                    [&batch](uint32_t thread, uint32_t dropped) {
+    log_record lost;
+    lost.time_ns = now();
+    lost.level = LEVEL_WARN;
+    lost.event = EV_DROPPED;
+    lost.thread = thread;
+    lost.args[0] = dropped;
+    batch.push_back(lost);
+  });
+
+  std::stable_sort(batch.begin(), batch.end(),
+                   [](const log_record &a, const log_record &b) { return a.time_ns < b.time_ns; });
+
+  /* the text is already in time order; merge it in among the records */
+  text = texts.begin();
+  for (auto i = batch.begin(); i != batch.end() || text != texts.end(); ) {
+    if (text != texts.end() && (i == batch.end() || text->time_ns <= i->time_ns)) {
+      std::istringstream lines(text->text);
+      std::string text_line;
+      while (std::getline(lines, text_line)) {
+        if (!text_line.empty()) {
+          this->write_line(text->time_ns, text->level, text_line);
+        }
+      }
+      text++;
+
+    } else {
+      const log_event_info &info = LOG_EVENTS[i->event];
+      line.str("");
+      line << 't' << i->thread << ' ' << info.name;
+      for (int j = 0; j < LOG_ARGS && info.args[j] != NULL; j++) {
+        line << ' ' << info.args[j] << '=' << i->args[j];
+      }
+      this->write_line(i->time_ns, (log_level)i->level, line.str());
+      i++;
+    }
+  }
+
+  this->file.flush();
+}
+
+
+/*************************************************************************
+ * Function: write_line
+ * Description: writes a line to the log file, stamped with its time since
+ *              the logger was made and its level, rotating the file first
+ *              if it is full
+ * Parameters: time_ns - the line's time
+ *             level - the line's level
+ *             line - the text, without a newline
+ * Pre-conditions: called only from the drain thread
+ * Post-conditions: none
+ * Returns: none
+ ************************************************************************/
+void Logger::write_line(int64_t time_ns, log_level level, const std::string &line)
+{
+  std::ostringstream out;
+
+  out << '[' << std::fixed << std::setprecision(6) << std::setw(12)
+      << (time_ns - this->start_ns) / 1e9 << "] " << LEVEL_NAMES[level] << ' ' << line << '\n';
+
+  if (this->file_bytes > 0 && this->file_bytes + (long)out.str().size() > LOG_ROTATE_BYTES) {
+    this->rotate();
+  }
+
+  this->file << out.str();
+  this->file_bytes += out.str().size();
+}
+
+
+/*************************************************************************
+ * Function: rotate
+ * Description: closes the log file, shifts the rotated copies up by one,
+ *              dropping the oldest, moves the log to log.1 and opens a
+ *              new log
+ * Parameters: none
+ * Pre-conditions: path is set
+ * Post-conditions: the log file is open and empty, unless it could not be
+ *                  opened
+ * Returns: none
+ ************************************************************************/
+void Logger::rotate()
+{
+  std::ostringstream from, to;
+
+  this->file.close();
+
+  for (int i = LOG_KEEP_FILES - 1; i >= 1; i--) {
+    from.str("");
+    to.str("");
+    from << this->path << '.' << i;
+    to << this->path << '.' << i + 1;
+    std::rename(from.str().c_str(), to.str().c_str());
+  }
+  to.str("");
+  to << this->path << ".1";
+  std::rename(this->path.c_str(), to.str().c_str());
+
+  this->file.open(this->path.c_str(), std::ios::trunc);
+  this->file_bytes = 0;
+}
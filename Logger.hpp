@@ -0,0 +1,117 @@
+/*************************************************************************
+ * Program Filename: Logger.hpp
+ * Author: David Bacher-Hicks
+ * Date: 19 October 2026
+ * Description: A class declaration file for a Logger class. Each thread
+ *              that logs writes fixed-size binary records into its own
+ *              ring of a ThreadRings, without locking; a background thread
+ *              drains the rings, formats the records and writes them to a
+ *              rotating log file. Debug records are compiled out unless the game
+ *              is built with LOG_DEBUG_RECORDS ("make LOG_DEBUG=1").
+ * Input:  none
+ * Output: the log file and its rotated copies
+ ************************************************************************/
+
+#ifndef LOGGER_HPP
+#define LOGGER_HPP
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <fstream>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
+#include "ThreadRings.hpp"
+
+/* drain and rotation settings */
+const int LOG_RING_RECORDS = 4096;      /* records a thread can log before the drain */
+const int LOG_DRAIN_MS     = 100;       /* longest a record waits to be written */
+const long LOG_ROTATE_BYTES = 1 << 20;  /* log size that starts a new file */
+const int LOG_KEEP_FILES   = 3;         /* rotated files kept, as log.1 to log.N */
+const int LOG_ARGS         = 4;         /* arguments carried by a record */
+
+enum log_level { LEVEL_DEBUG, LEVEL_INFO, LEVEL_WARN, LEVEL_ERROR };
+
+/* the events the game logs; LOG_EVENTS gives each its name and arguments */
+enum log_event {
+  EV_GAME_START,      /* seed */
+  EV_GAME_END,        /* days won */
+  EV_FLOOR_CHANGE,    /* floor x y */
+  EV_FLOOR_LOAD,      /* floor dormant */
+  EV_FLOOR_EVICT,     /* floor */
+  EV_PLAYER_ATTACK,   /* x y damage hp */
+  EV_MOB_ATTACK,      /* mob damage hp */
+  EV_MOB_KILLED,      /* mob x y */
+  EV_MOB_MOVE,        /* x y to_x to_y */
+  EV_SNAPSHOT,        /* generation background */
+  EV_RELOAD,          /* items mobs floors */
+  EV_DROPPED,         /* records */
+  EV_COUNT
+};
+
+struct log_event_info {
+  const char *name;
+  const char *args[LOG_ARGS];   /* argument names, NULL past the last */
+};
+
+extern const log_event_info LOG_EVENTS[EV_COUNT];
+
+/* a binary log record, as written into a ring */
+struct log_record {
+  int64_t time_ns;              /* steady clock time */
+  uint16_t level;
+  uint16_t event;
+  uint32_t thread;              /* the ring it was written to */
+  int32_t args[LOG_ARGS];
+};
+
+/* debug records cost nothing, not even their arguments, unless built in */
+#ifdef LOG_DEBUG_RECORDS
+#define LOG_DEBUG(logger, ...) (logger).record(LEVEL_DEBUG, __VA_ARGS__)
+#else
+#define LOG_DEBUG(logger, ...) ((void)0)
+#endif
+
+class Logger {
+  private:
+    /* a free text message, for the rare lines that are not events */
+    struct text_record {
+      int64_t time_ns;
+      log_level level;
+      std::string text;
+    };
+
+    ThreadRings<log_record, LOG_RING_RECORDS> rings;  /* every thread's ring of records */
+    std::string path;                   /* the log file */
+    std::ofstream file;
+    long file_bytes;                    /* bytes written to the log file */
+    int64_t start_ns;                   /* steady clock time of start */
+
+    std::vector<text_record> texts;     /* text waiting for the drain */
+    bool running;                       /* whether the drain should keep running */
+    std::mutex lock;                    /* guards texts and running */
+    std::condition_variable wake;
+    std::thread drainer;
+
+    void drain_loop();
+    void drain();
+    void write_line(int64_t time_ns, log_level level, const std::string &line);
+    void rotate();
+
+  public:
+    Logger();
+    ~Logger();
+
+    bool start(const std::string &path);
+    void stop();
+
+    static int64_t now();
+    void record(log_level level, log_event event, int32_t a = 0, int32_t b = 0,
+                int32_t c = 0, int32_t d = 0);
+    void text(log_level level, const std::string &message);
+};
+
+#endif
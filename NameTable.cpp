@@ -0,0 +1,67 @@
+/*************************************************************************
+ * Program Filename: NameTable.cpp
+ * Author: David Bacher-Hicks
+ * Date: 19 October 2026
+ * Description: A class definition file for a NameTable class. Names are
+ *              numbered in the order they are interned. Names are only
+ *              interned while loading; after that the table is read-only
+ *              and may be read from any thread.
+ * Input:  none
+ * Output: none
+ ************************************************************************/
+
+#include "NameTable.hpp"
+
+/*************************************************************************
+ * Function: intern
+ * Description: returns the number of a name, numbering it if it is new
+ * Parameters: name - the name
+ * Pre-conditions: none
+ * Post-conditions: the name is in the table
+ * Returns: int - the name's number
+ ************************************************************************/
+int NameTable::intern(const std::string &name)
+{
+  auto entry = this->ids.insert(std::pair<std::string, int>(name, this->names.size()));
+
+  if (entry.second) {
+    this->names.push_back(name);
+  }
+
+  return entry.first->second;
+}
+
+
+/*************************************************************************
+ * Function: find
+ * Description: returns the number of a name, without numbering it
+ * Parameters: name - the name
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: int - the name's number, or NO_ID if it was never interned
+ ************************************************************************/
+int NameTable::find(const std::string &name) const
+{
+  auto entry = this->ids.find(name);
+  int id = NO_ID;
+
+  if (entry != this->ids.end()) {
+    id = entry->second;
+  }
+
+  return id;
+}
+
+
+/*************************************************************************
+ * Function: name
+ * Description: returns the name of a number
+ * Parameters: id - the number
+ * Pre-conditions: id was returned by intern
+ * Post-conditions: none
+ * Returns: const std::string & - the name
+ ************************************************************************/
+const std::string &NameTable::name(int id) const
+{
+  return this->names[id];
+}
@@ -0,0 +1,33 @@
+/*************************************************************************
+ * Program Filename: NameTable.hpp
+ * Author: David Bacher-Hicks
+ * Date: 19 October 2026
+ * Description: A class declaration file for a NameTable class. A name
+ *              table interns the string IDs read from the gamedata, giving
+ *              each a dense number from 0 that can index a flat table.
+ * Input:  none
+ * Output: none
+ ************************************************************************/
+
+#ifndef NAMETABLE_HPP
+#define NAMETABLE_HPP
+
+#include <map>
+#include <string>
+#include <vector>
+
+const int NO_ID = -1;             /* the number of no name at all */
+
+class NameTable {
+  private:
+    std::map<std::string, int> ids; /* number of each name */
+    std::vector<std::string> names; /* name of each number */
+
+  public:
+    int intern(const std::string &name);
+    int find(const std::string &name) const;
+    const std::string &name(int id) const;
+    int size() const { return this->names.size(); }
+};
+
+#endif
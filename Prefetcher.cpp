@@ -0,0 +1,212 @@
+/*************************************************************************
+ * Program Filename: Prefetcher.cpp
+ * Author: David Bacher-Hicks
+ * Date: 19 October 2026
+ * Description: A class definition file for a Prefetcher class. The game
+ *              thread asks for one floor at a time; a loader thread builds
+ *              it and hands the finished floor back through a single 
+ *              atomic slot, which the game thread empties between turns.
+ *              Only the request wakes the loader under a lock; the game 
+ *              thread never locks to pick up a finished floor, and only
+ *              sleeps on the lock when it must wait for one.
+ * Input:  none
+ * Output: none
+ ************************************************************************/
+
+#include "Prefetcher.hpp"
+#include "Game.hpp"
+
+/*************************************************************************
+ * Function: Prefetcher
+ * Description: constructor
+ * Parameters: game - the game whose floors are loaded
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: none
+ ************************************************************************/
+Prefetcher::Prefetcher(Game *game) : ready(NULL)
+{
+  this->game = game;
+  this->wanted = false;
+  this->running = false;
+  this->busy = false;
+  this->want_floor = this->busy_floor = -1;
+}
+
+
+/*************************************************************************
+ * Function: ~Prefetcher
+ * Description: destructor; stops the loader
+ * Parameters: none
+ * Pre-conditions: none
+ * Post-conditions: the loader will have been stopped
+ * Returns: none
+ ************************************************************************/
+Prefetcher::~Prefetcher()
+{
+  this->stop();
+}
+
+
+/*************************************************************************
+ * Function: start
+ * Description: starts the loader thread
+ * Parameters: none
+ * Pre-conditions: none
+ * Post-conditions: the loader is running
+ * Returns: none
+ ************************************************************************/
+void Prefetcher::start()
+{
+  if (!this->running) {
+    this->running = true;
+    this->loader = std::thread(&Prefetcher::load_loop, this);
+  }
+}
+
+
+/*************************************************************************
+ * Function: stop
+ * Description: stops the loader thread, once it has finished any floor
+ *              it is loading, and discards any uncollected floor
+ * Parameters: none
+ * Pre-conditions: none
+ * Post-conditions: the loader is stopped and no request is outstanding
+ * Returns: none
+ ************************************************************************/
+void Prefetcher::stop()
+{
+  if (this->running) {
+    {
+      std::lock_guard<std::mutex> guard(this->lock);
+      this->running = false;
+      this->wanted = false;
+    }
+    this->wake.notify_one();
+    this->loader.join();
+
+    delete this->ready.exchange(NULL, std::memory_order_acquire);
+    this->busy = false;
+  }
+}
+
+
+/*************************************************************************
+ * Function: request
+ * Description: asks the loader to load a floor, if it is not already 
+ *              loading one
+ * Parameters: floor_num - the number of the floor to load
+ *             state - the floor's dormant state, or "" to populate it
+ * Pre-conditions: none
+ * Post-conditions: the floor will be handed back through collect or wait
+ * Returns: bool - whether the request was accepted
+ ************************************************************************/
+bool Prefetcher::request(int floor_num, const std::string &state)
+{
+  bool accepted = (this->running && !this->busy);
+
+  if (accepted) {
+    {
+      std::lock_guard<std::mutex> guard(this->lock);
+      this->want_floor = floor_num;
+      this->want_state = state;
+      this->wanted = true;
+    }
+    this->busy = true;
+    this->busy_floor = floor_num;
+    this->wake.notify_one();
+  }
+
+  return accepted;
+}
+
+
+/*************************************************************************
+ * Function: collect
+ * Description: takes the requested floor, if the loader has finished it
+ * Parameters: floor_num - set to the number of the floor taken
+ * Pre-conditions: none
+ * Post-conditions: if a floor is returned, no request is outstanding
+ * Returns: Floor * - the loaded floor, or NULL if none is ready
+ ************************************************************************/
+Floor *Prefetcher::collect(int &floor_num)
+{
+  Floor *floor = NULL;
+
+  if (this->busy) {
+    floor = this->ready.exchange(NULL, std::memory_order_acquire);
+    if (floor != NULL) {
+      floor_num = this->busy_floor;
+      this->busy = false;
+    }
+  }
+
+  return floor;
+}
+
+
+/*************************************************************************
+ * Function: wait
+ * Description: takes the requested floor, waiting for the loader to 
+ *              finish it, asleep until it is published. Used when the
+ *              player reaches a stair before its floor has been prefetched.
+ * Parameters: floor_num - set to the number of the floor taken
+ * Pre-conditions: none
+ * Post-conditions: no request is outstanding
+ * Returns: Floor * - the loaded floor, or NULL if none was requested
+ ************************************************************************/
+Floor *Prefetcher::wait(int &floor_num)
+{
+  Floor *floor = NULL;
+
+  if (this->busy) {
+    std::unique_lock<std::mutex> guard(this->lock);
+    while ((floor = this->collect(floor_num)) == NULL) {
+      this->published.wait(guard);
+    }
+  }
+
+  return floor;
+}
+
+
+/*************************************************************************
+ * Function: load_loop
+ * Description: the loader thread. Waits for a request, loads the floor,
+ *              publishes it in the handoff slot and wakes a waiting game
+ *              thread.
+ * Parameters: none
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: none
+ ************************************************************************/
+void Prefetcher::load_loop()
+{
+  std::string state;
+  int floor_num = -1;
+  std::ostream no_log(NULL);    /* the game's log is not written off its thread */
+  bool loading = true;
+
+  this->game->get_tracer().name_thread("loader");
+
+  while (loading) {
+    {
+      std::unique_lock<std::mutex> guard(this->lock);
+      while (this->running && !this->wanted) {
+        this->wake.wait(guard);
+      }
+      loading = this->running;
+      floor_num = this->want_floor;
+      state.swap(this->want_state);
+      this->wanted = false;
+    }
+
+    if (loading) {
+      this->ready.store(this->game->assemble_floor(floor_num, state, no_log), std::memory_order_release);
+
+      /* under the lock, so a wait between its check and its sleep is not missed */
+      std::lock_guard<std::mutex> guard(this->lock);
+      this->published.notify_one();
+    }
+  }
+}
@@ -0,0 +1,61 @@
+/*************************************************************************
+ * Program Filename: Prefetcher.hpp
+ * Author: David Bacher-Hicks
+ * Date: 19 October 2026
+ * Description: A class declaration file for a Prefetcher class. The 
+ *              prefetcher loads a floor on a background thread before the
+ *              player takes the stairs to it.
+ * Input:  none
+ * Output: none
+ ************************************************************************/
+
+#ifndef PREFETCHER_HPP
+#define PREFETCHER_HPP
+
+#include <string>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+class Game;
+class Floor;
+
+/* how close, in tiles, the player must be to a stair to prefetch its floor */
+const int PREFETCH_RANGE = 4;
+
+class Prefetcher {
+  private:
+    Game *game;                 /* the game whose floors are loaded */
+
+    int want_floor;             /* floor the loader should load next */
+    std::string want_state;     /* its dormant state, or "" to populate it */
+    bool wanted;                /* whether want_floor is waiting for the loader */
+    bool running;               /* whether the loader should keep running */
+    std::mutex lock;            /* guards want_floor, want_state, wanted and running */
+    std::condition_variable wake;
+    std::condition_variable published;  /* signalled when a floor is put in the slot */
+    std::thread loader;
+
+    std::atomic<Floor *> ready; /* handoff slot: the loaded floor, or NULL */
+    bool busy;                  /* a request has not been collected yet */
+    int busy_floor;             /* the floor of that request */
+
+    void load_loop();
+
+  public:
+    Prefetcher(Game *game);
+    ~Prefetcher();
+
+    void start();
+    void stop();
+
+    bool request(int floor_num, const std::string &state);
+    bool is_busy() { return this->busy; }
+    bool is_pending(int floor_num) 
+      { return this->busy && this->busy_floor == floor_num; }
+    Floor *collect(int &floor_num);
+    Floor *wait(int &floor_num);
+};
+
+#endif
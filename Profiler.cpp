@@ -0,0 +1,232 @@
+/*************************************************************************
+ * Program Filename: Profiler.cpp
+ * Author: David Bacher-Hicks
+ * Date: 19 October 2026
+ * Description: A class definition file for a Profiler class. Times are
+ *              counted in log-linear buckets: below 2^PROFILE_SUB_BITS ns
+ *              each nanosecond has a bucket, and above that each power of
+ *              two is split into PROFILE_SUB_BUCKETS equal buckets. A
+ *              percentile is reported as the top of the bucket it falls
+ *              in.
+ * Input:  none
+ * Output: none
+ ************************************************************************/
+
+#include <chrono>
+#include <sstream>
+#include <iomanip>
+#include "Profiler.hpp"
+
+const char *PHASE_NAMES[PHASE_COUNT] = {
+  "read_input",
+  "move_player",
+  "move_mobs",
+  "mob_make_moves",
+  "move_char",
+  "render",
+  "output"
+};
+
+/*************************************************************************
+ * Function: Profiler
+ * Description: constructor; the profiler starts off and empty
+ * Parameters: none
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: none
+ ************************************************************************/
+Profiler::Profiler() : counts(PHASE_COUNT * PROFILE_BUCKETS, 0)
+{
+  this->enabled = false;
+  this->reset();
+}
+
+
+/*************************************************************************
+ * Function: now
+ * Description: reads the monotonic clock
+ * Parameters: none
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: int64_t - the time, in nanoseconds
+ ************************************************************************/
+int64_t Profiler::now()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+           std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
+/*************************************************************************
+ * Function: bucket
+ * Description: finds the histogram bucket that counts a time
+ * Parameters: ns - the time, in nanoseconds
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: int - the bucket, from 0 to PROFILE_BUCKETS - 1
+ ************************************************************************/
+int Profiler::bucket(int64_t ns)
+{
+  uint64_t value = ns < 0 ? 0 : ns;
+  int index = value;
+  int top;                        /* the highest set bit of the time */
+
+  if (value >= (uint64_t)PROFILE_SUB_BUCKETS) {
+    top = 63 - __builtin_clzll(value);
+    index = (top - PROFILE_SUB_BITS + 1) * PROFILE_SUB_BUCKETS +
+            ((value >> (top - PROFILE_SUB_BITS)) & (PROFILE_SUB_BUCKETS - 1));
+  }
+
+  return index;
+}
+
+
+/*************************************************************************
+ * Function: bucket_value
+ * Description: gives the highest time a bucket counts
+ * Parameters: index - the bucket
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: int64_t - the time, in nanoseconds
+ ************************************************************************/
+int64_t Profiler::bucket_value(int index)
+{
+  int64_t value = index;
+  int shift;                      /* the width of the bucket, as a power of two */
+
+  if (index >= PROFILE_SUB_BUCKETS) {
+    shift = index / PROFILE_SUB_BUCKETS - 1;
+    value = ((int64_t)(PROFILE_SUB_BUCKETS + index % PROFILE_SUB_BUCKETS) << shift) +
+            ((int64_t)1 << shift) - 1;
+  }
+
+  return value;
+}
+
+
+/*************************************************************************
+ * Function: add
+ * Description: counts a phase's time
+ * Parameters: phase - the phase
+ *             ns - how long it took, in nanoseconds
+ * Pre-conditions: none
+ * Post-conditions: the time is counted
+ * Returns: none
+ ************************************************************************/
+void Profiler::add(profile_phase phase, int64_t ns)
+{
+  this->counts[phase * PROFILE_BUCKETS + bucket(ns)]++;
+  this->samples[phase]++;
+  if (ns > this->max_ns[phase]) {
+    this->max_ns[phase] = ns;
+  }
+}
+
+
+/*************************************************************************
+ * Function: percentile
+ * Description: finds the time within which a percentage of a phase's
+ *              timings finished
+ * Parameters: phase - the phase
+ *             percent - the percentage, from 0 to 100
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: int64_t - the time, in nanoseconds, or 0 if the phase has not
+ *          been timed
+ ************************************************************************/
+int64_t Profiler::percentile(profile_phase phase, double percent) const
+{
+  uint64_t rank = (uint64_t)(percent / 100.0 * this->samples[phase] + 0.5);
+  uint64_t seen = 0;
+  int64_t value = 0;
+  int i = 0;
+
+  if (rank < 1) {
+    rank = 1;
+  }
+
+  if (this->samples[phase] > 0) {
+    while (seen < rank) {
+      seen += this->counts[phase * PROFILE_BUCKETS + i];
+      i++;
+    }
+    value = bucket_value(i - 1);
+
+    /* the top of a bucket can be past the slowest time actually seen */
+    if (value > this->max_ns[phase]) {
+      value = this->max_ns[phase];
+    }
+  }
+
+  return value;
+}
+
+
+/*************************************************************************
+ * Function: has_samples
+ * Description: checks whether any phase has been timed
+ * Parameters: none
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: bool - true if any phase has been timed
+ ************************************************************************/
+bool Profiler::has_samples() const
+{
+  bool found = false;
+
+  for (int i = 0; i < PHASE_COUNT && !found; i++) {
+    found = this->samples[i] > 0;
+  }
+
+  return found;
+}
+
+
+/*************************************************************************
+ * Function: reset
+ * Description: empties the histograms
+ * Parameters: none
+ * Pre-conditions: none
+ * Post-conditions: no phase has been timed
+ * Returns: none
+ ************************************************************************/
+void Profiler::reset()
+{
+  this->counts.assign(this->counts.size(), 0);
+  for (int i = 0; i < PHASE_COUNT; i++) {
+    this->samples[i] = 0;
+    this->max_ns[i] = 0;
+  }
+}
+
+
+/*************************************************************************
+ * Function: report
+ * Description: tabulates the count, median, 99th percentile and slowest
+ *              time of each phase that has been timed, in microseconds
+ * Parameters: none
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: std::string - the table, one line per phase
+ ************************************************************************/
+std::string Profiler::report() const
+{
+  std::ostringstream table;
+
+  table << std::left << std::setw(16) << "phase" << std::right
+        << std::setw(8) << "count" << std::setw(12) << "p50 us"
+        << std::setw(12) << "p99 us" << std::setw(12) << "max us" << '\n';
+  table << std::fixed << std::setprecision(1);
+
+  for (int i = 0; i < PHASE_COUNT; i++) {
+    if (this->samples[i] > 0) {
+      table << std::left << std::setw(16) << PHASE_NAMES[i] << std::right
+            << std::setw(8) << this->samples[i]
+            << std::setw(12) << this->percentile((profile_phase)i, 50) / 1e3
+            << std::setw(12) << this->percentile((profile_phase)i, 99) / 1e3
+            << std::setw(12) << this->max_ns[i] / 1e3 << '\n';
+    }
+  }
+
+  return table.str();
+}
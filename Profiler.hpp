@@ -0,0 +1,84 @@
+/*************************************************************************
+ * Program Filename: Profiler.hpp
+ * Author: David Bacher-Hicks
+ * Date: 19 October 2026
+ * Description: A class declaration file for a Profiler class. The
+ *              profiler times the phases of a turn on the monotonic clock
+ *              and counts the times in a latency histogram per phase, from
+ *              which it reports the median, 99th percentile and slowest
+ *              time of each. A phase is timed by a ProfileScope around it;
+ *              while the profiler is off, a scope only tests a flag.
+ * Input:  none
+ * Output: none
+ ************************************************************************/
+
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+/*
+ * histogram resolution: each power of two is split into 2^PROFILE_SUB_BITS
+ * buckets, so a time is counted to within about 3%
+ */
+const int PROFILE_SUB_BITS = 5;
+const int PROFILE_SUB_BUCKETS = 1 << PROFILE_SUB_BITS;
+const int PROFILE_BUCKETS = (64 - PROFILE_SUB_BITS + 1) * PROFILE_SUB_BUCKETS;
+
+/* the timed phases of a turn */
+enum profile_phase {
+  PHASE_READ_INPUT,
+  PHASE_MOVE_PLAYER,
+  PHASE_MOVE_MOBS,
+  PHASE_MOB_MAKE_MOVES,
+  PHASE_MOVE_CHAR,
+  PHASE_RENDER,
+  PHASE_OUTPUT,
+  PHASE_COUNT
+};
+
+extern const char *PHASE_NAMES[PHASE_COUNT];
+
+class Profiler {
+  private:
+    bool enabled;                       /* whether phases are being timed */
+    std::vector<uint64_t> counts;       /* each phase's PROFILE_BUCKETS buckets */
+    uint64_t samples[PHASE_COUNT];      /* times counted for each phase */
+    int64_t max_ns[PHASE_COUNT];        /* slowest time of each phase */
+
+    static int bucket(int64_t ns);
+    static int64_t bucket_value(int index);
+
+  public:
+    Profiler();
+
+    static int64_t now();
+
+    void set_enabled(bool enabled) { this->enabled = enabled; }
+    bool is_enabled() const { return this->enabled; }
+
+    void add(profile_phase phase, int64_t ns);
+    int64_t percentile(profile_phase phase, double percent) const;
+    bool has_samples() const;
+    void reset();
+    std::string report() const;
+};
+
+/* times the enclosing block as a phase, if the profiler is on as it starts */
+class ProfileScope {
+  private:
+    Profiler *profiler;                 /* the profiler, or NULL if it was off */
+    profile_phase phase;
+    int64_t start_ns;
+
+  public:
+    ProfileScope(Profiler &profiler, profile_phase phase)
+      : profiler(profiler.is_enabled() ? &profiler : NULL), phase(phase),
+        start_ns(profiler.is_enabled() ? Profiler::now() : 0) {}
+    ~ProfileScope()
+      { if (this->profiler != NULL) this->profiler->add(this->phase, Profiler::now() - this->start_ns); }
+};
+
+#endif
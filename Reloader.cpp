@@ -0,0 +1,246 @@
+/*************************************************************************
+ * Program Filename: Reloader.cpp
+ * Author: David Bacher-Hicks
+ * Date: 19 October 2026
+ * Description: A class definition file for a Reloader class. A watcher
+ *              thread waits on inotify for tables and maps to be written
+ *              in the gamedata directories. Once they have been left
+ *              alone for RELOAD_SETTLE_MS, the watcher has the game read
+ *              the changed files and hands the result back through a
+ *              single atomic slot, which the game thread empties between
+ *              turns. The next reload is not read until the last has been
+ *              applied, so reading never overlaps the game changing its
+ *              data.
+ * Input:  the gamedata directories
+ * Output: none
+ ************************************************************************/
+
+#include <poll.h>
+#include <unistd.h>
+#include <sys/inotify.h>
+#include "Reloader.hpp"
+#include "Game.hpp"
+#include "utils.hpp"
+
+/*************************************************************************
+ * Function: ~gamedata_reload
+ * Description: destructor; frees anything the game did not take
+ * Parameters: none
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: none
+ ************************************************************************/
+gamedata_reload::~gamedata_reload()
+{
+  for (auto i = this->items.begin(); i != this->items.end(); i++) {
+    delete *i;
+  }
+  for (auto i = this->mobs.begin(); i != this->mobs.end(); i++) {
+    delete *i;
+  }
+  for (auto i = this->floors.begin(); i != this->floors.end(); i++) {
+    delete i->second;
+  }
+}
+
+
+/*************************************************************************
+ * Function: Reloader
+ * Description: constructor
+ * Parameters: game - the game whose data is reloaded
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: none
+ ************************************************************************/
+Reloader::Reloader(Game *game) : ready(NULL)
+{
+  this->game = game;
+  this->watch_fd = -1;
+  this->wake_fds[0] = this->wake_fds[1] = -1;
+  this->running = false;
+}
+
+
+/*************************************************************************
+ * Function: ~Reloader
+ * Description: destructor; stops the watcher
+ * Parameters: none
+ * Pre-conditions: none
+ * Post-conditions: the watcher will have been stopped
+ * Returns: none
+ ************************************************************************/
+Reloader::~Reloader()
+{
+  this->stop();
+}
+
+
+/*************************************************************************
+ * Function: start
+ * Description: watches the gamedata directories and starts the watcher
+ *              thread
+ * Parameters: none
+ * Pre-conditions: none
+ * Post-conditions: the watcher may be running
+ * Returns: bool - true if the watcher is running
+ ************************************************************************/
+bool Reloader::start()
+{
+  const std::string dirs[] = { ITEM_DIR, MOB_DIR, MOB_LOOT_DIR, MAP_PATH_ROOT };
+  int wd;
+
+  if (!this->running) {
+    this->watch_fd = inotify_init1(IN_CLOEXEC);
+
+    if (this->watch_fd != -1 && pipe(this->wake_fds) == 0) {
+      for (int i = 0; i < 4; i++) {
+        wd = inotify_add_watch(this->watch_fd, dirs[i].c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+        if (wd != -1) {
+          this->watched[wd] = dirs[i];
+        }
+      }
+      this->running = true;
+      this->watcher = std::thread(&Reloader::watch_loop, this);
+
+    } else if (this->watch_fd != -1) {
+      close(this->watch_fd);
+      this->watch_fd = -1;
+    }
+  }
+
+  return this->running;
+}
+
+
+/*************************************************************************
+ * Function: stop
+ * Description: stops the watcher thread, once it has finished any files
+ *              it is reading, and discards any unapplied reload
+ * Parameters: none
+ * Pre-conditions: none
+ * Post-conditions: the watcher is stopped
+ * Returns: none
+ ************************************************************************/
+void Reloader::stop()
+{
+  if (this->running) {
+    {
+      std::lock_guard<std::mutex> guard(this->lock);
+      this->running = false;
+    }
+    this->applied.notify_one();
+
+    /* closing the write end wakes the watcher from poll */
+    close(this->wake_fds[1]);
+    this->watcher.join();
+
+    close(this->wake_fds[0]);
+    close(this->watch_fd);
+    this->wake_fds[0] = this->wake_fds[1] = this->watch_fd = -1;
+    this->watched.clear();
+
+    delete this->ready.exchange(NULL, std::memory_order_acquire);
+  }
+}
+
+
+/*************************************************************************
+ * Function: finish
+ * Description: frees the collected reload once the game has applied it,
+ *              letting the watcher read the next one
+ * Parameters: none
+ * Pre-conditions: the reload from collect has been applied
+ * Post-conditions: the slot is empty
+ * Returns: none
+ ************************************************************************/
+void Reloader::finish()
+{
+  {
+    std::lock_guard<std::mutex> guard(this->lock);
+    delete this->ready.exchange(NULL, std::memory_order_acquire);
+  }
+  this->applied.notify_one();
+}
+
+
+/*************************************************************************
+ * Function: read_events
+ * Description: reads the waiting inotify events, adding the path of each
+ *              written table (.tbl) or map (.mp, .dat) file
+ * Parameters: paths - the changed paths
+ * Pre-conditions: the watch is open
+ * Post-conditions: none
+ * Returns: bool - true if any events were read
+ ************************************************************************/
+bool Reloader::read_events(std::set<std::string> &paths)
+{
+  alignas(struct inotify_event) char buffer[4096];
+  const struct inotify_event *event;
+  std::string name;
+  ssize_t length = read(this->watch_fd, buffer, sizeof(buffer));
+
+  for (ssize_t i = 0; i < length; i += sizeof(struct inotify_event) + event->len) {
+    event = reinterpret_cast<const struct inotify_event *>(buffer + i);
+    auto dir = this->watched.find(event->wd);
+
+    if (event->len > 0 && dir != this->watched.end()) {
+      name = event->name;
+      if (has_suffix(name, ".tbl") || has_suffix(name, ".mp") || has_suffix(name, ".dat")) {
+        paths.insert(dir->second + name);
+      }
+    }
+  }
+
+  return length > 0;
+}
+
+
+/*************************************************************************
+ * Function: watch_loop
+ * Description: the watcher thread. Gathers changed files until none have
+ *              changed for RELOAD_SETTLE_MS, waits for the last reload to
+ *              be applied, then reads the changes and publishes them in
+ *              the handoff slot.
+ * Parameters: none
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: none
+ ************************************************************************/
+void Reloader::watch_loop()
+{
+  struct pollfd fds[2];
+  std::set<std::string> paths;    /* files changed since the last reload */
+  gamedata_reload *reload;
+  bool watching = true;
+
+  fds[0].fd = this->watch_fd;
+  fds[0].events = POLLIN;
+  fds[1].fd = this->wake_fds[0];
+  fds[1].events = POLLIN;
+
+  while (watching) {
+    if (poll(fds, 2, paths.empty() ? -1 : RELOAD_SETTLE_MS) > 0) {
+      if (fds[1].revents != 0) {
+        watching = false;
+      } else if (fds[0].revents & POLLIN) {
+        this->read_events(paths);
+      }
+
+    } else if (!paths.empty()) {
+      {
+        std::unique_lock<std::mutex> guard(this->lock);
+        while (this->running && this->ready.load(std::memory_order_acquire) != NULL) {
+          this->applied.wait(guard);
+        }
+        watching = this->running;
+      }
+
+      if (watching) {
+        reload = new gamedata_reload;
+        reload->paths.swap(paths);
+        this->game->parse_reload(*reload);
+        this->ready.store(reload, std::memory_order_release);
+      }
+    }
+  }
+}
@@ -0,0 +1,77 @@
+/*************************************************************************
+ * Program Filename: Reloader.hpp
+ * Author: David Bacher-Hicks
+ * Date: 19 October 2026
+ * Description: A class declaration file for a Reloader class. In
+ *              development mode the reloader watches the gamedata
+ *              directories and re-reads changed tables and maps on a
+ *              background thread, for the game to apply between turns.
+ * Input:  the gamedata directories
+ * Output: none
+ ************************************************************************/
+
+#ifndef RELOADER_HPP
+#define RELOADER_HPP
+
+#include <map>
+#include <set>
+#include <vector>
+#include <string>
+#include <sstream>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+class Game;
+class Floor;
+class Item;
+struct mob_data;
+
+/* how long the gamedata must be left alone before changes are read, in ms */
+const int RELOAD_SETTLE_MS = 200;
+
+/*
+ * gamedata re-read after a change. The game takes ownership of what it
+ * applies by setting the entry to NULL; anything left is freed with the
+ * reload
+ */
+struct gamedata_reload {
+  std::set<std::string> paths;      /* the changed files */
+  std::vector<Item *> items;        /* new and changed items */
+  std::vector<mob_data *> mobs;     /* new and changed monsters */
+  std::map<int, Floor *> floors;    /* rebuilt layouts, by floor number */
+  std::ostringstream log;           /* messages from reading the files */
+
+  ~gamedata_reload();
+};
+
+class Reloader {
+  private:
+    Game *game;                 /* the game whose data is reloaded */
+
+    int watch_fd;               /* inotify instance, or -1 */
+    int wake_fds[2];            /* pipe that wakes the watcher to stop */
+    std::map<int, std::string> watched;  /* directory of each watch */
+    bool running;               /* whether the watcher should keep running */
+    std::mutex lock;            /* guards running and the empty slot */
+    std::condition_variable applied;
+    std::thread watcher;
+
+    std::atomic<gamedata_reload *> ready;  /* handoff slot: a reload, or NULL */
+
+    void watch_loop();
+    bool read_events(std::set<std::string> &paths);
+
+  public:
+    Reloader(Game *game);
+    ~Reloader();
+
+    bool start();
+    void stop();
+
+    gamedata_reload *collect() { return this->ready.load(std::memory_order_acquire); }
+    void finish();
+};
+
+#endif
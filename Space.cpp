@@ -30,16 +30,49 @@ Space::Space(const Coord &coord)
 {
   this->coord = coord;
   this->present_character = NULL;
-  this->linked_spaces.insert(std::pair<direction, Space *>(UP, NULL));
-  this->linked_spaces.insert(std::pair<direction, Space *>(RIGHT, NULL));
-  this->linked_spaces.insert(std::pair<direction, Space *>(DOWN, NULL));
-  this->linked_spaces.insert(std::pair<direction, Space *>(LEFT, NULL));
+  this->present_mob = NO_ENTITY;
+  this->kind = TILE_OPEN;
+  this->linked_spaces[UP] = NULL;
+  this->linked_spaces[RIGHT] = NULL;
+  this->linked_spaces[DOWN] = NULL;
+  this->linked_spaces[LEFT] = NULL;
+  this->boards = NULL;
+}
+
+
+/*************************************************************************
+ * Function: set_boards
+ * Description: gives the space its floor's boards, and puts the space's
+ *              state on them; from then on the space keeps them up to
+ *              date as its state changes
+ * Parameters: boards - the floor's boards
+ * Pre-conditions: the space must be within the boards, and its tile on
+ *                 them a wall and nothing else, as a resize leaves it
+ * Post-conditions: the boards hold the space's state
+ * Returns: none
+ ************************************************************************/
+void Space::set_boards(Bitboards *boards)
+{
+  this->boards = boards;
+  this->mark(BOARD_WALL, false);
+
+  if ((this->kind == TILE_DOOR || this->kind == TILE_SECRET_DOOR) && !this->passable()) {
+    this->mark(BOARD_CLOSED_DOOR, true);
+  }
+  if (this->occupied()) {
+    this->mark(BOARD_OCCUPIED, true);
+  }
+  if (!this->items.empty()) {
+    this->mark(BOARD_ITEMS, true);
+    this->mark(BOARD_BLOCKING, this->kind == TILE_OPEN && !this->passable());
+  }
 }
 
 
 /*************************************************************************
  * Function: get_render_char
- * Description: returns the character to be rendered for this space
+ * Description: returns the character to be rendered for this space, or
+ *              MOB_SPACE_C for a monster, which its floor draws
  * Parameters: none
  * Pre-conditions: none
  * Post-conditions:  none
@@ -51,7 +84,9 @@ char Space::get_render_char() const
 
   if (this->present_character != NULL) {
     c = this->present_character->get_render_char();
-  }  
+  } else if (this->present_mob.index != NO_ENTITY.index) {
+    c = MOB_SPACE_C;
+  }
 
   return c;
 }
@@ -69,8 +104,9 @@ bool Space::add_character(Character *character)
 {
   bool added_character = false;
 
-  if (this->present_character == NULL && this->passable()){
+  if (!this->occupied() && this->passable()){
     this->present_character = character;
+    this->mark(BOARD_OCCUPIED, true);
     added_character = true;
   }
 
@@ -92,6 +128,7 @@ bool Space::delete_character()
 
   if ( this->present_character != NULL ) {
     this->present_character = NULL;
+    this->mark(BOARD_OCCUPIED, false);
     deleted = true;
   }
 
@@ -111,10 +148,55 @@ Character * Space::remove_character()
 {
   Character *character = this->present_character;
   this->present_character = NULL;
+  this->mark(BOARD_OCCUPIED, this->occupied());
   return character;
 }
 
 
+/*************************************************************************
+ * Function: add_mob
+ * Description: puts a monster on the space
+ * Parameters: mob - the monster's handle
+ * Pre-conditions: none
+ * Post-conditions: The monster will have been added to the space
+ * Returns: bool - true if the monster was added
+ ************************************************************************/
+bool Space::add_mob(entity mob)
+{
+  bool added_mob = false;
+
+  if (!this->occupied() && this->passable()){
+    this->present_mob = mob;
+    this->mark(BOARD_OCCUPIED, true);
+    added_mob = true;
+  }
+
+  return added_mob;
+}
+
+
+/*************************************************************************
+ * Function: delete_mob
+ * Description: removes a monster from the space
+ * Parameters: none
+ * Pre-conditions: none
+ * Post-conditions: the monster will have been removed from the space
+ * Returns: bool - true if a monster was removed
+ ************************************************************************/
+bool Space::delete_mob()
+{
+  bool deleted = false;
+
+  if ( this->present_mob != NO_ENTITY ) {
+    this->present_mob = NO_ENTITY;
+    this->mark(BOARD_OCCUPIED, false);
+    deleted = true;
+  }
+
+  return deleted;
+}
+
+
         ////////////////////////////////////////////////////////
        //                   OpenSpace                        //
       ////////////////////////////////////////////////////////
@@ -140,21 +222,40 @@ bool OpenSpace::passable()
   return pass;
 }
 
+/*************************************************************************
+ * Function: add_item
+ * Description: puts an item on the space
+ * Parameters: item - the item
+ * Pre-conditions: none
+ * Post-conditions: the item is on the space
+ * Returns: bool - true, as an open space holds any item
+ ************************************************************************/
+bool OpenSpace::add_item(Item *item)
+{
+  this->items.push_back(item);
+  this->mark(BOARD_ITEMS, true);
+  if (!item->passable()) {
+    this->mark(BOARD_BLOCKING, true);
+  }
+
+  return true;
+}
+
 /*************************************************************************
  * Function: remove_item
  * Description: removes an item
- * Parameters: item_ID - the item ID of the item to remove
+ * Parameters: item_num - the item number of the item to remove
  * Pre-conditions: none
  * Post-conditions: the item, if it was found, is removed.
  * Returns: Item* - the item removed
  ************************************************************************/
-Item * OpenSpace::remove_item(std::string item_ID)
+Item * OpenSpace::remove_item(int item_num)
 {
   Item *item = NULL;
   std::vector<Item*>::iterator it;
 
   for ( auto i = this->items.begin(); (i != items.end()) && (item == NULL); i++ ){
-    if ((*i)->id() == item_ID){
+    if ((*i)->num() == item_num){
       item = *i;
       it = i;
     }
@@ -162,6 +263,8 @@ Item * OpenSpace::remove_item(std::string item_ID)
 
   if ( item != NULL ){
     this->items.erase(it);
+    this->mark(BOARD_ITEMS, !this->items.empty());
+    this->mark(BOARD_BLOCKING, !this->passable());
   }
 
   return item;
@@ -181,6 +284,8 @@ char OpenSpace::get_render_char() const
 
   if ( this->present_character != NULL ) {
     c = this->present_character->get_render_char();
+  } else if ( this->present_mob.index != NO_ENTITY.index ) {
+    c = MOB_SPACE_C;
   } else if ( this->items.size() != 0 ) {
     c = ITEM_SPACE_C;
   }
@@ -205,6 +310,7 @@ bool Door::open()
 {
   bool was_open = this->is_open;
   this->is_open = true;
+  this->mark(BOARD_CLOSED_DOOR, false);
   return (was_open != this->is_open);
 }
 
@@ -223,6 +329,7 @@ bool Door::close()
   
   if (this->is_open) {
     this->is_open = false;
+    this->mark(BOARD_CLOSED_DOOR, true);
   }
 
   return (was_open != this->is_open);
@@ -243,6 +350,8 @@ char Door::get_render_char() const
 
   if ( this->present_character != NULL ) {
     c = this->present_character->get_render_char();
+  } else if ( this->present_mob.index != NO_ENTITY.index ) {
+    c = MOB_SPACE_C;
   } else if ( this->items.size() != 0 ) {
     c = ITEM_SPACE_C;
   } else if ( this->is_open ) {
@@ -271,6 +380,7 @@ bool SecretDoor::open()
 {
   bool was_open = this->is_open;
   this->is_open = true;
+  this->mark(BOARD_CLOSED_DOOR, false);
   return (this->is_open != was_open);
 }
 
@@ -288,6 +398,8 @@ char SecretDoor::get_render_char() const
 
   if ( this->present_character != NULL ) {
     c = this->present_character->get_render_char();
+  } else if ( this->present_mob.index != NO_ENTITY.index ) {
+    c = MOB_SPACE_C;
   } else if ( this->is_open ){
     c = EMPTY_SPACE_C;
   } else {
@@ -16,6 +16,8 @@
 #include <string>
 #include "Item.hpp"
 #include "Coord.hpp"
+#include "Entities.hpp"
+#include "Bitboards.hpp"
 
 class Floor;
 class Character;
@@ -32,8 +34,11 @@ const char WALL_C         = '#';
 const char UP_STAIR_C     = '^';
 const char DOWN_STAIR_C   = 'v';
 const char HIDDEN_DOOR_C  = '%'; 
+const char MOB_SPACE_C    = '\0';     /* a monster, drawn by its floor's glyphs */
 
-enum direction {UP, RIGHT, DOWN, LEFT};
+/* the kind of each space, so moves into it dispatch on a tag */
+enum tile_kind { TILE_OPEN, TILE_WALL, TILE_DOOR, TILE_SECRET_DOOR,
+                 TILE_UP_STAIR, TILE_DOWN_STAIR, TILE_COUNT };
 
 
           ////////////////////////////////////////////////////////
@@ -43,10 +48,16 @@ enum direction {UP, RIGHT, DOWN, LEFT};
 class Space{
   protected:
     std::vector<Item*> items;
-    Character *present_character;
+    Character *present_character;       /* the player, if here */
+    entity present_mob;                 /* the monster here, or NO_ENTITY */
     Coord coord;
     char render_char;
-    std::map<direction, Space *> linked_spaces;
+    tile_kind kind;                     /* set by each subclass */
+    Space *linked_spaces[4];            /* adjacent spaces, by direction */
+    Bitboards *boards;                  /* the floor's boards, kept up to date, or NULL */
+
+    void mark(board which, bool on)
+      { if (this->boards != NULL) this->boards->set(which, this->coord.x(), this->coord.y(), on); }
 
   public:
     /* Constructors, Destructors, Pure Virtuals */
@@ -56,22 +67,31 @@ class Space{
     virtual bool passable() = 0;
     virtual bool is_locked() { return false; };
     void link(Space *space, direction dir) { this->linked_spaces[dir] = space; }
+    void set_boards(Bitboards *boards);
 
     /* Character methods */
+    bool occupied() const { return this->present_character != NULL || this->present_mob != NO_ENTITY; }
     Character *get_character() { return this->present_character; }
     bool add_character(Character *character);
     bool delete_character();
     Character *remove_character();
+    entity get_mob() const { return this->present_mob; }
+    bool add_mob(entity mob);
+    bool delete_mob();
 
     /* Item methods */
     std::vector<Item*> *get_items() { return &items; }
     virtual bool add_item(Item *item) { return false; }
-    virtual Item *remove_item(std::string itemID) { return NULL; }
+    virtual Item *remove_item(int item_num) { return NULL; }
 
     /* render character getters/setters */
     void set_render_char(char c) { this->render_char = c; }
     virtual char get_render_char() const;
 
+    /* kind getters */
+    tile_kind get_kind() const { return this->kind; }
+    bool is_stair() const { return this->kind == TILE_UP_STAIR || this->kind == TILE_DOWN_STAIR; }
+
     /* Coordinate getters */
     Coord get_coord() { return this->coord; }
     int x() { return this->coord.x(); }
@@ -84,12 +104,12 @@ class Space{
 
 class OpenSpace : public Space {
   public:
-    OpenSpace(const Coord &coord) : Space(coord) { this->render_char = EMPTY_SPACE_C; }    
-    OpenSpace(int x, int y) : Space(x, y) { this->render_char = EMPTY_SPACE_C; }
+    OpenSpace(const Coord &coord) : Space(coord) { this->render_char = EMPTY_SPACE_C; this->kind = TILE_OPEN; }
+    OpenSpace(int x, int y) : Space(x, y) { this->render_char = EMPTY_SPACE_C; this->kind = TILE_OPEN; }
     virtual bool passable();
     virtual char get_render_char() const;
-    virtual bool add_item(Item *item) { this->items.push_back(item); return true; }
-    virtual Item * remove_item(std::string itemID);
+    virtual bool add_item(Item *item);
+    virtual Item * remove_item(int item_num);
 };
 
           ////////////////////////////////////////////////////////
@@ -99,8 +119,8 @@ class OpenSpace : public Space {
 class Wall : public Space {
   protected:
   public:
-    Wall(const Coord &coord) : Space(coord) { render_char = WALL_C; }
-    Wall(int x, int y) : Space(x, y) { render_char = WALL_C; }
+    Wall(const Coord &coord) : Space(coord) { render_char = WALL_C; kind = TILE_WALL; }
+    Wall(int x, int y) : Space(x, y) { render_char = WALL_C; kind = TILE_WALL; }
     virtual bool passable() { return false; }
 };
 
@@ -111,20 +131,20 @@ class Wall : public Space {
 class Door : public Space {
   protected:
     bool is_open;
-    std::string keyID;
+    int key;                        /* item number of the key, or NO_ID */
         
   public:
-    Door(const Coord &coord, std::string keyID = "") : 
-      Space(coord) { this->is_open = false; this->keyID = keyID; }
+    Door(const Coord &coord, int key = NO_ID) : 
+      Space(coord) { this->is_open = false; this->key = key; this->kind = TILE_DOOR; }
 
-    Door(int x, int y, std::string keyID = "") : 
-      Space(x, y) { this->is_open = false; this->keyID = keyID; }
+    Door(int x, int y, int key = NO_ID) : 
+      Space(x, y) { this->is_open = false; this->key = key; this->kind = TILE_DOOR; }
 
     virtual bool passable() { return this->is_open; }
     virtual char get_render_char() const;
-    virtual bool is_locked() { return !(this->keyID == ""); }
-    std::string key_str() { return this->keyID; }
-    void set_key(std::string keyID) { this->keyID = keyID; }
+    virtual bool is_locked() { return this->key != NO_ID; }
+    int get_key() { return this->key; }
+    void set_key(int key) { this->key = key; }
     bool open();
     bool close();
 };
@@ -139,10 +159,10 @@ class SecretDoor : public Space {
         
   public:
     SecretDoor(const Coord &coord) : 
-      Space(coord) { this->is_open = false; }
+      Space(coord) { this->is_open = false; this->kind = TILE_SECRET_DOOR; }
 
     SecretDoor(int x, int y) : 
-      Space(x, y) { this->is_open = false; }
+      Space(x, y) { this->is_open = false; this->kind = TILE_SECRET_DOOR; }
 
     virtual bool passable() { return this->is_open; }
     virtual char get_render_char() const; 
@@ -156,17 +176,17 @@ class SecretDoor : public Space {
 class Stair : public Space {
   protected:
     Coord linked_coord;
-    std::string linked_floor_ID;
+    int linked_floor;               /* floor number, or NO_ID */
 
   public:
     Stair(const Coord &coord, char c) : 
-      Space(coord) { this->render_char = c; }
+      Space(coord) { this->render_char = c; this->linked_floor = NO_ID; }
     Stair(int x, int y, char c) : 
-      Space(x, y) { this->render_char = c; }
+      Space(x, y) { this->render_char = c; this->linked_floor = NO_ID; }
 
     void set_linked_coord(Coord coord) { this->linked_coord = coord; }
-    void set_linked_floor_ID( std::string id ) { this->linked_floor_ID = id; }
-    std::string get_linked_floor_ID () { return this->linked_floor_ID; }
+    void set_linked_floor( int floor ) { this->linked_floor = floor; }
+    int get_linked_floor () { return this->linked_floor; }
     Coord get_linked_coord () { return this->linked_coord; }
 
     virtual bool passable() { return true; }
@@ -179,10 +199,10 @@ class Stair : public Space {
 class UpStair : public Stair {
   public:   
     UpStair(const Coord &coord) : 
-      Stair(coord, UP_STAIR_C) {}
+      Stair(coord, UP_STAIR_C) { this->kind = TILE_UP_STAIR; }
 
     UpStair(int x, int y, Space *linked_stair = NULL, Floor *linked_floor = NULL) : 
-      Stair(x, y, UP_STAIR_C) {}
+      Stair(x, y, UP_STAIR_C) { this->kind = TILE_UP_STAIR; }
 };
 
           ////////////////////////////////////////////////////////
@@ -192,10 +212,10 @@ class UpStair : public Stair {
 class DownStair : public Stair {
   public:
     DownStair(const Coord &coord) : 
-      Stair(coord, DOWN_STAIR_C) {}
+      Stair(coord, DOWN_STAIR_C) { this->kind = TILE_DOWN_STAIR; }
 
     DownStair(int x, int y) : 
-      Stair(x, y, DOWN_STAIR_C) {}
+      Stair(x, y, DOWN_STAIR_C) { this->kind = TILE_DOWN_STAIR; }
 };
 
 #endif
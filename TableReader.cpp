@@ -0,0 +1,365 @@
+/*************************************************************************
+ * Program Filename: TableReader.cpp
+ * Author: David Bacher-Hicks
+ * Date: 19 October 2026
+ * Description: A class definition file for a TableReader class. The file
+ *              is mapped into memory, and each field is returned as a 
+ *              slice of the mapping, so reading a record allocates 
+ *              nothing. Records are lines; fields are quoted strings, bare
+ *              words and numbers, separated by blanks. A field that does 
+ *              not match what was expected fails with an error giving the
+ *              file, line and column.
+ * Input:  a gamedata text file
+ * Output: none
+ ************************************************************************/
+
+#include <cstdlib>
+#include <climits>
+#include <sstream>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "TableReader.hpp"
+
+/* powers of ten that a double holds exactly */
+static const double EXACT_POWERS_OF_TEN[] = {
+  1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+  1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+static const int MAX_EXACT_POWER = 22;
+static const unsigned long long MAX_EXACT_MANTISSA = 1ULL << 53;
+
+/*************************************************************************
+ * Function: TableReader
+ * Description: constructor
+ * Parameters: none
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: none
+ ************************************************************************/
+TableReader::TableReader()
+{
+  this->mapping = NULL;
+  this->length = 0;
+  this->end = this->line_start = this->record_end = this->cursor = NULL;
+  this->line = 0;
+}
+
+
+/*************************************************************************
+ * Function: ~TableReader
+ * Description: destructor; unmaps the file
+ * Parameters: none
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: none
+ ************************************************************************/
+TableReader::~TableReader()
+{
+  this->close();
+}
+
+
+/*************************************************************************
+ * Function: open
+ * Description: maps a file for reading. An empty file opens, with no 
+ *              records.
+ * Parameters: path - the path of the file
+ * Pre-conditions: none
+ * Post-conditions: the reader is before the first record
+ * Returns: bool - true if the file was opened
+ ************************************************************************/
+bool TableReader::open(const std::string &path)
+{
+  struct stat st;
+  bool opened = false;
+  int fd;
+
+  this->close();
+  this->path = path;
+
+  if ((fd = ::open(path.c_str(), O_RDONLY)) != -1) {
+    if (fstat(fd, &st) == 0) {
+      if (st.st_size == 0) {
+        opened = true;
+
+      } else {
+        this->mapping = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (this->mapping != MAP_FAILED) {
+          this->length = st.st_size;
+          this->end = static_cast<const char *>(this->mapping) + this->length;
+          opened = true;
+        } else {
+          this->mapping = NULL;
+        }
+      }
+    }
+    ::close(fd);
+  }
+
+  if (!opened) {
+    this->message = path + ": could not be opened";
+  }
+
+  return opened;
+}
+
+
+/*************************************************************************
+ * Function: close
+ * Description: unmaps the file; slices read from it become invalid
+ * Parameters: none
+ * Pre-conditions: none
+ * Post-conditions: the reader has no records
+ * Returns: none
+ ************************************************************************/
+void TableReader::close()
+{
+  if (this->mapping != NULL) {
+    munmap(this->mapping, this->length);
+  }
+  this->mapping = NULL;
+  this->length = 0;
+  this->end = this->line_start = this->record_end = this->cursor = NULL;
+  this->line = 0;
+}
+
+
+/*************************************************************************
+ * Function: next_record
+ * Description: moves to the next record that is not blank
+ * Parameters: none
+ * Pre-conditions: none
+ * Post-conditions: fields are read from the new record
+ * Returns: bool - false once there are no more records
+ ************************************************************************/
+bool TableReader::next_record()
+{
+  bool found = false;
+  const char *newline;
+
+  while (!found && this->mapping != NULL && this->record_end != this->end) {
+    this->line_start = (this->record_end == NULL) ? 
+      static_cast<const char *>(this->mapping) : this->record_end + 1;
+    newline = static_cast<const char *>(
+      memchr(this->line_start, '\n', this->end - this->line_start));
+    this->record_end = (newline != NULL) ? newline : this->end;
+    this->cursor = this->line_start;
+    this->line++;
+
+    this->skip_blanks();
+    found = !this->at_record_end();
+  }
+
+  return found;
+}
+
+
+/*************************************************************************
+ * Function: at_record_end
+ * Description: returns whether the current record has no fields left
+ * Parameters: none
+ * Pre-conditions: none
+ * Post-conditions: trailing blanks are skipped
+ * Returns: bool - true if there are no fields left
+ ************************************************************************/
+bool TableReader::at_record_end()
+{
+  this->skip_blanks();
+  return this->cursor >= this->record_end;
+}
+
+
+/*************************************************************************
+ * Function: read_string
+ * Description: reads a quoted string field
+ * Parameters: field - set to the characters between the quotes
+ *             quote - the quote character
+ * Pre-conditions: none
+ * Post-conditions: the reader is past the closing quote
+ * Returns: bool - false, with an error, if there is no quoted field
+ ************************************************************************/
+bool TableReader::read_string(slice &field, char quote)
+{
+  bool read = false;
+  const char *closing;
+
+  if (!this->at_record_end() && *this->cursor == quote) {
+    closing = static_cast<const char *>(
+      memchr(this->cursor + 1, quote, this->record_end - this->cursor - 1));
+    if (closing != NULL) {
+      field.data = this->cursor + 1;
+      field.size = closing - field.data;
+      this->cursor = closing + 1;
+      read = true;
+    }
+  }
+
+  return read || this->fail("a quoted string");
+}
+
+
+/*************************************************************************
+ * Function: read_word
+ * Description: reads a field of characters other than blanks
+ * Parameters: field - set to the field
+ * Pre-conditions: none
+ * Post-conditions: the reader is past the field
+ * Returns: bool - false, with an error, if there are no fields left
+ ************************************************************************/
+bool TableReader::read_word(slice &field)
+{
+  bool read = false;
+
+  if (!this->at_record_end()) {
+    field.data = this->cursor;
+    while (this->cursor < this->record_end && *this->cursor != ' ' && 
+           *this->cursor != '\t' && *this->cursor != '\r') {
+      this->cursor++;
+    }
+    field.size = this->cursor - field.data;
+    read = true;
+  }
+
+  return read || this->fail("a word");
+}
+
+
+/*************************************************************************
+ * Function: read_int
+ * Description: reads a whole number field, with an optional sign
+ * Parameters: value - set to the number
+ * Pre-conditions: none
+ * Post-conditions: the reader is past the field
+ * Returns: bool - false, with an error, if the field is not a whole 
+ *                 number that fits in an int
+ ************************************************************************/
+bool TableReader::read_int(int &value)
+{
+  const char *start;
+  long long number = 0;
+  bool negative = false;
+  bool read = false;
+
+  if (!this->at_record_end()) {
+    start = this->cursor;
+    if (*this->cursor == '-' || *this->cursor == '+') {
+      negative = (*this->cursor++ == '-');
+    }
+
+    while (this->cursor < this->record_end && *this->cursor >= '0' && *this->cursor <= '9' &&
+           number <= INT_MAX) {
+      number = number * 10 + (*this->cursor++ - '0');
+    }
+
+    read = (this->cursor > start + (negative || *start == '+') && number <= INT_MAX &&
+            (this->cursor == this->record_end || *this->cursor == ' ' || 
+             *this->cursor == '\t' || *this->cursor == '\r'));
+    if (read) {
+      value = static_cast<int>(negative ? -number : number);
+    } else {
+      this->cursor = start;
+    }
+  }
+
+  return read || this->fail("a whole number");
+}
+
+
+/*************************************************************************
+ * Function: read_double
+ * Description: reads a decimal number field, with an optional sign. The
+ *              digits are gathered into an integer and scaled by an exact
+ *              power of ten, which is correctly rounded whenever both fit
+ *              a double exactly; longer numbers fall back to strtod.
+ * Parameters: value - set to the number
+ * Pre-conditions: none
+ * Post-conditions: the reader is past the field
+ * Returns: bool - false, with an error, if the field is not a number
+ ************************************************************************/
+bool TableReader::read_double(double &value)
+{
+  const char *start;
+  unsigned long long mantissa = 0;
+  int digits = 0, decimals = 0;
+  bool negative = false, in_fraction = false;
+  bool read = false;
+
+  if (!this->at_record_end()) {
+    start = this->cursor;
+    if (*this->cursor == '-' || *this->cursor == '+') {
+      negative = (*this->cursor++ == '-');
+    }
+
+    while (this->cursor < this->record_end && 
+           ((*this->cursor >= '0' && *this->cursor <= '9') || 
+            (*this->cursor == '.' && !in_fraction))) {
+      if (*this->cursor == '.') {
+        in_fraction = true;
+      } else {
+        if (digits < 19) {
+          mantissa = mantissa * 10 + (*this->cursor - '0');
+          decimals += in_fraction;
+        } else {
+          decimals += in_fraction - 1;
+        }
+        digits++;
+      }
+      this->cursor++;
+    }
+
+    read = (digits > 0 &&
+            (this->cursor == this->record_end || *this->cursor == ' ' || 
+             *this->cursor == '\t' || *this->cursor == '\r'));
+    if (read) {
+      if (mantissa <= MAX_EXACT_MANTISSA && decimals >= 0 && decimals <= MAX_EXACT_POWER) {
+        value = mantissa / EXACT_POWERS_OF_TEN[decimals];
+        value = negative ? -value : value;
+      } else {
+        value = strtod(std::string(start, this->cursor - start).c_str(), NULL);
+      }
+    } else {
+      this->cursor = start;
+    }
+  }
+
+  return read || this->fail("a number");
+}
+
+
+/*************************************************************************
+ * Function: skip_blanks
+ * Description: moves the cursor past spaces, tabs and carriage returns
+ * Parameters: none
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: none
+ ************************************************************************/
+void TableReader::skip_blanks()
+{
+  while (this->cursor < this->record_end && 
+         (*this->cursor == ' ' || *this->cursor == '\t' || *this->cursor == '\r')) {
+    this->cursor++;
+  }
+}
+
+
+/*************************************************************************
+ * Function: fail
+ * Description: records an error at the cursor
+ * Parameters: expected - what the field should have been
+ * Pre-conditions: none
+ * Post-conditions: the error can be read with error()
+ * Returns: bool - false
+ ************************************************************************/
+bool TableReader::fail(const char *expected)
+{
+  std::ostringstream error;
+
+  error << this->path << ':' << this->line << ':' << (this->cursor - this->line_start + 1)
+        << ": expected " << expected;
+  this->message = error.str();
+
+  return false;
+}
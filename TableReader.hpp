@@ -0,0 +1,69 @@
+/*************************************************************************
+ * Program Filename: TableReader.hpp
+ * Author: David Bacher-Hicks
+ * Date: 19 October 2026
+ * Description: A class declaration file for a TableReader class, which
+ *              reads the records of a gamedata text file (.tbl, .dat) 
+ *              field by field, without copying them.
+ * Input:  a gamedata text file
+ * Output: none
+ ************************************************************************/
+
+#ifndef TABLEREADER_HPP
+#define TABLEREADER_HPP
+
+#include <string>
+#include <cstring>
+#include <cstddef>
+#include <ostream>
+
+/* a run of characters inside the file being read; valid until it is closed */
+struct slice {
+  const char *data;
+  size_t size;
+
+  std::string str() const { return std::string(this->data, this->size); }
+  bool operator==(const char *text) const
+    { return strlen(text) == this->size && memcmp(text, this->data, this->size) == 0; }
+  bool operator!=(const char *text) const { return !(*this == text); }
+};
+
+inline std::ostream &operator<<(std::ostream &out, const slice &field)
+{
+  return out.write(field.data, field.size);
+}
+
+class TableReader {
+  private:
+    std::string path;         /* path of the file, for error messages */
+    void *mapping;            /* the mapped file, or NULL */
+    size_t length;            /* size of the mapping */
+    const char *end;          /* end of the file */
+    const char *line_start;   /* start of the current record */
+    const char *record_end;   /* end of the current record, at its newline */
+    const char *cursor;       /* next character to read in the record */
+    int line;                 /* line number of the current record */
+    std::string message;      /* the last error */
+
+    void skip_blanks();
+    bool fail(const char *expected);
+
+  public:
+    TableReader();
+    ~TableReader();
+
+    bool open(const std::string &path);
+    void close();
+
+    bool next_record();
+    bool at_record_end();
+    bool read_string(slice &field, char quote = '"');
+    bool read_word(slice &field);
+    bool read_int(int &value);
+    bool read_double(double &value);
+
+    int line_number() { return this->line; }
+    const std::string &error() { return this->message; }
+};
+
+#endif
@@ -0,0 +1,128 @@
+/*************************************************************************
+ * Program Filename: TaskGraph.cpp
+ * Author: David Bacher-Hicks
+ * Date: 19 October 2026
+ * Description: A class definition file for a TaskGraph class. Tasks are
+ *              added with the tasks they depend on, which must already 
+ *              have been added, so the graph can have no cycles. Running
+ *              the graph starts a pool of threads that take tasks as they
+ *              become free to start, until every task has finished.
+ * Input:  none
+ * Output: none
+ ************************************************************************/
+
+#include <thread>
+#include "TaskGraph.hpp"
+
+/*************************************************************************
+ * Function: TaskGraph
+ * Description: constructor
+ * Parameters: none
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: none
+ ************************************************************************/
+TaskGraph::TaskGraph()
+{
+  this->unfinished = 0;
+}
+
+
+/*************************************************************************
+ * Function: add
+ * Description: adds a task to the graph
+ * Parameters: run - the work to do
+ *             deps - the tasks that must finish before this one starts
+ * Pre-conditions: every task in deps was returned by an earlier add, and
+ *                 the graph is not running
+ * Post-conditions: the task will run on the next run
+ * Returns: int - the task, for use in the deps of later tasks
+ ************************************************************************/
+int TaskGraph::add(std::function<void()> run, const std::vector<int> &deps)
+{
+  int id = this->tasks.size();
+
+  this->tasks.push_back(task());
+  this->tasks.back().run = run;
+  this->tasks.back().waiting = 0;
+
+  for (auto i = deps.begin(); i != deps.end(); i++) {
+    if (*i >= 0 && *i < id) {
+      this->tasks[*i].dependents.push_back(id);
+      this->tasks.back().waiting++;
+    }
+  }
+
+  if (this->tasks.back().waiting == 0) {
+    this->ready.push_back(id);
+  }
+  this->unfinished++;
+
+  return id;
+}
+
+
+/*************************************************************************
+ * Function: run
+ * Description: runs every task, on the calling thread and threads - 1 
+ *              others, and returns once they have all finished
+ * Parameters: threads - the number of threads to run tasks on
+ * Pre-conditions: none
+ * Post-conditions: every task has run, and the graph is empty
+ * Returns: none
+ ************************************************************************/
+void TaskGraph::run(int threads)
+{
+  std::vector<std::thread> pool;
+
+  for (int i = 1; i < threads; i++) {
+    pool.push_back(std::thread(&TaskGraph::work, this));
+  }
+  this->work();
+
+  for (auto i = pool.begin(); i != pool.end(); i++) {
+    i->join();
+  }
+
+  this->tasks.clear();
+  this->ready.clear();
+}
+
+
+/*************************************************************************
+ * Function: work
+ * Description: a pool thread. Takes free tasks and runs them, freeing 
+ *              their dependents as they finish, until no task is left.
+ * Parameters: none
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: none
+ ************************************************************************/
+void TaskGraph::work()
+{
+  std::unique_lock<std::mutex> guard(this->lock);
+  int id;
+
+  while (this->unfinished > 0) {
+    if (this->ready.empty()) {
+      this->wake.wait(guard);
+
+    } else {
+      id = this->ready.back();
+      this->ready.pop_back();
+
+      guard.unlock();
+      this->tasks[id].run();
+      guard.lock();
+
+      this->unfinished--;
+      for (auto i = this->tasks[id].dependents.begin(); 
+           i != this->tasks[id].dependents.end(); i++) {
+        if (--this->tasks[*i].waiting == 0) {
+          this->ready.push_back(*i);
+        }
+      }
+      this->wake.notify_all();
+    }
+  }
+}
@@ -0,0 +1,43 @@
+/*************************************************************************
+ * Program Filename: TaskGraph.hpp
+ * Author: David Bacher-Hicks
+ * Date: 19 October 2026
+ * Description: A class declaration file for a TaskGraph class. A task 
+ *              graph runs a set of tasks on a pool of threads, starting
+ *              each task once the tasks it depends on have finished.
+ * Input:  none
+ * Output: none
+ ************************************************************************/
+
+#ifndef TASKGRAPH_HPP
+#define TASKGRAPH_HPP
+
+#include <vector>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+
+class TaskGraph {
+  private:
+    struct task {
+      std::function<void()> run;    /* the work to do */
+      std::vector<int> dependents;  /* tasks waiting on this one */
+      int waiting;                  /* unfinished tasks this one depends on */
+    };
+
+    std::vector<task> tasks;
+    std::vector<int> ready;         /* tasks free to start */
+    int unfinished;                 /* tasks not yet finished */
+    std::mutex lock;                /* guards tasks, ready and unfinished while running */
+    std::condition_variable wake;
+
+    void work();
+
+  public:
+    TaskGraph();
+
+    int add(std::function<void()> run, const std::vector<int> &deps);
+    void run(int threads);
+};
+
+#endif
@@ -0,0 +1,254 @@
+/*************************************************************************
+ * Program Filename: ThreadRings.hpp
+ * Author: David Bacher-Hicks
+ * Date: 19 October 2026
+ * Description: A class template declaration and definition file for a
+ *              ThreadRings class, the per-thread rings the Logger and the
+ *              Tracer are written through. Each thread that writes gets a
+ *              ring of its own, a single-writer, single-reader ring of
+ *              SIZE entries, claimed on its first write and kept until it
+ *              exits; the ring is then reused by the next new thread once
+ *              it has been emptied. Writing takes no lock once the thread
+ *              has a ring, and an entry that finds the ring full is
+ *              counted and dropped rather than making the writer wait. A
+ *              background thread drains every ring.
+ * Input:  none
+ * Output: none
+ ************************************************************************/
+
+#ifndef THREADRINGS_HPP
+#define THREADRINGS_HPP
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <cstdint>
+
+template <typename Entry, int SIZE>
+class ThreadRings {
+  private:
+    /* a single-writer, single-reader ring of entries for one thread */
+    struct ring {
+      std::vector<Entry> entries;
+      std::atomic<uint32_t> head;     /* next entry to write; moved by the writer */
+      std::atomic<uint32_t> tail;     /* next entry to read; moved by the drain */
+      std::atomic<uint32_t> dropped;  /* entries lost to a full ring */
+      std::atomic<bool> in_use;       /* whether a thread is writing to it */
+      uint32_t thread;                /* index of the ring */
+      std::string name;               /* the writing thread's name, if given */
+    };
+
+    /* the ring of the calling thread, and the rings it belongs to */
+    struct thread_ring {
+      std::shared_ptr<ring> owned;
+      unsigned long owner_id;
+
+      ~thread_ring()
+        { if (this->owned) this->owned->in_use.store(false, std::memory_order_release); }
+    };
+
+    static thread_local thread_ring local_ring;
+    static std::atomic<unsigned long> next_id;
+
+    unsigned long id;                   /* tells these rings from others' */
+    uint32_t first_thread;              /* index of the first ring */
+    std::vector<std::shared_ptr<ring>> rings;  /* every thread's ring */
+    std::mutex lock;                    /* guards rings and their names */
+
+    ring *own()
+      { return local_ring.owner_id == this->id ? local_ring.owned.get() : this->claim(); }
+    ring *claim();
+
+  public:
+    ThreadRings(uint32_t first_thread = 0);
+
+    template <typename Fill>
+    void write(Fill fill);
+    void name(const std::string &name);
+
+    template <typename Read, typename Lost>
+    void drain(Read read, Lost lost);
+    template <typename Visit>
+    void names(Visit visit);
+};
+
+template <typename Entry, int SIZE>
+thread_local typename ThreadRings<Entry, SIZE>::thread_ring ThreadRings<Entry, SIZE>::local_ring;
+
+template <typename Entry, int SIZE>
+std::atomic<unsigned long> ThreadRings<Entry, SIZE>::next_id(1);
+
+
+/*************************************************************************
+ * Function: ThreadRings
+ * Description: constructor; there are no rings until a thread writes
+ * Parameters: first_thread - the index of the first ring made
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: none
+ ************************************************************************/
+template <typename Entry, int SIZE>
+ThreadRings<Entry, SIZE>::ThreadRings(uint32_t first_thread)
+{
+  this->id = next_id++;
+  this->first_thread = first_thread;
+}
+
+
+/*************************************************************************
+ * Function: write
+ * Description: writes an entry to the calling thread's ring. Takes no lock
+ *              once the thread has a ring. If the ring is full, the entry
+ *              is dropped and counted.
+ * Parameters: fill - called as fill(entry, thread) to fill in the entry,
+ *                    with the index of the thread's ring
+ * Pre-conditions: none
+ * Post-conditions: the entry is waiting for the drain, or counted as
+ *                  dropped
+ * Returns: none
+ ************************************************************************/
+template <typename Entry, int SIZE>
+template <typename Fill>
+void ThreadRings<Entry, SIZE>::write(Fill fill)
+{
+  ring *own = this->own();
+  uint32_t head = own->head.load(std::memory_order_relaxed);
+
+  if (head - own->tail.load(std::memory_order_acquire) >= (uint32_t)SIZE) {
+    own->dropped.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    fill(own->entries[head % SIZE], own->thread);
+    own->head.store(head + 1, std::memory_order_release);
+  }
+}
+
+
+/*************************************************************************
+ * Function: name
+ * Description: names the calling thread's ring
+ * Parameters: name - the thread's name
+ * Pre-conditions: none
+ * Post-conditions: the thread has a ring with the name
+ * Returns: none
+ ************************************************************************/
+template <typename Entry, int SIZE>
+void ThreadRings<Entry, SIZE>::name(const std::string &name)
+{
+  ring *own = this->own();
+
+  std::lock_guard<std::mutex> guard(this->lock);
+  own->name = name;
+}
+
+
+/*************************************************************************
+ * Function: claim
+ * Description: gives the calling thread a ring of these rings, reusing an
+ *              emptied ring of a thread that has exited if there is one
+ * Parameters: none
+ * Pre-conditions: the thread has no ring of these rings
+ * Post-conditions: the thread's ring is set, and any ring it held of
+ *                  other rings is released
+ * Returns: ring * - the thread's ring
+ ************************************************************************/
+template <typename Entry, int SIZE>
+typename ThreadRings<Entry, SIZE>::ring *ThreadRings<Entry, SIZE>::claim()
+{
+  std::shared_ptr<ring> claimed;
+  bool idle = false;
+
+  {
+    std::lock_guard<std::mutex> guard(this->lock);
+
+    for (auto i = this->rings.begin(); i != this->rings.end() && !claimed; i++) {
+      if ((*i)->head.load(std::memory_order_relaxed) == (*i)->tail.load(std::memory_order_acquire) &&
+          (*i)->in_use.compare_exchange_strong(idle, true, std::memory_order_acquire)) {
+        claimed = *i;
+        claimed->name.clear();
+      }
+      idle = false;
+    }
+
+    if (!claimed) {
+      claimed = std::make_shared<ring>();
+      claimed->entries.resize(SIZE);
+      claimed->head.store(0, std::memory_order_relaxed);
+      claimed->tail.store(0, std::memory_order_relaxed);
+      claimed->dropped.store(0, std::memory_order_relaxed);
+      claimed->in_use.store(true, std::memory_order_relaxed);
+      claimed->thread = this->rings.size() + this->first_thread;
+      this->rings.push_back(claimed);
+    }
+  }
+
+  if (local_ring.owned) {
+    local_ring.owned->in_use.store(false, std::memory_order_release);
+  }
+  local_ring.owned = claimed;
+  local_ring.owner_id = this->id;
+
+  return claimed.get();
+}
+
+
+/*************************************************************************
+ * Function: drain
+ * Description: empties every ring, ring by ring
+ * Parameters: read - called as read(entry) on each entry, oldest first
+ *             lost - called as lost(thread, count) for a ring that has
+ *                    dropped entries since the last drain
+ * Pre-conditions: called only from the one draining thread
+ * Post-conditions: the rings are empty, up to entries written meanwhile
+ * Returns: none
+ ************************************************************************/
+template <typename Entry, int SIZE>
+template <typename Read, typename Lost>
+void ThreadRings<Entry, SIZE>::drain(Read read, Lost lost)
+{
+  std::vector<std::shared_ptr<ring>> rings;
+  uint32_t head, tail, dropped;
+
+  {
+    std::lock_guard<std::mutex> guard(this->lock);
+    rings = this->rings;
+  }
+
+  for (auto i = rings.begin(); i != rings.end(); i++) {
+    head = (*i)->head.load(std::memory_order_acquire);
+    for (tail = (*i)->tail.load(std::memory_order_relaxed); tail != head; tail++) {
+      read(static_cast<const Entry &>((*i)->entries[tail % SIZE]));
+    }
+    (*i)->tail.store(tail, std::memory_order_release);
+
+    dropped = (*i)->dropped.exchange(0, std::memory_order_relaxed);
+    if (dropped > 0) {
+      lost((*i)->thread, dropped);
+    }
+  }
+}
+
+
+/*************************************************************************
+ * Function: names
+ * Description: visits the name of every named ring
+ * Parameters: visit - called as visit(thread, name)
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: none
+ ************************************************************************/
+template <typename Entry, int SIZE>
+template <typename Visit>
+void ThreadRings<Entry, SIZE>::names(Visit visit)
+{
+  std::lock_guard<std::mutex> guard(this->lock);
+
+  for (auto i = this->rings.begin(); i != this->rings.end(); i++) {
+    if (!(*i)->name.empty()) {
+      visit((*i)->thread, (*i)->name);
+    }
+  }
+}
+
+#endif
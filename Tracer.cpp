@@ -0,0 +1,228 @@
+/*************************************************************************
+ * Program Filename: Tracer.cpp
+ * Author: David Bacher-Hicks
+ * Date: 19 October 2026
+ * Description: A class definition file for a Tracer class. The trace is
+ *              written in the JSON array format, one complete ("X") event
+ *              per span, with times in microseconds since the trace
+ *              started and each thread's ring as its tid. The thread
+ *              names are written as metadata events when the trace stops;
+ *              a trace cut short by a crash still opens, unnamed.
+ * Input:  none
+ * Output: a trace file
+ ************************************************************************/
+
+#include <chrono>
+#include <sstream>
+#include <iomanip>
+#include "Tracer.hpp"
+
+const trace_span_info TRACE_SPANS[TRACE_COUNT] = {
+  { "turn",         NULL },
+  { "input",        NULL },
+  { "mob_decision", "mob" },
+  { "floor_load",   "floor" },
+  { "stair",        "floor" },
+  { "render",       NULL },
+  { "flush",        NULL }
+};
+
+/*************************************************************************
+ * Function: Tracer
+ * Description: constructor; the tracer starts off
+ * Parameters: none
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: none
+ ************************************************************************/
+Tracer::Tracer() : rings(1), active(false)
+{
+  this->start_ns = now();
+  this->running = false;
+}
+
+
+/*************************************************************************
+ * Function: ~Tracer
+ * Description: destructor; finishes the trace
+ * Parameters: none
+ * Pre-conditions: none
+ * Post-conditions: the flush is stopped and the trace file closed
+ * Returns: none
+ ************************************************************************/
+Tracer::~Tracer()
+{
+  this->stop();
+}
+
+
+/*************************************************************************
+ * Function: start
+ * Description: opens the trace file and starts tracing
+ * Parameters: path - the trace file
+ * Pre-conditions: none
+ * Post-conditions: spans are traced if the file could be opened
+ * Returns: bool - true if tracing
+ ************************************************************************/
+bool Tracer::start(const std::string &path)
+{
+  if (!this->running) {
+    this->file.open(path.c_str(), std::ios::trunc);
+
+    if (this->file.is_open()) {
+      this->file << "[\n";
+      this->start_ns = now();
+      this->running = true;
+      this->flusher = std::thread(&Tracer::flush_loop, this);
+      this->active.store(true, std::memory_order_relaxed);
+    }
+  }
+
+  return this->running;
+}
+
+
+/*************************************************************************
+ * Function: stop
+ * Description: stops tracing, writes out every span traced so far and the
+ *              thread names, and closes the trace file
+ * Parameters: none
+ * Pre-conditions: none
+ * Post-conditions: the flush is stopped
+ * Returns: none
+ ************************************************************************/
+void Tracer::stop()
+{
+  if (this->running) {
+    this->active.store(false, std::memory_order_relaxed);
+    {
+      std::lock_guard<std::mutex> guard(this->lock);
+      this->running = false;
+    }
+    this->wake.notify_one();
+    this->flusher.join();
+
+    this->file << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,"
+               << "\"args\":{\"name\":\"vaguely_rogueish\"}}";
+    this->rings.names([this](uint32_t thread, const std::string &name) {
+      this->file << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << thread
+                 << ",\"args\":{\"name\":\"" << name << "\"}}";
+    });
+    this->file << "\n]\n";
+    this->file.close();
+  }
+}
+
+
+/*************************************************************************
+ * Function: now
+ * Description: reads the monotonic clock spans are timed with
+ * Parameters: none
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: int64_t - the time, in nanoseconds
+ ************************************************************************/
+int64_t Tracer::now()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+           std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
+/*************************************************************************
+ * Function: span
+ * Description: traces a finished span to the calling thread's ring. Takes
+ *              no lock once the thread has a ring. If the ring is full,
+ *              the span is dropped and counted.
+ * Parameters: name - the span
+ *             start_ns, end_ns - when it started and ended
+ *             arg - its argument, as named in TRACE_SPANS, or TRACE_NO_ARG
+ * Pre-conditions: none
+ * Post-conditions: the span is waiting for the flush, or counted as
+ *                  dropped
+ * Returns: none
+ ************************************************************************/
+void Tracer::span(trace_name name, int64_t start_ns, int64_t end_ns, int32_t arg)
+{
+  this->rings.write([=](trace_span &entry, uint32_t thread) {
+    entry.start_ns = start_ns;
+    entry.end_ns = end_ns;
+    entry.name = name;
+    entry.thread = thread;
+    entry.arg = arg;
+  });
+}
+
+
+/*************************************************************************
+ * Function: name_thread
+ * Description: names the calling thread in the trace
+ * Parameters: name - the thread's name
+ * Pre-conditions: none
+ * Post-conditions: if tracing, the thread has a ring with the name
+ * Returns: none
+ ************************************************************************/
+void Tracer::name_thread(const std::string &name)
+{
+  if (this->is_active()) {
+    this->rings.name(name);
+  }
+}
+
+
+/*************************************************************************
+ * Function: flush_loop
+ * Description: the flush thread. Writes out the rings every
+ *              TRACE_FLUSH_MS, and once more as it stops.
+ * Parameters: none
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: none
+ ************************************************************************/
+void Tracer::flush_loop()
+{
+  std::unique_lock<std::mutex> guard(this->lock);
+
+  while (this->running) {
+    this->wake.wait_for(guard, std::chrono::milliseconds(TRACE_FLUSH_MS));
+    guard.unlock();
+    this->flush();
+    guard.lock();
+  }
+  guard.unlock();
+
+  this->flush();
+}
+
+
+/*************************************************************************
+ * Function: flush
+ * Description: empties every ring into the trace file
+ * Parameters: none
+ * Pre-conditions: called only from the flush thread
+ * Post-conditions: the rings are empty, up to spans traced meanwhile
+ * Returns: none
+ ************************************************************************/
+void Tracer::flush()
+{
+  std::ostringstream out;
+
+  out << std::fixed << std::setprecision(3);
+
+  this->rings.drain([this, &out](const trace_span &entry) {
+    out << "{\"name\":\"" << TRACE_SPANS[entry.name].name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":"
+        << entry.thread << ",\"ts\":" << (entry.start_ns - this->start_ns) / 1e3
+        << ",\"dur\":" << (entry.end_ns - entry.start_ns) / 1e3;
+    if (entry.arg != TRACE_NO_ARG && TRACE_SPANS[entry.name].arg != NULL) {
+      out << ",\"args\":{\"" << TRACE_SPANS[entry.name].arg << "\":" << entry.arg << '}';
+    }
+    out << "},\n";
+  }, [this, &out](uint32_t thread, uint32_t dropped) {
+    out << "{\"name\":\"dropped\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":" << thread
+        << ",\"ts\":" << (now() - this->start_ns) / 1e3
+        << ",\"args\":{\"spans\":" << dropped << "}},\n";
+  });
+
+  this->file << out.str();
+  this->file.flush();
+}
@@ -0,0 +1,106 @@
+/*************************************************************************
+ * Program Filename: Tracer.hpp
+ * Author: David Bacher-Hicks
+ * Date: 19 October 2026
+ * Description: A class declaration file for a Tracer class. While tracing,
+ *              spans of the game loop (turns, input, monster decisions,
+ *              floor loads, stairs, render and terminal output) are
+ *              written to a Chrome trace-event JSON file, which can be
+ *              opened in chrome://tracing or Perfetto. Each thread writes
+ *              its spans into its own ring of a ThreadRings without
+ *              locking, and a background thread writes them out.
+ * Input:  none
+ * Output: a trace file
+ ************************************************************************/
+
+#ifndef TRACER_HPP
+#define TRACER_HPP
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <fstream>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
+#include "ThreadRings.hpp"
+
+const int TRACE_RING_SPANS = 16384;    /* spans a thread can trace before the flush */
+const int TRACE_FLUSH_MS   = 200;      /* longest a span waits to be written */
+const int32_t TRACE_NO_ARG = INT32_MIN;  /* a span without an argument */
+
+/* the traced spans; TRACE_SPANS gives each its name and argument */
+enum trace_name {
+  TRACE_TURN,           /* a turn, from input to the screen being drawn */
+  TRACE_INPUT,          /* handling the input */
+  TRACE_MOB_DECISION,   /* mob: one monster choosing and making its move */
+  TRACE_FLOOR_LOAD,     /* floor: building a floor */
+  TRACE_STAIR,          /* floor: taking a stair */
+  TRACE_RENDER,         /* rendering the screen */
+  TRACE_FLUSH,          /* drawing it on the terminal */
+  TRACE_COUNT
+};
+
+struct trace_span_info {
+  const char *name;
+  const char *arg;              /* the argument's name, or NULL */
+};
+
+extern const trace_span_info TRACE_SPANS[TRACE_COUNT];
+
+/* a finished span, as written into a ring */
+struct trace_span {
+  int64_t start_ns;             /* steady clock times */
+  int64_t end_ns;
+  uint32_t name;
+  uint32_t thread;              /* the ring it was written to */
+  int32_t arg;
+};
+
+class Tracer {
+  private:
+    ThreadRings<trace_span, TRACE_RING_SPANS> rings;  /* every thread's ring of spans */
+    std::ofstream file;
+    int64_t start_ns;                   /* steady clock time of start */
+    std::atomic<bool> active;           /* whether spans are being traced */
+
+    bool running;                       /* whether the flush should keep running */
+    std::mutex lock;                    /* guards running */
+    std::condition_variable wake;
+    std::thread flusher;
+
+    void flush_loop();
+    void flush();
+
+  public:
+    Tracer();
+    ~Tracer();
+
+    bool start(const std::string &path);
+    void stop();
+    bool is_active() const { return this->active.load(std::memory_order_relaxed); }
+
+    static int64_t now();
+    void span(trace_name name, int64_t start_ns, int64_t end_ns, int32_t arg = TRACE_NO_ARG);
+    void name_thread(const std::string &name);
+};
+
+/* traces the enclosing block as a span, if the tracer is on as it starts */
+class TraceScope {
+  private:
+    Tracer *tracer;                     /* the tracer, or NULL if it was off */
+    trace_name name;
+    int32_t arg;
+    int64_t start_ns;
+
+  public:
+    TraceScope(Tracer &tracer, trace_name name, int32_t arg = TRACE_NO_ARG)
+      : tracer(tracer.is_active() ? &tracer : NULL), name(name), arg(arg),
+        start_ns(this->tracer != NULL ? Tracer::now() : 0) {}
+    ~TraceScope()
+      { if (this->tracer != NULL) this->tracer->span(this->name, this->start_ns, Tracer::now(), this->arg); }
+};
+
+#endif
@@ -0,0 +1,676 @@
+/*************************************************************************
+ * Program Filename: bench.cpp
+ * Author: David Bacher-Hicks
+ * Date: 19 October 2026
+ * Description: A benchmark harness for the game, run with "make bench".
+ *              Each benchmark is run for a few warmup repetitions, then
+ *              timed over BENCH_REPS repetitions, each seeded the same
+ *              way, and reported as the median, standard deviation and
+ *              fastest time per operation. Covers dice rolls, the .tbl
+ *              parsers, floor loading, linking and rendering, generating
+ *              a 512x512 floor, a breadth-first search and field of view
+ *              rays on a 1024x1024 one, through its spaces and through
+ *              its bitboards, unpacking its packed grid, spawning
+ *              monsters, monster turns at 10, 1k and 100k monsters, and
+ *              a scripted playthrough of every shipped floor. With --baseline, each median is
+ *              compared with an earlier run's, and any that has slowed by
+ *              more than the threshold is flagged. Building with and
+ *              without MORTON=1 and comparing the runs compares the two
+ *              orders of a chunk's tiles.
+ *
+ *              Options:
+ *                --out <file>        write the results as JSON (bench.json)
+ *                --baseline <file>   compare with an earlier results file
+ *                --threshold <pct>   slowdown that is a regression (10)
+ *                --reps <n>          timed repetitions (BENCH_REPS)
+ *                --warmup <n>        untimed repetitions (BENCH_WARMUP)
+ *                --filter <text>     only run benchmarks whose name has it
+ *
+ *              Any other option, or one without its value, prints the
+ *              usage and exits with 1. Run from the repository root, as
+ *              the game is.
+ * Input: the gamedata files, and the baseline file if given
+ * Output: a table on standard out, and the results file
+ ************************************************************************/
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <functional>
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <cmath>
+#include <cstring>
+#include <cstdlib>
+#include "Game.hpp"
+#include "Layout.hpp"
+#include "Die.hpp"
+#include "utils.hpp"
+
+/* harness defaults */
+const unsigned int BENCH_SEED = 20261019;
+const int BENCH_WARMUP = 3;
+const int BENCH_REPS = 15;
+const double BENCH_THRESHOLD = 10.0;    /* percent slowdown that is a regression */
+const std::string BENCH_OUT = "bench.json";
+
+/* scripted playthrough: moves made on each floor, from its first open tile */
+const int PLAY_MOVES = 200;
+
+/* neighbourhood queries on a generated floor far larger than any shipped one */
+const int LARGE_SIDE = 1024;
+const int FOV_RADIUS = 12;
+const int FOV_VIEWS = 500;              /* tiles looked from per repetition */
+
+/*
+ * a benchmark. setup runs untimed before each repetition; each repetition
+ * times batch calls of run
+ */
+struct bench_case {
+  std::string name;
+  int batch;
+  std::function<void()> setup;
+  std::function<void()> run;
+};
+
+struct bench_result {
+  std::string name;
+  int batch;
+  double median;                /* ns per call of run */
+  double stddev;
+  double min;
+};
+
+/* a synthetic open floor full of monsters, for timing monster turns */
+struct mob_floor {
+  std::string floor_ID;
+  Floor *floor;                 /* owned by the game */
+  int width;
+  Coord player;
+  std::vector<std::pair<entity, Coord>> mobs;  /* each monster and its start */
+};
+
+/*************************************************************************
+ * Function: now_ns
+ * Description: reads the monotonic clock
+ * Parameters: none
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: double - the time, in nanoseconds
+ ************************************************************************/
+double now_ns()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+           std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
+/*************************************************************************
+ * Function: run_case
+ * Description: runs a benchmark's warmup and timed repetitions, reseeding
+ *              rand before each so every repetition rolls the same dice
+ * Parameters: bench - the benchmark
+ *             warmup - untimed repetitions
+ *             reps - timed repetitions
+ * Pre-conditions: reps > 0
+ * Post-conditions: none
+ * Returns: bench_result - the timings, per call of run
+ ************************************************************************/
+bench_result run_case(const bench_case &bench, int warmup, int reps)
+{
+  std::vector<double> times;
+  bench_result result;
+  double start, mean = 0, variance = 0;
+
+  for (int i = 0; i < warmup + reps; i++) {
+    srand(BENCH_SEED);
+    if (bench.setup) {
+      bench.setup();
+    }
+
+    start = now_ns();
+    for (int j = 0; j < bench.batch; j++) {
+      bench.run();
+    }
+    if (i >= warmup) {
+      times.push_back((now_ns() - start) / bench.batch);
+    }
+  }
+
+  for (auto i = times.begin(); i != times.end(); i++) {
+    mean += *i / times.size();
+  }
+  for (auto i = times.begin(); i != times.end(); i++) {
+    variance += (*i - mean) * (*i - mean) / times.size();
+  }
+  std::sort(times.begin(), times.end());
+
+  result.name = bench.name;
+  result.batch = bench.batch;
+  result.median = (times.size() % 2 == 1) ? times[times.size() / 2] :
+                  (times[times.size() / 2 - 1] + times[times.size() / 2]) / 2;
+  result.stddev = std::sqrt(variance);
+  result.min = times.front();
+
+  return result;
+}
+
+
+/*************************************************************************
+ * Function: make_mob_floor
+ * Description: builds an open square floor with a monster on about half
+ *              of its tiles, around the middle tile left for the player,
+ *              and adds it to the game's floors
+ * Parameters: game - the game
+ *             kind - the monsters' data
+ *             mob_count - how many monsters to place
+ * Pre-conditions: none
+ * Post-conditions: the game owns the floor and its monsters
+ * Returns: mob_floor - the floor's ID, the player's tile and each monster
+ ************************************************************************/
+mob_floor make_mob_floor(Game &game, mob_data &kind, int mob_count)
+{
+  mob_floor made;
+  Floor *floor = new Floor;
+  std::vector<char> grid;
+  std::stringstream id;
+  unsigned int seed = BENCH_SEED;
+  Coord coord;
+  floor_source source;
+
+  made.width = 2;
+  while ((made.width - 2) * (made.width - 2) < mob_count * 2) {
+    made.width *= 2;
+  }
+  made.player = Coord(made.width / 2, made.width / 2);
+
+  /* walls around the edge, open tiles inside */
+  grid.assign(made.width * made.width, EMPTY_SPACE_C);
+  for (int i = 0; i < made.width; i++) {
+    grid[i] = grid[(made.width - 1) * made.width + i] = WALL_C;
+    grid[i * made.width] = grid[i * made.width + made.width - 1] = WALL_C;
+  }
+  floor->load_grid(grid.data(), made.width, made.width);
+  game.link_spaces(floor);
+
+  while ((int)made.mobs.size() < mob_count) {
+    coord = Coord(1 + rand_r(&seed) % (made.width - 2), 1 + rand_r(&seed) % (made.width - 2));
+    if (!(coord == made.player) && !floor->get_space(coord)->occupied()) {
+      made.mobs.push_back(std::pair<entity, Coord>(floor->add_mob(&kind, coord), coord));
+    }
+  }
+
+  id << "bench_mobs_" << mob_count;
+  made.floor_ID = id.str();
+  source.map_num = -1;
+  source.pack_index = -1;
+  source.gen_index = -1;
+  game.adopt_floor(game.add_floor(made.floor_ID, source), floor);
+  made.floor = floor;
+
+  return made;
+}
+
+
+/*************************************************************************
+ * Function: reset_mob_floor
+ * Description: puts the player and every monster of a synthetic floor
+ *              back where they started, and heals the player
+ * Parameters: game - the game
+ *             made - the floor
+ * Pre-conditions: the floor was made by make_mob_floor
+ * Post-conditions: the player is on the floor, in the middle
+ * Returns: none
+ ************************************************************************/
+void reset_mob_floor(Game &game, mob_floor &made)
+{
+  Entities *mobs = made.floor->get_mobs();
+  std::stringstream event;
+
+  event << "f " << made.floor_ID << ' ' << made.player.x() << ' ' << made.player.y();
+  game.apply_event(event.str());
+  game.apply_event("r 0 1000000");
+
+  /* every monster is lifted off first, so none blocks another's start */
+  for (auto i = made.mobs.begin(); i != made.mobs.end(); i++) {
+    made.floor->get_space(mobs->get_coord(mobs->find(i->first)))->delete_mob();
+  }
+  for (auto i = made.mobs.begin(); i != made.mobs.end(); i++) {
+    mobs->set_coord(mobs->find(i->first), i->second);
+    made.floor->get_space(i->second)->add_mob(i->first);
+  }
+}
+
+
+/*************************************************************************
+ * Function: first_open_tile
+ * Description: finds the first open tile of a floor's layout
+ * Parameters: layout - the layout
+ * Pre-conditions: the layout has been read
+ * Post-conditions: none
+ * Returns: Coord - the tile, or (0,0) if there is none
+ ************************************************************************/
+Coord first_open_tile(Layout &layout)
+{
+  Coord tile(0, 0);
+  bool found = false;
+
+  for (int y = 0; y < layout.get_height() && !found; y++) {
+    for (int x = 0; x < layout.get_width() && !found; x++) {
+      if (layout.grid()[y * layout.get_width() + x] == EMPTY_SPACE_C) {
+        tile = Coord(x, y);
+        found = true;
+      }
+    }
+  }
+
+  return tile;
+}
+
+
+/*************************************************************************
+ * Function: flood_floor
+ * Description: a breadth-first search over every space of a floor but
+ *              its walls, as pathing through doors makes, reading each
+ *              tile's four neighbours
+ * Parameters: floor - the floor
+ *             width - the floor's width
+ *             height - the floor's height
+ *             from - the tile to search from
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: int - the number of tiles reached
+ ************************************************************************/
+int flood_floor(Floor *floor, int width, int height, const Coord &from)
+{
+  const int dx[] = { 0, 1, 0, -1 };
+  const int dy[] = { -1, 0, 1, 0 };
+  std::vector<uint8_t> reached(width * height, 0);
+  std::vector<Coord> queue(1, from);
+  Space *space;
+  Coord next;
+
+  reached[from.y() * width + from.x()] = 1;
+  for (size_t i = 0; i < queue.size(); i++) {
+    for (int d = 0; d < 4; d++) {
+      next = Coord(queue[i].x() + dx[d], queue[i].y() + dy[d]);
+      if (next.x() >= 0 && next.y() >= 0 && next.x() < width && next.y() < height &&
+          !reached[next.y() * width + next.x()] &&
+          (space = floor->get_space(next)) != NULL && space->get_kind() != TILE_WALL) {
+        reached[next.y() * width + next.x()] = 1;
+        queue.push_back(next);
+      }
+    }
+  }
+
+  return queue.size();
+}
+
+
+/*************************************************************************
+ * Function: view_floor
+ * Description: a field of view by rays, cast from a tile to every tile on
+ *              the edge of the square radius tiles out, each stopping at
+ *              the first space that cannot be passed
+ * Parameters: floor - the floor
+ *             from - the tile looked from
+ *             radius - how far the rays reach
+ * Pre-conditions: radius > 0
+ * Post-conditions: none
+ * Returns: int - the number of tiles the rays reached
+ ************************************************************************/
+int view_floor(Floor *floor, const Coord &from, int radius)
+{
+  Space *space;
+  int seen = 0;
+  int dx, dy;
+
+  for (int edge = 0; edge < 8 * radius; edge++) {
+    /* around the square's edge, clockwise from its top left corner */
+    if (edge < 2 * radius) {
+      dx = edge - radius; dy = -radius;
+    } else if (edge < 4 * radius) {
+      dx = radius; dy = edge - 3 * radius;
+    } else if (edge < 6 * radius) {
+      dx = 5 * radius - edge; dy = radius;
+    } else {
+      dx = -radius; dy = 7 * radius - edge;
+    }
+
+    space = floor->get_space(from);
+    for (int step = 1; step <= radius && space != NULL && space->passable(); step++) {
+      space = floor->get_space(from.x() + dx * step / radius, from.y() + dy * step / radius);
+      seen++;
+    }
+  }
+
+  return seen;
+}
+
+
+/*************************************************************************
+ * Function: read_baseline
+ * Description: reads the medians from an earlier results file
+ * Parameters: path - the results file
+ *             medians - the median of each benchmark, by name
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: bool - true if the file could be read
+ ************************************************************************/
+bool read_baseline(const std::string &path, std::map<std::string, double> &medians)
+{
+  std::ifstream in(path.c_str());
+  std::string line;
+  size_t name_at, median_at;
+
+  /* results files have one benchmark per line */
+  while (std::getline(in, line)) {
+    name_at = line.find("\"name\": \"");
+    median_at = line.find("\"median\": ");
+    if (name_at != std::string::npos && median_at != std::string::npos) {
+      name_at += 9;
+      medians[line.substr(name_at, line.find('"', name_at) - name_at)] =
+        atof(line.c_str() + median_at + 10);
+    }
+  }
+
+  return in.eof();
+}
+
+
+/*************************************************************************
+ * Function: write_results
+ * Description: writes the results as JSON, one benchmark per line
+ * Parameters: path - the results file
+ *             results - the results
+ *             warmup, reps - the repetitions they were run with
+ * Pre-conditions: none
+ * Post-conditions: the file is written
+ * Returns: bool - true if the file could be written
+ ************************************************************************/
+bool write_results(const std::string &path, const std::vector<bench_result> &results,
+                   int warmup, int reps)
+{
+  std::ofstream out(path.c_str());
+
+  out << std::fixed << std::setprecision(1);
+  out << "{\n  \"seed\": " << BENCH_SEED << ",\n  \"warmup\": " << warmup
+      << ",\n  \"reps\": " << reps << ",\n  \"unit\": \"ns\",\n  \"benchmarks\": [\n";
+  for (auto i = results.begin(); i != results.end(); i++) {
+    out << "    {\"name\": \"" << i->name << "\", \"batch\": " << i->batch
+        << ", \"median\": " << i->median << ", \"stddev\": " << i->stddev
+        << ", \"min\": " << i->min << '}' << (i + 1 != results.end() ? "," : "") << '\n';
+  }
+  out << "  ]\n}\n";
+
+  return out.good();
+}
+
+
+int main(int argc, char **argv)
+{
+  std::string out_path = BENCH_OUT, baseline_path, filter;
+  double threshold = BENCH_THRESHOLD;
+  int warmup = BENCH_WARMUP, reps = BENCH_REPS;
+  std::vector<bench_case> benches;
+  std::vector<bench_result> results;
+  std::map<std::string, double> baseline;
+  std::ostringstream no_log;
+  int regressions = 0;
+  bool ok = true;
+  bool args_ok = true;
+
+  for (int i = 1; i < argc && args_ok; i += 2) {
+    if (i + 1 >= argc) {
+      args_ok = false;
+    } else if (strcmp(argv[i], "--out") == 0) {
+      out_path = argv[i + 1];
+    } else if (strcmp(argv[i], "--baseline") == 0) {
+      baseline_path = argv[i + 1];
+    } else if (strcmp(argv[i], "--threshold") == 0) {
+      threshold = atof(argv[i + 1]);
+    } else if (strcmp(argv[i], "--reps") == 0) {
+      reps = std::max(1, atoi(argv[i + 1]));
+    } else if (strcmp(argv[i], "--warmup") == 0) {
+      warmup = std::max(0, atoi(argv[i + 1]));
+    } else if (strcmp(argv[i], "--filter") == 0) {
+      filter = argv[i + 1];
+    } else {
+      args_ok = false;
+    }
+  }
+
+  if (!args_ok) {
+    std::cerr << "Usage: " << argv[0] << " [--out <file>] [--baseline <file>] [--threshold <pct>]"
+              << " [--reps <n>] [--warmup <n>] [--filter <text>]\n";
+    return 1;
+  }
+
+  if (!baseline_path.empty() && !read_baseline(baseline_path, baseline)) {
+    std::cerr << "Could not read " << baseline_path << '\n';
+    return 1;
+  }
+
+  /* one game serves every benchmark but the playthrough */
+  srand(BENCH_SEED);
+  Game game("bench");
+  game.set_floor_budget(0);
+
+  mob_data kind;
+  kind.id = "bench";
+  kind.num = NO_ID;
+  kind.name = "a benchmark";
+  kind.render_char = 'b';
+  kind.ac = 10;
+  kind.hp = 10;
+  kind.die_n = 1;
+  kind.die_s = 4;
+  kind.die_m = 0;
+  kind.b_atk = 0;
+  kind.cr = 0.5;
+
+  Die die(6, 3, 2);
+  int rolled = 0;
+  benches.push_back({ "die_roll", 100000, NULL, [&]() { rolled += die.roll(); } });
+
+  benches.push_back({ "tbl_items", 1, NULL, [&]() {
+    std::map<std::string, Item*> items;
+    game.load_generic_items(items, no_log);
+    for (auto i = items.begin(); i != items.end(); i++) delete i->second;
+  } });
+  benches.push_back({ "tbl_weapons", 1, NULL, [&]() {
+    std::map<std::string, Item*> items;
+    game.load_weapons(items, no_log);
+    for (auto i = items.begin(); i != items.end(); i++) delete i->second;
+  } });
+  benches.push_back({ "tbl_armor", 1, NULL, [&]() {
+    std::map<std::string, Item*> items;
+    game.load_armor(items, no_log);
+    for (auto i = items.begin(); i != items.end(); i++) delete i->second;
+  } });
+  benches.push_back({ "tbl_mobs", 1, NULL, [&]() {
+    std::vector<mob_data*> mobs;
+    game.load_mobs(mobs, no_log);
+    for (auto i = mobs.begin(); i != mobs.end(); i++) delete *i;
+  } });
+  benches.push_back({ "tbl_loot", 1, NULL, [&]() {
+    std::vector<std::pair<std::string, int>> loot;
+    game.load_loot("gob01.tbl", loot, no_log);
+  } });
+
+  /* the largest shipped floor */
+  std::string error;
+  std::string floor_path = game.floor_path(1, ".mp");
+  Floor linked;
+  linked.load_floor(floor_path, error);
+  game.link_spaces(&linked);
+
+  benches.push_back({ "load_floor", 1, NULL, [&]() {
+    Floor floor;
+    floor.load_floor(floor_path, error);
+  } });
+  benches.push_back({ "link_spaces", 1, NULL, [&]() { game.link_spaces(&linked); } });
+  benches.push_back({ "render_floor", 1, NULL, [&]() { linked.render_floor(); } });
+
+  /* generating a floor far larger than any shipped one */
+  gen_content content;
+  game.gather_content(content);
+  gen_params dungeon = { 1, 512, 512, BENCH_SEED };
+  Generator generator(dungeon, content);
+  benches.push_back({ "generate_floor_512", 1, NULL, [&]() {
+    gen_floor floor;
+    generator.generate(0, floor);
+  } });
+
+  /* searching and looking about a large generated floor */
+  std::unique_ptr<Floor> large;
+  std::vector<Coord> views;
+  Coord large_entry;
+  std::string packed_grid;
+  std::vector<char> unpacked_grid;
+  if (filter.empty() || std::string("bfs_1024_bits").find(filter) != std::string::npos ||
+      std::string("fov_1024_bits").find(filter) != std::string::npos ||
+      std::string("unpack_grid_1024").find(filter) != std::string::npos) {
+    gen_params large_dungeon = { 1, LARGE_SIDE, LARGE_SIDE, BENCH_SEED };
+    Generator large_generator(large_dungeon, content);
+    gen_floor large_floor;
+    unsigned int seed = BENCH_SEED;
+    Coord view;
+
+    large_generator.generate(0, large_floor);
+    large.reset(new Floor);
+    large->load_grid(large_floor.glyphs.data(), LARGE_SIDE, LARGE_SIDE);
+    large_entry = large_generator.entry_coord(0);
+    pack_grid(large_floor.glyphs, packed_grid);
+    while ((int)views.size() < FOV_VIEWS) {
+      view = Coord(rand_r(&seed) % LARGE_SIDE, rand_r(&seed) % LARGE_SIDE);
+      if (large_floor.glyphs[view.y() * LARGE_SIDE + view.x()] == EMPTY_SPACE_C) {
+        views.push_back(view);
+      }
+    }
+  }
+  benches.push_back({ "bfs_1024", 1, NULL, [&]() {
+    flood_floor(large.get(), LARGE_SIDE, LARGE_SIDE, large_entry);
+  } });
+  benches.push_back({ "fov_1024", 1, NULL, [&]() {
+    for (auto i = views.begin(); i != views.end(); i++) {
+      view_floor(large.get(), *i, FOV_RADIUS);
+    }
+  } });
+  std::vector<uint64_t> reached;
+  benches.push_back({ "bfs_1024_bits", 1, NULL, [&]() {
+    large->get_boards()->flood(large_entry, 1 << BOARD_WALL, reached);
+  } });
+  benches.push_back({ "fov_1024_bits", 1, NULL, [&]() {
+    for (auto i = views.begin(); i != views.end(); i++) {
+      large->get_boards()->view(*i, FOV_RADIUS);
+    }
+  } });
+
+  /* unpacking a dormant floor's grid, as revisiting it does */
+  benches.push_back({ "unpack_grid_1024", 1, NULL, [&]() {
+    unpack_grid(packed_grid, LARGE_SIDE * LARGE_SIDE, unpacked_grid);
+  } });
+
+  /* spawning a crowd of monsters into a floor's storage */
+  benches.push_back({ "spawn_mobs_10k", 1, NULL, [&]() {
+    Entities crowd;
+    for (int i = 0; i < 10000; i++) {
+      crowd.create(&kind, Coord(i % 100, i / 100));
+    }
+  } });
+
+  /* monster turns; each repetition starts every monster where it began */
+  const int mob_counts[] = { 10, 1000, 100000 };
+  const char *mob_names[] = { "move_mobs_10", "move_mobs_1k", "move_mobs_100k" };
+  const int mob_batches[] = { 100, 10, 1 };
+  std::vector<std::shared_ptr<mob_floor>> mob_floors;
+  for (int i = 0; i < 3; i++) {
+    if (filter.empty() || std::string(mob_names[i]).find(filter) != std::string::npos) {
+      mob_floors.push_back(std::make_shared<mob_floor>(make_mob_floor(game, kind, mob_counts[i])));
+      std::shared_ptr<mob_floor> made = mob_floors.back();
+      benches.push_back({ mob_names[i], mob_batches[i],
+                          [&game, made]() { reset_mob_floor(game, *made); },
+                          [&game]() { game.move_mobs(); } });
+    }
+  }
+
+  /*
+   * a scripted playthrough of every shipped floor, in a new game each
+   * repetition: from each floor's first open tile, PLAY_MOVES seeded
+   * moves, with the floor prefetching and the screen rendered every turn
+   */
+  std::unique_ptr<Game> played;
+  benches.push_back({ "playthrough", 1, [&]() { played.reset(); played.reset(new Game("bench")); }, [&]() {
+    unsigned int seed = BENCH_SEED;
+    const direction dirs[] = { UP, DOWN, LEFT, RIGHT };
+    std::stringstream data_path, event;
+    std::string floor_ID;
+    Layout layout;
+    Coord start;
+
+    for (int map_num = 1; file_exists(played->floor_path(map_num, ".mp").c_str()); map_num++) {
+      std::ifstream data(played->floor_path(map_num, ".dat").c_str());
+      data >> floor_ID;
+      layout.read(played->floor_path(map_num, ".mp"));
+      start = first_open_tile(layout);
+
+      event.str("");
+      event << "f " << floor_ID << ' ' << start.x() << ' ' << start.y();
+      played->apply_event(event.str());
+      played->apply_event("r 0 1000000");
+
+      for (int i = 0; i < PLAY_MOVES; i++) {
+        played->move_player(dirs[rand_r(&seed) % 4]);
+        played->prefetch_floors();
+        played->render();
+      }
+    }
+  } });
+
+  for (auto i = benches.begin(); i != benches.end(); i++) {
+    if (filter.empty() || i->name.find(filter) != std::string::npos) {
+      results.push_back(run_case(*i, warmup, reps));
+    }
+  }
+  played.reset();
+
+  /* report */
+  std::cout << std::fixed << std::setprecision(1) << std::left << std::setw(16) << "benchmark"
+            << std::right << std::setw(14) << "median ns" << std::setw(12) << "stddev"
+            << std::setw(14) << "min ns";
+  if (!baseline.empty()) {
+    std::cout << std::setw(14) << "baseline" << std::setw(10) << "change";
+  }
+  std::cout << '\n';
+
+  for (auto i = results.begin(); i != results.end(); i++) {
+    std::cout << std::left << std::setw(16) << i->name << std::right << std::setw(14) << i->median
+              << std::setw(12) << i->stddev << std::setw(14) << i->min;
+
+    auto base = baseline.find(i->name);
+    if (base != baseline.end() && base->second > 0) {
+      double change = (i->median - base->second) / base->second * 100;
+      std::cout << std::setw(14) << base->second << std::setw(9) << std::showpos << change
+                << std::noshowpos << '%';
+      if (change > threshold) {
+        std::cout << "  REGRESSION";
+        regressions++;
+      }
+    }
+    std::cout << '\n';
+  }
+
+  if (!write_results(out_path, results, warmup, reps)) {
+    std::cerr << "Could not write " << out_path << '\n';
+    ok = false;
+  }
+  if (regressions > 0) {
+    std::cout << regressions << " benchmark(s) slowed by more than " << threshold << "%\n";
+    ok = false;
+  }
+
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,138 @@
+/*************************************************************************
+ * Program Filename: dungeon.cpp
+ * Author: David Bacher-Hicks
+ * Date: 19 October 2026
+ * Description: An offline tool that generates a dungeon and exports it
+ *              as floor_N.mp/.dat pairs, in the format of the shipped
+ *              floors, so it can be played from a maps directory or
+ *              built into an asset pack. The dungeon is populated from
+ *              the gamedata tables, through the game's loaders and in the
+ *              game's way, so a seed exports the dungeon it plays. Floors
+ *              are generated in parallel, one task per floor, each
+ *              written out and freed as soon as it is done, so a dungeon
+ *              of any depth needs only a floor per thread in memory.
+ *
+ *              Usage: vr_dungeon <floors> <width>x<height> <seed> <directory>
+ *
+ *              Run from the repository root, as the game is.
+ * Input: the gamedata tables
+ * Output: floor_1.mp/.dat to floor_<floors>.mp/.dat in the directory
+ ************************************************************************/
+
+#include <iostream>
+#include <sstream>
+#include <algorithm>
+#include <thread>
+#include <list>
+#include <map>
+#include <cstdio>
+#include <cstdlib>
+#include "Generator.hpp"
+#include "TaskGraph.hpp"
+#include "Game.hpp"
+#include "utils.hpp"
+
+/*************************************************************************
+ * Function: read_content
+ * Description: reads what the dungeon is populated with from the gamedata
+ *              tables, through the game's own loaders, with each monster
+ *              given its loot table as the game gives it, and gathers it
+ *              as the game does
+ * Parameters: content - set to the content
+ *             log - stream for error messages
+ * Pre-conditions: none
+ * Post-conditions: none
+ * Returns: none
+ ************************************************************************/
+void read_content(gen_content &content, std::ostream &log)
+{
+  std::map<std::string, Item*> items;
+  std::map<std::string, mob_data*> mobs;
+  std::vector<mob_data*> mob_list;
+  std::vector<std::string> loot_files;
+  std::ostringstream load_log;          /* the loaders' messages, kept quiet */
+
+  Game::load_generic_items(items, load_log);
+  Game::load_weapons(items, load_log);
+  Game::load_armor(items, load_log);
+  Game::load_mobs(mob_list, load_log);
+
+  list_files(MOB_LOOT_DIR.c_str(), ".tbl", loot_files);
+  for (auto i = mob_list.begin(); i != mob_list.end(); i++) {
+    if (std::binary_search(loot_files.begin(), loot_files.end(), (*i)->id + ".tbl")) {
+      Game::load_loot((*i)->id + ".tbl", (*i)->loot, load_log);
+    }
+    mobs.insert(std::pair<std::string, mob_data*>((*i)->id, *i));
+  }
+
+  if (items.empty() || mobs.empty()) {
+    log << "The gamedata tables could not be read:\n" << load_log.str();
+  }
+
+  Game::gather_content(items, mobs, content);
+
+  for (auto i = items.begin(); i != items.end(); i++) {
+    delete i->second;
+  }
+  for (auto i = mob_list.begin(); i != mob_list.end(); i++) {
+    delete *i;
+  }
+}
+
+
+/*
+ * usage: vr_dungeon <floors> <width>x<height> <seed> <directory>
+ */
+int main(int argc, char **argv)
+{
+  gen_params params = NO_DUNGEON;
+  gen_content content;
+  TaskGraph generator;
+  std::list<std::ostringstream> logs;   /* one log per floor */
+  std::ostringstream *log;
+  std::string dir;
+  bool exported = true;
+
+  if (argc != 5 || sscanf(argv[2], "%dx%d", &params.width, &params.height) != 2) {
+    std::cerr << "Usage: " << argv[0] << " <floors> <width>x<height> <seed> <directory>\n";
+    return 1;
+  }
+  params.floors = atoi(argv[1]);
+  params.seed = strtoul(argv[3], NULL, 10);
+  params = Generator::clamp(params);
+  dir = argv[4];
+  if (!dir.empty() && dir[dir.size() - 1] != '/') {
+    dir += '/';
+  }
+
+  read_content(content, std::cerr);
+  Generator dungeon(params, content);
+
+  for (int i = 0; i < params.floors; i++) {
+    logs.emplace_back();
+    log = &logs.back();
+    generator.add([&dungeon, &dir, log, i]() {
+      std::ostringstream path;
+      gen_floor floor;
+
+      dungeon.generate(i, floor);
+      path << dir << "floor_" << i + 1;
+      if (!Generator::export_floor(floor, path.str() + ".mp", path.str() + ".dat")) {
+        *log << path.str() << ": could not be written\n";
+      }
+    }, std::vector<int>());
+  }
+
+  generator.run(std::max(1, static_cast<int>(std::thread::hardware_concurrency())));
+
+  for (auto i = logs.begin(); i != logs.end(); i++) {
+    std::cerr << i->str();
+    exported = exported && i->str().empty();
+  }
+  if (exported) {
+    std::cout << "Generated " << params.floors << " floors of " << params.width << 'x'
+              << params.height << " in " << dir << '\n';
+  }
+
+  return exported ? 0 : 1;
+}
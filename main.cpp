@@ -1,12 +1,15 @@
 #include <ncurses.h>
 #include <cstdlib>
+#include <cstdio>
 #include <ctime>
 #include <iostream>
 #include <sstream>
+#include <memory>
 
 #include "Floor.hpp"
 #include "Character.hpp"
 #include "Game.hpp"
+#include "utils.hpp"
 
 const char *INTRO_MESSAGE = 
   "Welcome to the Vaguely Roguelike Game\n\n"
@@ -26,6 +29,28 @@ const char *INTRO_MESSAGE =
   "i - open your inventory\n\n"
   "In order to attack monsters or open doors, issue a move command in that direction\n\n";
 
+/* a generated dungeon's size and seed, unless VR_DUNGEON gives them */
+const int DUNGEON_WIDTH = 80;
+const int DUNGEON_HEIGHT = 40;
+const unsigned int DUNGEON_SEED = 1;
+
+/*************************************************************************
+ * Function: ask_name
+ * Description: asks the player what their hero will be named
+ * Parameters: name - set to the name, of at most 25 characters
+ * Pre-conditions: the screen must be echoing input
+ * Post-conditions: none
+ * Returns: none
+ ************************************************************************/
+void ask_name(char *name)
+{
+  clear();
+  printw( "What will your hero be named?\n" );
+  refresh();
+  getnstr(name, 25);
+}
+
+
 int main()
 {
   srand(time(0));
@@ -41,33 +66,76 @@ int main()
   refresh();
   getch();
 
+  /* offer to recover the game left behind by the last session */
+  bool resume = false;
+  if (file_exists(SAVE_PATH.c_str())) {
+    clear();
+    printw( "A saved game was found. Resume it? y/n\n" );
+    refresh();
+    resume = (getch() == 'y');
+  }
+
+  name[0] = '\0';
+  if (!resume) {
+    ask_name(name);
+  }
   clear();
-  printw( "What will your hero be named?\n" );
-  refresh();
-  getnstr(name, 25);
-  clear();
+
+  /* 
+   * VR_HOT_RELOAD in the environment reloads gamedata as it is edited;
+   * VR_TRACE=<file> traces the game loop to a Chrome trace-event file;
+   * VR_DUNGEON=<floors>[:<width>x<height>[:<seed>]] plays a generated 
+   * dungeon instead of the gamedata floors
+   */
+  int input;
+  gen_params dungeon = { 0, DUNGEON_WIDTH, DUNGEON_HEIGHT, DUNGEON_SEED };
+  if (getenv("VR_DUNGEON") != NULL) {
+    sscanf(getenv("VR_DUNGEON"), "%d:%dx%d:%u", &dungeon.floors, &dungeon.width, &dungeon.height,
+           &dungeon.seed);
+  }
+  const char *trace_path = getenv("VR_TRACE") != NULL ? getenv("VR_TRACE") : "";
+  std::unique_ptr<Game> game(new Game(name, getenv("VR_HOT_RELOAD") != NULL, trace_path, dungeon));
+
+  /* a save that cannot be recovered leaves a new game, whose hero needs a name */
+  if (resume && !game->load_save()) {
+    ask_name(name);
+    game.reset();
+    game.reset(new Game(name, getenv("VR_HOT_RELOAD") != NULL, trace_path, dungeon));
+    clear();
+    printw( "The saved game could not be recovered. Starting a new game.\n" );
+  }
 
   raw();
   noecho();
   curs_set(0);
 
-  int input;
-  Game game(name);
-  printw( game.render().c_str() );
+  /* VR_PROFILE in the environment times each turn from the start; 'P' toggles it */
+  game->get_profiler().set_enabled(getenv("VR_PROFILE") != NULL);
+  printw( game->render().c_str() );
   refresh();
   
-  while ( game.is_in_progress() ) {
+  while ( game->is_in_progress() ) {
     input = getch();
-    game.read_input( input );
-    clear();
-    printw( game.render().c_str() );
-    refresh();
+    TraceScope turn(game->get_tracer(), TRACE_TURN);
+    game->read_input( input );
+    std::string screen = game->render();
+    {
+      ProfileScope timing(game->get_profiler(), PHASE_OUTPUT);
+      TraceScope flush(game->get_tracer(), TRACE_FLUSH);
+      clear();
+      printw( screen.c_str() );
+      refresh();
+    }
   } 
   printw("Press any key to exit...");  
   refresh();
   getch(); 
   endwin();
 
+  if (game->get_profiler().has_samples()) {
+    std::cout << game->get_profiler().report();
+  }
+
   return 0;
 }
 
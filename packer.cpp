@@ -0,0 +1,567 @@
+/*************************************************************************
+ * Program Filename: packer.cpp
+ * Author: David Bacher-Hicks
+ * Date: 19 October 2026
+ * Description: An offline tool that compiles the gamedata text files
+ *              (item, weapon, armor and mob tables, mob loot tables and
+ *              every floor_N.mp/.dat pair) into a single binary asset 
+ *              pack. Run with "make pack". With --tables, the same 
+ *              records are written as a C++ header of constexpr tables
+ *              instead, for "make EMBED=1".
+ * Input: the gamedata files
+ * Output: the pack file (PACK_PATH, or the first argument), or the 
+ *         tables header
+ ************************************************************************/
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <map>
+#include "AssetPack.hpp"
+#include "TableReader.hpp"
+#include "Layout.hpp"
+#include "Game.hpp"
+#include "utils.hpp"
+
+/* 
+ * the pack under construction. Strings are interned as they are added,
+ * so each distinct string is stored once
+ */
+struct pack_builder {
+  std::vector<pack_item> items;
+  std::vector<pack_mob> mobs;
+  std::vector<pack_loot> loot;
+  std::vector<pack_floor> floors;
+  std::vector<pack_object> objects;
+  std::string grids;
+  std::string strings;
+  std::map<std::string, uint32_t> interned;
+};
+
+
+/*************************************************************************
+ * Function: intern
+ * Description: returns the string table offset of a string, adding the
+ *              string to the table if it is not already there
+ * Parameters: pack - the pack under construction
+ *             str - the string
+ * Pre-conditions: none
+ * Post-conditions: the string is in the string table
+ * Returns: uint32_t - the string's offset
+ ************************************************************************/
+uint32_t intern(pack_builder &pack, const std::string &str)
+{
+  auto it = pack.interned.find(str);
+  uint32_t offset;
+
+  if (it == pack.interned.end()) {
+    offset = pack.strings.size();
+    pack.strings += str;
+    pack.strings += '\0';
+    pack.interned.insert(std::pair<std::string, uint32_t>(str, offset));
+  } else {
+    offset = it->second;
+  }
+
+  return offset;
+}
+
+
+/*************************************************************************
+ * Function: pack_items
+ * Description: adds every record of an item, weapon or armor table
+ * Parameters: pack - the pack under construction
+ *             path - the path of the table
+ *             kind - the kind of item in the table
+ * Pre-conditions: none
+ * Post-conditions: the table's items are in the pack
+ * Returns: none
+ ************************************************************************/
+void pack_items(pack_builder &pack, const std::string &path, pack_item_kind kind)
+{
+  TableReader table;
+  slice id, name, description;
+  double weight, value;
+  int die_n = 0, die_s = 0, die_m = 0, ac = 0;
+  pack_item item;
+
+  if (!table.open(path)) {
+    std::cerr << table.error() << '\n';
+  }
+
+  while (table.next_record()) {
+    if (table.read_string(id) && table.read_string(name) && table.read_string(description) &&
+        table.read_double(weight) && table.read_double(value) &&
+        (kind != PACK_WEAPON || 
+         (table.read_int(die_n) && table.read_int(die_s) && table.read_int(die_m))) &&
+        (kind != PACK_ARMOR || table.read_int(ac))) {
+      memset(&item, 0, sizeof(item));
+      item.kind = kind;
+      item.id = intern(pack, id.str());
+      item.name = intern(pack, name.str());
+      item.description = intern(pack, description.str());
+      item.weight = weight;
+      item.value = value;
+      item.die_n = die_n;
+      item.die_s = die_s;
+      item.die_m = die_m;
+      item.ac = ac;
+      pack.items.push_back(item);
+    } else {
+      std::cerr << table.error() << '\n';
+    }
+  }
+}
+
+
+/*************************************************************************
+ * Function: pack_mobs
+ * Description: adds every monster of the mob table and its loot table
+ * Parameters: pack - the pack under construction
+ * Pre-conditions: none
+ * Post-conditions: the monsters and their loot are in the pack
+ * Returns: none
+ ************************************************************************/
+void pack_mobs(pack_builder &pack)
+{
+  TableReader mob_table, loot_table;
+  slice id, name, render_char, item;
+  int ac, hp, die_n, die_s, die_m, b_atk, chance;
+  double cr;
+  pack_mob mob;
+  pack_loot loot;
+
+  if (!mob_table.open(MOB_TBL)) {
+    std::cerr << mob_table.error() << '\n';
+  }
+
+  while (mob_table.next_record()) {
+    if (!(mob_table.read_string(id) && mob_table.read_string(name) && 
+          mob_table.read_string(render_char) && mob_table.read_int(ac) && 
+          mob_table.read_int(hp) && mob_table.read_int(die_n) && mob_table.read_int(die_s) &&
+          mob_table.read_int(die_m) && mob_table.read_int(b_atk) && mob_table.read_double(cr))) {
+      std::cerr << mob_table.error() << '\n';
+
+    } else {
+      memset(&mob, 0, sizeof(mob));
+      mob.id = intern(pack, id.str());
+      mob.name = intern(pack, name.str());
+      mob.render_char = (render_char.size > 0) ? render_char.data[0] : '?';
+      mob.ac = ac;
+      mob.hp = hp;
+      mob.die_n = die_n;
+      mob.die_s = die_s;
+      mob.die_m = die_m;
+      mob.b_atk = b_atk;
+      mob.cr = cr;
+      mob.loot_first = pack.loot.size();
+
+      /* a monster without a loot table drops nothing */
+      if (loot_table.open(MOB_LOOT_DIR + id.str() + ".tbl")) {
+        while (loot_table.next_record()) {
+          if (loot_table.read_string(item) && loot_table.read_int(chance)) {
+            loot.item = intern(pack, item.str());
+            loot.chance = chance;
+            pack.loot.push_back(loot);
+          } else {
+            std::cerr << loot_table.error() << '\n';
+          }
+        }
+      }
+
+      mob.loot_count = pack.loot.size() - mob.loot_first;
+      pack.mobs.push_back(mob);
+    }
+  }
+}
+
+
+/*************************************************************************
+ * Function: pack_floor_pair
+ * Description: adds a floor: its layout as a prebuilt grid and the object
+ *              records of its data file
+ * Parameters: pack - the pack under construction
+ *             map_path - the path of the layout (.mp) file
+ *             data_path - the path of the data (.dat) file
+ * Pre-conditions: none
+ * Post-conditions: the floor is in the pack, less any bad records, which
+ *                  are reported
+ * Returns: bool - false if the layout or a record could not be read
+ ************************************************************************/
+bool pack_floor_pair(pack_builder &pack, const std::string &map_path, const std::string &data_path)
+{
+  Layout layout;
+  TableReader data_file;
+  slice map_id, data_object, tgt_id;
+  pack_floor floor;
+  pack_object object;
+  bool parsed;                    /* whether the record's fields were all read */
+  bool known;                     /* whether the record is of a known type */
+
+  memset(&floor, 0, sizeof(floor));
+
+  /* the grid is as wide as the longest row; shorter rows are padded */
+  bool read = layout.read(map_path);
+  if (!read) {
+    std::cerr << layout.error() << '\n';
+  }
+  floor.width = layout.get_width();
+  floor.height = layout.get_height();
+  floor.grid = pack.grids.size();
+  pack.grids.append(layout.grid(), static_cast<size_t>(floor.width) * floor.height);
+
+  if (data_file.open(data_path) && data_file.next_record() && data_file.read_word(map_id)) {
+    floor.id = intern(pack, map_id.str());
+  } else {
+    std::cerr << data_file.error() << '\n';
+    floor.id = intern(pack, "");
+    read = false;
+  }
+  floor.object_first = pack.objects.size();
+
+  while (data_file.next_record()) {
+    memset(&object, 0, sizeof(object));
+    object.target = PACK_NO_STR;
+    tgt_id.size = 0;
+    parsed = false;
+    known = true;
+
+    if (data_file.read_word(data_object) && data_file.read_int(object.x) && 
+        data_file.read_int(object.y)) {
+      if (data_object == "door") {
+        object.kind = PACK_DOOR;
+        parsed = data_file.at_record_end() || data_file.read_word(tgt_id);
+      } else if (data_object == "stair") {
+        object.kind = PACK_STAIR;
+        parsed = data_file.read_word(tgt_id) && data_file.read_int(object.x2) && 
+                 data_file.read_int(object.y2);
+      } else if (data_object == "item") {
+        object.kind = PACK_OBJ_ITEM;
+        parsed = data_file.read_word(tgt_id);
+      } else if (data_object == "mob") {
+        object.kind = PACK_OBJ_MOB;
+        parsed = data_file.read_word(tgt_id);
+      } else {
+        known = false;
+      }
+      /* only a door may go without a target */
+      if (parsed && tgt_id.size > 0) {
+        object.target = intern(pack, tgt_id.str());
+      }
+    }
+
+    /* a bad record keeps the pack from being written, as a bad layout does */
+    if (parsed) {
+      pack.objects.push_back(object);
+    } else if (!known) {
+      std::cerr << data_path << ':' << data_file.line_number() << ": unknown record \""
+                << data_object << "\"\n";
+    } else {
+      std::cerr << data_file.error() << '\n';
+    }
+    read = read && parsed;
+  }
+
+  floor.object_count = pack.objects.size() - floor.object_first;
+  pack.floors.push_back(floor);
+
+  return read;
+}
+
+
+/*************************************************************************
+ * Function: append_section
+ * Description: appends a section to the pack image on an 8 byte boundary
+ * Parameters: image - the pack image
+ *             data - the section data
+ *             size - the size of the section data
+ * Pre-conditions: none
+ * Post-conditions: the section is appended
+ * Returns: uint32_t - the offset of the section
+ ************************************************************************/
+uint32_t append_section(std::string &image, const void *data, size_t size)
+{
+  image.append((8 - image.size() % 8) % 8, '\0');
+  uint32_t offset = image.size();
+  image.append(static_cast<const char *>(data), size);
+  return offset;
+}
+
+
+/*************************************************************************
+ * Function: build_header
+ * Description: fills in a pack header's magic, version and section sizes.
+ *              The offsets and total size are left 0 for the caller.
+ * Parameters: pack - the finished pack
+ *             header - the header to fill in
+ * Pre-conditions: the string table has its final '\0'
+ * Post-conditions: none
+ * Returns: none
+ ************************************************************************/
+void build_header(const pack_builder &pack, pack_header &header)
+{
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, PACK_MAGIC, sizeof(PACK_MAGIC));
+  header.version = PACK_VERSION;
+  header.item_count = pack.items.size();
+  header.mob_count = pack.mobs.size();
+  header.loot_count = pack.loot.size();
+  header.floor_count = pack.floors.size();
+  header.object_count = pack.objects.size();
+  header.grids_size = pack.grids.size();
+  header.strings_size = pack.strings.size();
+}
+
+
+/*************************************************************************
+ * Function: write_pack
+ * Description: lays out and writes a pack file: the header, the record
+ *              sections, then the grids and strings
+ * Parameters: pack - the finished pack
+ *             out_path - the path to write
+ * Pre-conditions: the string table has its final '\0'
+ * Post-conditions: the pack file may have been written
+ * Returns: bool - true if the file was written
+ ************************************************************************/
+bool write_pack(const pack_builder &pack, const std::string &out_path)
+{
+  pack_header header;
+  std::string image;
+  bool written;
+
+  build_header(pack, header);
+  image.assign(sizeof(header), '\0');
+
+  header.items_offset = append_section(image, pack.items.data(), pack.items.size() * sizeof(pack_item));
+  header.mobs_offset = append_section(image, pack.mobs.data(), pack.mobs.size() * sizeof(pack_mob));
+  header.loot_offset = append_section(image, pack.loot.data(), pack.loot.size() * sizeof(pack_loot));
+  header.floors_offset = append_section(image, pack.floors.data(), pack.floors.size() * sizeof(pack_floor));
+  header.objects_offset = append_section(image, pack.objects.data(), pack.objects.size() * sizeof(pack_object));
+  header.grids_offset = append_section(image, pack.grids.data(), pack.grids.size());
+  header.strings_offset = append_section(image, pack.strings.data(), pack.strings.size());
+
+  header.size = image.size();
+  image.replace(0, sizeof(header), reinterpret_cast<const char *>(&header), sizeof(header));
+
+  std::ofstream out_file(out_path.c_str(), std::ios::binary);
+  written = static_cast<bool>(out_file.write(image.data(), image.size()));
+  out_file.close();
+
+  if (written) {
+    std::cout << "Packed " << pack.items.size() << " items, " 
+              << pack.mobs.size() << " mobs, " 
+              << pack.floors.size() << " floors into " << out_path 
+              << " (" << image.size() << " bytes)\n";
+  }
+
+  return written;
+}
+
+
+          ////////////////////////////////////////////////////////
+         //               Embedded Tables                      // 
+        ////////////////////////////////////////////////////////
+
+/* each record as a brace initializer, fields in declaration order */
+std::ostream &operator<<(std::ostream &out, const pack_item &item)
+{
+  return out << "{ " << item.id << ", " << item.name << ", " << item.description << ", "
+             << item.kind << ", " << item.weight << ", " << item.value << ", " 
+             << item.die_n << ", " << item.die_s << ", " << item.die_m << ", " << item.ac << " }";
+}
+
+std::ostream &operator<<(std::ostream &out, const pack_mob &mob)
+{
+  return out << "{ " << mob.cr << ", " << mob.id << ", " << mob.name << ", " 
+             << mob.render_char << ", " << mob.ac << ", " << mob.hp << ", " 
+             << mob.die_n << ", " << mob.die_s << ", " << mob.die_m << ", " << mob.b_atk << ", "
+             << mob.loot_first << ", " << mob.loot_count << ", 0 }";
+}
+
+std::ostream &operator<<(std::ostream &out, const pack_loot &loot)
+{
+  return out << "{ " << loot.item << ", " << loot.chance << " }";
+}
+
+std::ostream &operator<<(std::ostream &out, const pack_floor &floor)
+{
+  return out << "{ " << floor.id << ", " << floor.width << ", " << floor.height << ", "
+             << floor.grid << ", " << floor.object_first << ", " << floor.object_count << " }";
+}
+
+std::ostream &operator<<(std::ostream &out, const pack_object &object)
+{
+  return out << "{ " << object.kind << ", " << object.x << ", " << object.y << ", "
+             << object.target << ", " << object.x2 << ", " << object.y2 << " }";
+}
+
+
+/*************************************************************************
+ * Function: write_table
+ * Description: writes a section's records as a constexpr array. An empty
+ *              section is written with one zeroed record, as C++ has no
+ *              empty arrays; the header's count still says 0.
+ * Parameters: out - the stream to write to
+ *             type - the record type name
+ *             name - the array name
+ *             records - the records
+ * Pre-conditions: none
+ * Post-conditions: the array is written
+ * Returns: none
+ ************************************************************************/
+template <typename T>
+void write_table(std::ostream &out, const char *type, const char *name, 
+                 const std::vector<T> &records)
+{
+  out << "constexpr " << type << ' ' << name << "[] = {\n";
+  for (size_t i = 0; i < records.size(); i++) {
+    out << "  " << records[i] << ",\n";
+  }
+  if (records.empty()) {
+    out << "  {}\n";
+  }
+  out << "};\n\n";
+}
+
+
+/*************************************************************************
+ * Function: write_literal
+ * Description: writes bytes as a char array initialized from a string 
+ *              literal, split over lines. Anything but plain printable
+ *              characters is written as a three digit octal escape.
+ * Parameters: out - the stream to write to
+ *             name - the array name
+ *             bytes - the bytes
+ * Pre-conditions: none
+ * Post-conditions: the array is written
+ * Returns: none
+ ************************************************************************/
+void write_literal(std::ostream &out, const char *name, const std::string &bytes)
+{
+  const int LINE_BYTES = 64;
+  unsigned char c;
+  char escape[5];
+
+  out << "constexpr char " << name << "[] =\n  \"";
+  for (size_t i = 0; i < bytes.size(); i++) {
+    c = bytes[i];
+    if (c >= ' ' && c <= '~' && c != '"' && c != '\\' && c != '?') {
+      out << c;
+    } else {
+      snprintf(escape, sizeof(escape), "\\%03o", c);
+      out << escape;
+    }
+    if (i % LINE_BYTES == LINE_BYTES - 1 && i + 1 < bytes.size()) {
+      out << "\"\n  \"";
+    }
+  }
+  out << "\";\n\n";
+}
+
+
+/*************************************************************************
+ * Function: write_tables
+ * Description: writes the pack as a header of constexpr tables, for 
+ *              building the gamedata into the game (see 
+ *              AssetPack::open_embedded). Section offsets are 0, since
+ *              each section is its own array.
+ * Parameters: pack - the finished pack
+ *             out_path - the path to write
+ * Pre-conditions: the string table has its final '\0'
+ * Post-conditions: the header may have been written
+ * Returns: bool - true if the file was written
+ ************************************************************************/
+bool write_tables(const pack_builder &pack, const std::string &out_path)
+{
+  std::ofstream out(out_path.c_str());
+  pack_header header;
+
+  build_header(pack, header);
+  out << std::setprecision(17);
+
+  out << "/* Generated by vr_packer from the gamedata files. Do not edit. */\n\n"
+      << "#ifndef GAMEDATATABLES_HPP\n"
+      << "#define GAMEDATATABLES_HPP\n\n"
+      << "#include \"AssetPack.hpp\"\n\n";
+
+  out << "constexpr pack_header EMBEDDED_HEADER = {\n  {";
+  for (size_t i = 0; i < sizeof(header.magic); i++) {
+    out << (i > 0 ? ", " : " ") << static_cast<int>(header.magic[i]);
+  }
+  out << " },\n"
+      << "  " << header.version << ", 0,\n"
+      << "  0, " << header.item_count << ", 0, " << header.mob_count << ", 0, " 
+      << header.loot_count << ",\n"
+      << "  0, " << header.floor_count << ", 0, " << header.object_count << ",\n"
+      << "  0, " << header.grids_size << ", 0, " << header.strings_size << "\n};\n\n";
+
+  write_table(out, "pack_item", "EMBEDDED_ITEMS", pack.items);
+  write_table(out, "pack_mob", "EMBEDDED_MOBS", pack.mobs);
+  write_table(out, "pack_loot", "EMBEDDED_LOOT", pack.loot);
+  write_table(out, "pack_floor", "EMBEDDED_FLOORS", pack.floors);
+  write_table(out, "pack_object", "EMBEDDED_OBJECTS", pack.objects);
+  write_literal(out, "EMBEDDED_GRIDS", pack.grids);
+  write_literal(out, "EMBEDDED_STRINGS", pack.strings);
+
+  out << "#endif\n";
+  out.close();
+
+  if (out) {
+    std::cout << "Wrote " << pack.items.size() << " items, " 
+              << pack.mobs.size() << " mobs, " 
+              << pack.floors.size() << " floors as tables to " << out_path << '\n';
+  }
+
+  return static_cast<bool>(out);
+}
+
+
+/*
+ * usage: vr_packer [pack path]
+ *        vr_packer --tables <header path>
+ */
+int main(int argc, char **argv)
+{
+  bool tables = (argc > 2 && strcmp(argv[1], "--tables") == 0);
+  std::string out_path = tables ? argv[2] : (argc > 1) ? argv[1] : PACK_PATH;
+  std::stringstream map_path_ss, data_path_ss;
+  pack_builder pack;
+  bool packed = true;
+
+  pack_items(pack, ITEM_TBL_PATH, PACK_ITEM);
+  pack_items(pack, WPN_TBL_PATH, PACK_WEAPON);
+  pack_items(pack, AMR_TBL_PATH, PACK_ARMOR);
+  pack_mobs(pack);
+
+  /* floors follow the same "floor_N" numbering load_gamedata does */
+  int map_num = 1;
+  map_path_ss   << MAP_PATH_ROOT << "floor_" << map_num << ".mp";
+  data_path_ss  << MAP_PATH_ROOT << "floor_" << map_num << ".dat";
+
+  while (file_exists(map_path_ss.str().c_str()) && file_exists(data_path_ss.str().c_str())) {
+    packed = pack_floor_pair(pack, map_path_ss.str(), data_path_ss.str()) && packed;
+
+    map_num++;
+    map_path_ss.str("");
+    data_path_ss.str("");
+    map_path_ss   << MAP_PATH_ROOT << "floor_" << map_num << ".mp";
+    data_path_ss  << MAP_PATH_ROOT << "floor_" << map_num << ".dat";
+  }
+  pack.strings += '\0';
+
+  /* nothing is written unless every floor could be read */
+  if (!packed) {
+    std::cerr << "Not writing " << out_path << '\n';
+  } else {
+    packed = tables ? write_tables(pack, out_path) : write_pack(pack, out_path);
+    if (!packed) {
+      std::cerr << "Could not write " << out_path << '\n';
+    }
+  }
+
+  return packed ? 0 : 1;
+}
@@ -10,9 +10,10 @@
 #include <iostream>
 #include <fstream>
 #include <cstdlib>
-#include <stack>
 #include <cctype>
 #include <cmath>
+#include <algorithm>
+#include <dirent.h>
 #include "utils.hpp"
 
 const char INT_FAILPROMPT[] = "Please enter an integer number.";
@@ -151,37 +152,41 @@ std::string split(std::string str, char splitChar)
   return outStr;
 }
 
+/*************************************************************************
+ * Return the next string in str enclosed in s_char characters, starting
+ * the search at index i. i is left just past the closing s_char.
+ ************************************************************************/
 std::string str_parse_string(const std::string &str, int &i, char s_char)
 {
-  bool end = false,
-       reading = false;
+  size_t open = str.find(s_char, i),
+         close = std::string::npos;
   std::string r_str = "";
 
-  while((i < str.size()) && (!end)){
-    if (str.at(i) == s_char){
-      if (reading) {
-        end = true;
-      } else {
-        reading = true;
-      }
-    } else if (reading) {
-      r_str += str.at(i);
+  if (open == std::string::npos) {
+    i = str.size();
+  } else {
+    close = str.find(s_char, open + 1);
+    if (close == std::string::npos) {
+      close = str.size();
     }
-    i++;
+    r_str = str.substr(open + 1, close - open - 1);
+    i = std::min(close + 1, str.size());
   }
+
   return r_str;
 }
 
+/*************************************************************************
+ * Return the next decimal number in str, starting the search at index i.
+ * i is left just past the number.
+ ************************************************************************/
 double str_parse_double(const std::string &str, int &i)
 {
   char c;
-  std::stack<int> digits;
-
-  double value = 0;
-  bool is_negative = false;
-
-  int place = 0;
-  int decimal_place = -1;
+  double value = 0,
+         scale = 1;
+  bool is_negative = false,
+       in_fraction = false;
 
   while((i < str.size()) && 
         (!isdigit(str.at(i))) && 
@@ -191,25 +196,17 @@ double str_parse_double(const std::string &str, int &i)
     if ( c == '-' ) {
       is_negative = true;
     } else if ( c == '.' ){
-      decimal_place = place;
+      in_fraction = true;
     } else {
-      ++place;
-      digits.push(c - '0');  
+      value = value * 10 + (c - '0');
+      if (in_fraction) {
+        scale *= 10;
+      }
     }
     i++;
   }
 
-  if (decimal_place != -1) {
-    place = decimal_place - place;
-  } else {
-    place = 0;
-  }
-
-  while(digits.size() > 0){
-    value += pow(10, place++) * digits.top();
-    digits.pop();
-  }
-
+  value /= scale;
   if (is_negative){
     value *= -1;
   }
@@ -217,11 +214,14 @@ double str_parse_double(const std::string &str, int &i)
   return value;  
 }
 
+/*************************************************************************
+ * Return the next whole number in str, starting the search at index i.
+ * i is left just past the number.
+ ************************************************************************/
 int str_parse_int(const std::string &str, int &i)
 {
   char c;
-  std::stack<int> digits;
-
+  int value = 0;
   bool is_negative = false;
 
   while((i < str.size()) && 
@@ -232,25 +232,16 @@ int str_parse_int(const std::string &str, int &i)
     if ( c == '-' ) {
       is_negative = true;
     } else {
-      digits.push(c - '0');  
+      value = value * 10 + (c - '0');
     }
     i++;
   }
 
-  int place = 0;
-  int value = 0;
-
-  while(digits.size() > 0){
-    value += pow(10, place++) * digits.top();
-    digits.pop();
-  }
-
   if (is_negative){
     value *= -1;
   }
 
   return value; 
-
 }
 
 
@@ -306,3 +297,38 @@ bool file_exists(const char *path)
 
   return exists;
 }
+
+
+/*************************************************************************
+ *  A function to list the names of the files in a directory that end in
+ *  a suffix, in sorted order. Accepts a relative path as a parameter.
+ ************************************************************************/
+void list_files(const char *dir_path, const std::string &suffix, std::vector<std::string> &names)
+{
+  DIR *dir = opendir(dir_path);
+  struct dirent *entry;
+  std::string name;
+
+  if (dir != NULL) {
+    while ((entry = readdir(dir)) != NULL) {
+      name = entry->d_name;
+      if (has_suffix(name, suffix)) {
+        names.push_back(name);
+      }
+    }
+    closedir(dir);
+  }
+
+  std::sort(names.begin(), names.end());
+}
+
+
+/*************************************************************************
+ *  A function to return whether or not a file name ends in a suffix, 
+ *  with something before it.
+ ************************************************************************/
+bool has_suffix(const std::string &name, const std::string &suffix)
+{
+  return name.size() > suffix.size() && 
+         name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
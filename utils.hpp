@@ -9,6 +9,7 @@
 #define UTILS_HPP
 
 #include <string>
+#include <vector>
 #include <iostream>
 #include <cctype>
 
@@ -32,6 +33,8 @@ void pauseForEnter();
 
 //Filesystem, i/o
 bool file_exists(const char *path);
+void list_files(const char *dir_path, const std::string &suffix, std::vector<std::string> &names);
+bool has_suffix(const std::string &name, const std::string &suffix);
 
         //////////////////////////////////////////////////////////
        //   Array Searching and Sorting Template Functions     //